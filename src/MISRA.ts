@@ -1,8 +1,9 @@
-import { BinaryOp, Break, Case, Expression, If, Joinpoint, Scope, Statement, Switch } from "@specs-feup/clava/api/Joinpoints.js";
+import { BinaryOp, Break, BuiltinType, Case, Expression, If, Joinpoint, QualType, Scope, Statement, Switch, Type } from "@specs-feup/clava/api/Joinpoints.js";
 import { isCommentStmt } from "./utils/CommentUtils.js";
 import ClavaJoinPoints from "@specs-feup/clava/api/clava/ClavaJoinPoints.js";
 import Query from "@specs-feup/lara/api/weaver/Query.js";
-import { countSwitchClauses } from "./utils/SwitchUtils.js";
+import { countSwitchClauses, needsSingleEvaluation } from "./utils/SwitchUtils.js";
+import { EssentialTypeCategory, getEssentialTypeOfType, getIntWidth } from "./utils/EssentialTypeUtils.js";
 
 type NodeID = string;
 
@@ -27,8 +28,25 @@ export enum MISRATransformationType {
 
 export type MISRATransformationResults = Map<NodeID, MISRATransformationType>;
 
+/**
+ * Position of a violation in the text of a file, for violations that are not linked to a specific AST node
+ */
+export interface SourceLocation {
+    /**
+     * Line of the violation, starting from 1
+     */
+    line: number;
+    /**
+     * Column of the violation, starting from 1
+     */
+    column: number;
+}
+
 /**
  * Represents a MISRA-C rule violation.
+ * 
+ * Errors are views of the compact records kept by the error store of the context: they hold the identifier of the node where
+ * the error was detected, instead of the node, so that reports do not keep removed parts of the AST alive.
  */
 export class MISRAError {
     /**
@@ -36,24 +54,90 @@ export class MISRAError {
      */
     public readonly ruleID: string;
     /**
-     * The joinpoint where the error was detected
+     * Identifier of the joinpoint where the error was detected
      */
-    public readonly joinpoint: Joinpoint;
+    public readonly nodeId: string;
     /**
      * Explanation of the violation
      */
     public readonly message: string;
+    /**
+     * Path of the file of the violation
+     */
+    public readonly filepath: string;
+    /**
+     * Line of the violation, or 0 if it refers to the whole file (e.g., an include without position)
+     */
+    public readonly line: number;
+    /**
+     * Column of the violation, or 0 if it refers to the whole file
+     */
+    public readonly column: number;
+    /**
+     * Position of the violation in the file, if it is more precise than the location of the joinpoint (e.g., violations found by lexical rules)
+     */
+    public readonly location?: SourceLocation;
+    /**
+     * Identifier of the approved deviation that suppressed the violation, if any
+     */
+    public readonly deviationId?: string;
+    /**
+     * Finds the joinpoint of a node in the current AST by its identifier
+     */
+    #findNode: (nodeId: string) => Joinpoint | undefined;
 
     /**
      * 
      * @param ruleID Identifier of the violated rule
-     * @param $jp Joinpoint where the error was detected
+     * @param nodeId Identifier of the joinpoint where the error was detected
      * @param message Description of the error
+     * @param filepath Path of the file of the violation
+     * @param line Line of the violation, or 0 if it refers to the whole file
+     * @param column Column of the violation, or 0 if it refers to the whole file
+     * @param hasLocation Whether the position is more precise than the location of the joinpoint
+     * @param findNode Finds the joinpoint of a node in the current AST by its identifier (e.g., in the index of the error store). By default, the AST is searched.
+     * @param deviationId Identifier of the approved deviation that suppressed the violation, if any
      */
-    constructor(ruleID: string, $jp: Joinpoint, message: string) {
+    constructor(ruleID: string, nodeId: string, message: string, filepath: string, line: number, column: number, hasLocation: boolean,
+                findNode: (nodeId: string) => Joinpoint | undefined = searchNode, deviationId?: string) {
         this.ruleID = ruleID;
-        this.joinpoint = $jp;
+        this.nodeId = nodeId;
         this.message =  message;
+        this.filepath = filepath;
+        this.line = line;
+        this.column = column;
+        this.location = hasLocation ? { line, column } : undefined;
+        this.#findNode = findNode;
+        this.deviationId = deviationId;
+    }
+
+    /**
+     * @returns A copy of the error that refers to the whole file, e.g., when its position no longer matches the code of the file
+     */
+    withoutPosition(): MISRAError {
+        return new MISRAError(this.ruleID, this.nodeId, this.message, this.filepath, 0, 0, false, this.#findNode, this.deviationId);
+    }
+
+    /**
+     * The joinpoint where the error was detected, found in the AST when needed, or undefined if it is no longer in the AST
+     */
+    get joinpoint(): Joinpoint | undefined {
+        return this.#findNode(this.nodeId);
+    }
+
+    /**
+     * Location of the violation, in the format "filepath@line:column", or the file path if it refers to the whole file
+     */
+    get fileLocation(): string {
+        return this.line > 0 ? `${this.filepath}@${this.line}:${this.column}` : this.filepath;
+    }
+
+    /**
+     * Key that identifies the error, used to avoid duplicates
+     */
+    get key(): string {
+        const position = this.location ? `@${this.location.line}:${this.location.column}` : "";
+        return `${this.ruleID}-${this.nodeId}${position}-${this.message}`;
     }
 
     /**
@@ -62,19 +146,24 @@ export class MISRAError {
      * @returns Returns `true` if the errors are the same, `false` otherwise
      */
     equals(other: MISRAError): boolean {
-        return this.ruleID === other.ruleID &&
-               this.joinpoint.astId === other.joinpoint.astId &&
-               this.message === other.message;
+        return this.key === other.key;
     }
 
     /**
      * Checks if the associated joinpoint is still present in program's AST
      */
     isActiveError(): boolean {
-        return (Query.root() as Joinpoint).contains(this.joinpoint);
+        return this.joinpoint !== undefined;
     }
 }
 
+/**
+ * Searches the AST for the joinpoint with the given identifier
+ */
+function searchNode(nodeId: string): Joinpoint | undefined {
+    return Query.searchFromInclusive(Query.root() as Joinpoint, Joinpoint, { astId: nodeId }).first();
+}
+
 /**
  * A report of a MISRA transformation, including the transformation type and an optional new joinpoint node.
  * 
@@ -89,38 +178,94 @@ export class MISRATransformationReport {
      * An optional new joinpoint node, provided if the transformation involves a replacement
      */
     public readonly newNode?: Joinpoint; 
+    /**
+     * The nodes modified by the transformation, if it is limited to them (e.g., renamed declarations).
+     * When not provided, the whole node to which the rule was applied is considered changed.
+     */
+    public readonly changedNodes?: Joinpoint[];
 
     /**
      * 
      * @param type The type of the MISRA transformation
      * @param newNode The new joinpoint node resulting from the transformation. Required if the transformation type is `Replacement`.
+     * @param changedNodes The nodes modified by the transformation, if it is limited to them
      */
-    constructor(type: MISRATransformationType, newNode?: Joinpoint) {
+    constructor(type: MISRATransformationType, newNode?: Joinpoint, changedNodes?: Joinpoint[]) {
         this.type = type;
         if (type === MISRATransformationType.Replacement && !newNode) {
             throw new Error("newNode must be provided when a 'Replacement' transformation is performed");
         }
         this.newNode = newNode;
+        this.changedNodes = changedNodes;
     }
 }
 
+/**
+ * Options of the conversion of switch statements into if statements
+ */
+export interface SwitchConversionOptions {
+    /**
+     * Minimum number of ranges of case values for which a balanced decision tree is emitted, instead of a chain of if statements
+     */
+    decisionTreeThreshold?: number;
+    /**
+     * Returns the value of a constant case expression, or undefined if it cannot be computed.
+     * Without it, case values are compared one by one.
+     */
+    evaluate?: (exprJp: Expression) => bigint | undefined;
+    /**
+     * Generates the name of the temporary variable that holds the value of the condition.
+     * Without it, the condition is never hoisted.
+     */
+    generateName?: () => string;
+}
+
+/**
+ * Range of consecutive constant case values that belong to the same clause
+ */
+interface CaseRange {
+    low: bigint;
+    high: bigint;
+    lowJp: Expression;
+    highJp: Expression;
+    /**
+     * Index of the clause in the groups of consecutive cases
+     */
+    clause: number;
+}
+
+/**
+ * Integer type of a switch condition after the integer promotions, to which the case values are converted
+ */
+interface PromotedType {
+    type: Type;
+    width: number;
+    isSigned: boolean;
+}
+
 /**
  * Converts a switch statement into either consecutive statements or if statements
  * - If the switch has only one clause and a default case, it is converted to consecutive statements
  * - Otherwise, it is converted to if statements
  */
 export class MISRASwitchConverter {
+    /**
+     * Number of ranges of case values from which a decision tree is emitted, if not specified in the options
+     */
+    static readonly DEFAULT_DECISION_TREE_THRESHOLD = 4;
+
     /**
      * Converts a switch statement to consecutive statements or if statements
      * 
      * @param switchStmt - The switch statement to convert
+     * @param options - Options of the conversion into if statements
      * @returns The converted statements or `undefined` if no statements remain
      */
-    static convert(switchStmt: Switch): Statement | undefined {
+    static convert(switchStmt: Switch, options: SwitchConversionOptions = {}): Statement | undefined {
         if (switchStmt.hasDefaultCase && countSwitchClauses(switchStmt) < 2) {  // The statements will always be executed 
             return this.convertToConsecutiveStmts(switchStmt);
         } else {
-            return this.convertToIfStatements(switchStmt);
+            return this.convertToIfStatements(switchStmt, options);
         }
     }
 
@@ -160,16 +305,58 @@ export class MISRASwitchConverter {
     }
 
     /**
-     * Converts a switch statement into a series of if statements
+     * Converts a switch statement into if statements.
+     * 
+     * If the condition has calls, volatile accesses or modifications, it is evaluated once into a temporary variable, 
+     * declared in a new block with the if statements. Consecutive constant case values of a clause, 
+     * converted to the promoted type of the condition, are compared as a range.
+     * When the clauses cover at least {@link SwitchConversionOptions.decisionTreeThreshold} ranges, the clause is selected 
+     * by a balanced binary decision tree over the sorted ranges, instead of a chain of if statements.
      * 
      * @param switchStmt - The switch statement to convert
-     * @returns The first if statement created
+     * @param options - Options of the conversion
+     * @returns The first if statement created, or the block that contains it
      */
-    static convertToIfStatements(switchStmt: Switch): If {
+    static convertToIfStatements(switchStmt: Switch, options: SwitchConversionOptions = {}): Statement {
         const scope = switchStmt.children[1] as Scope;
         const consecutiveCases = this.consecutiveCases(switchStmt);
         this.removeBreakStmts(scope);
 
+        let condition = switchStmt.condition;
+        const promotedType = this.promotedType(condition);
+        let conditionDecl: Statement | undefined;
+        if (options.generateName && needsSingleEvaluation(condition)) {
+            const type = condition.type instanceof QualType ? condition.type.unqualifiedType : condition.type;
+            const tempDecl = ClavaJoinPoints.varDeclNoInit(options.generateName(), type);
+            tempDecl.setInit(condition);
+            conditionDecl = ClavaJoinPoints.declStmt(tempDecl);
+            condition = ClavaJoinPoints.varRef(tempDecl);
+        }
+
+        const ranges = options.evaluate && promotedType ? this.caseRanges(consecutiveCases, options.evaluate, promotedType) : undefined;
+        const threshold = options.decisionTreeThreshold ?? this.DEFAULT_DECISION_TREE_THRESHOLD;
+        const ifStmt = ranges !== undefined && ranges.length >= threshold ? 
+            this.createDecisionTree(condition, consecutiveCases, ranges) : undefined;
+
+        const resultStmt = ifStmt ?? this.createIfChain(condition, consecutiveCases, ranges);
+        if (conditionDecl !== undefined) {
+            const block = ClavaJoinPoints.scope(conditionDecl, resultStmt);
+            switchStmt.replaceWith(block);
+            return block;
+        }
+        switchStmt.replaceWith(resultStmt);
+        return resultStmt;
+    }
+
+    /**
+     * Creates a chain of if statements, one for each group of consecutive cases, with the default case as the last else
+     * 
+     * @param condition - The switch condition
+     * @param consecutiveCases - The groups of consecutive cases, with the default group last
+     * @param ranges - The ranges of constant case values, if all values are constant
+     * @returns The first if statement of the chain
+     */
+    private static createIfChain(condition: Expression, consecutiveCases: Case[][], ranges: CaseRange[] | undefined): If {
         let ifStmt: If;
         let lastIfStmt: If | undefined;
         for (let i = 0; i < consecutiveCases.length; i++) {
@@ -178,13 +365,13 @@ export class MISRASwitchConverter {
             if (cases.some(caseStmt => caseStmt.isDefault)) { // Has default case
                 lastIfStmt!.setElse(ClavaJoinPoints.scope(...cases[cases.length-1].instructions));
             } else {
-                lastIfStmt = this.createIfStatement(switchStmt.condition, cases, i, lastIfStmt)
+                const clauseRanges = ranges?.filter(range => range.clause === i);
+                lastIfStmt = this.createIfStatement(condition, cases, i, lastIfStmt, clauseRanges)
                 if (i === 0) {
                     ifStmt = lastIfStmt;
                 }
             }
         }
-        switchStmt.replaceWith(ifStmt!);
         return ifStmt!;
     }
 
@@ -195,10 +382,11 @@ export class MISRASwitchConverter {
      * @param cases - A list of consecutive cases
      * @param index - The index of the current case group
      * @param lastIfStmt - The last if statement, used to chain else
+     * @param ranges - The ranges of the constant values of the cases, if all values are constant
      * @returns The new if statement
      */
-    private static createIfStatement(condition: Expression, cases: Case[], index: number, lastIfStmt: If | undefined): If {
-        const conditionExpr = this.equivalentCondition(condition, cases);
+    private static createIfStatement(condition: Expression, cases: Case[], index: number, lastIfStmt: If | undefined, ranges?: CaseRange[]): If {
+        const conditionExpr = ranges !== undefined ? this.rangesCondition(condition, ranges) : this.equivalentCondition(condition, cases);
         const thenBody = ClavaJoinPoints.scope(...cases[cases.length - 1].instructions);
         const newIfStmt = ClavaJoinPoints.ifStmt(conditionExpr, thenBody);
 
@@ -233,6 +421,163 @@ export class MISRASwitchConverter {
         return lastBinaryOp!;
     }
 
+    /**
+     * Creates the condition that checks if the switch condition is within any of the given ranges
+     * 
+     * @param condition - The switch condition
+     * @param ranges - Ranges of constant case values
+     * @returns The combined condition
+     */
+    private static rangesCondition(condition: Expression, ranges: CaseRange[]): Expression {
+        return ranges
+            .map(range => this.rangeCondition(condition, range))
+            .reduce((combinedExpr, rangeExpr) => ClavaJoinPoints.binaryOp("||", combinedExpr, rangeExpr));
+    }
+
+    private static rangeCondition(condition: Expression, range: CaseRange): Expression {
+        if (range.low === range.high) {
+            return ClavaJoinPoints.binaryOp("==", condition, range.lowJp);
+        }
+        return ClavaJoinPoints.parenthesis(ClavaJoinPoints.binaryOp("&&",
+            ClavaJoinPoints.binaryOp(">=", condition, range.lowJp),
+            ClavaJoinPoints.binaryOp("<=", condition, range.highJp)
+        ));
+    }
+
+    /**
+     * Returns the type of the switch condition after the integer promotions
+     * 
+     * @param condition - The switch condition
+     * @returns The promoted type, or undefined if the condition is not of an integer type of known width
+     */
+    private static promotedType(condition: Expression): PromotedType | undefined {
+        const { category, width } = getEssentialTypeOfType(condition.type);
+        const intWidth = getIntWidth();
+        if (category === EssentialTypeCategory.FLOATING || category === EssentialTypeCategory.UNKNOWN || width === 0) {
+            return undefined;
+        } else if (width < intWidth) { // Narrower types, including characters, Booleans and enumerations, are promoted to int
+            return { type: ClavaJoinPoints.builtinType("int"), width: intWidth, isSigned: true };
+        } else if (width === intWidth && this.isNarrowUnsignedType(condition.type)) {
+            // Unsigned types as wide as int (e.g., unsigned short on 16-bit targets) are promoted to unsigned int
+            return { type: ClavaJoinPoints.builtinType("unsigned int"), width: intWidth, isSigned: false };
+        }
+        const type = condition.type instanceof QualType ? condition.type.unqualifiedType : condition.type;
+        return { type, width, isSigned: category !== EssentialTypeCategory.UNSIGNED };
+    }
+
+    /**
+     * Checks if the given type is an unsigned integer type of lower rank than int
+     * 
+     * @param typeJp - The type to check
+     */
+    private static isNarrowUnsignedType(typeJp: Type): boolean {
+        let type = typeJp.desugarAll;
+        while (type instanceof QualType) {
+            type = type.unqualifiedType.desugarAll;
+        }
+        return type instanceof BuiltinType && (type.builtinKind === "UShort" || type.builtinKind === "UChar");
+    }
+
+    /**
+     * Computes the ranges of consecutive constant values of each group of cases, sorted by value.
+     * Case values are converted to the promoted type of the condition, as in the switch, so that e.g. 'case -1' with an unsigned condition
+     * is the largest value. Values changed by the conversion are compared through a cast to that type.
+     * The values of the group with the default case are not included, since they select the same statements as any other value.
+     * 
+     * @param consecutiveCases - The groups of consecutive cases
+     * @param evaluate - Returns the value of a constant case expression
+     * @param promotedType - The promoted type of the switch condition
+     * @returns The sorted ranges, or undefined if any case value is not constant or cannot be computed
+     */
+    private static caseRanges(consecutiveCases: Case[][], evaluate: (exprJp: Expression) => bigint | undefined, promotedType: PromotedType): CaseRange[] | undefined {
+        const values: { value: bigint, valueJp: Expression, clause: number }[] = [];
+        for (let clause = 0; clause < consecutiveCases.length; clause++) {
+            const cases = consecutiveCases[clause];
+            if (cases.some(caseStmt => caseStmt.isDefault)) {
+                continue;
+            }
+            for (const caseStmt of cases) {
+                const labelValue = caseStmt.values.length === 1 ? evaluate(caseStmt.values[0]) : undefined;
+                if (labelValue === undefined) {
+                    return undefined;
+                }
+                const value = promotedType.isSigned ? BigInt.asIntN(promotedType.width, labelValue) : BigInt.asUintN(promotedType.width, labelValue);
+                const valueJp = value === labelValue ? caseStmt.values[0] : ClavaJoinPoints.cStyleCast(promotedType.type, caseStmt.values[0]);
+                values.push({ value, valueJp, clause });
+            }
+        }
+        values.sort((value1, value2) => value1.value < value2.value ? -1 : value1.value > value2.value ? 1 : 0);
+
+        const ranges: CaseRange[] = [];
+        for (const { value, valueJp, clause } of values) {
+            const lastRange = ranges.at(-1);
+            if (lastRange !== undefined && lastRange.clause === clause && lastRange.high + 1n === value) {
+                lastRange.high = value;
+                lastRange.highJp = valueJp;
+            } else {
+                ranges.push({ low: value, high: value, lowJp: valueJp, highJp: valueJp, clause });
+            }
+        }
+        return ranges;
+    }
+
+    /**
+     * Creates a balanced binary decision tree that selects the clause of the switch condition by comparing it with the bounds of the sorted ranges.
+     * The tree is only created if the statements of each clause appear once in it: every clause must have a single range and, 
+     * if the default case has statements, the ranges must be contiguous so that the default is selected by a single bounds check.
+     * 
+     * @param condition - The switch condition
+     * @param consecutiveCases - The groups of consecutive cases, with the default group last
+     * @param ranges - The sorted ranges of constant case values
+     * @returns The root if statement of the tree, or undefined if the tree would duplicate statements
+     */
+    private static createDecisionTree(condition: Expression, consecutiveCases: Case[][], ranges: CaseRange[]): If | undefined {
+        const clauses = new Set(ranges.map(range => range.clause));
+        if (clauses.size !== ranges.length) {
+            return undefined;
+        }
+
+        const defaultCases = consecutiveCases.find(cases => cases.some(caseStmt => caseStmt.isDefault));
+        const defaultStmts = defaultCases !== undefined ? defaultCases[defaultCases.length - 1].instructions : [];
+        const hasDefaultStmts = defaultStmts.some(stmt => !isCommentStmt(stmt));
+        const isContiguous = ranges.every((range, i) => i === 0 || ranges[i - 1].high + 1n === range.low);
+        if (hasDefaultStmts && !isContiguous) {
+            return undefined;
+        }
+
+        // Nested if statements are enclosed in blocks, so that each else binds to the intended if
+        const asScope = (stmt: Statement) => stmt instanceof Scope ? stmt : ClavaJoinPoints.scope(stmt);
+        const createBody = (range: CaseRange) => {
+            const cases = consecutiveCases[range.clause];
+            return ClavaJoinPoints.scope(...cases[cases.length - 1].instructions);
+        };
+        const createNode = (first: number, last: number): Statement => {
+            if (first === last) {
+                return isContiguous ? 
+                    createBody(ranges[first]) : 
+                    ClavaJoinPoints.ifStmt(this.rangeCondition(condition, ranges[first]), createBody(ranges[first]));
+            }
+            const middle = Math.ceil((first + last) / 2);
+            const nodeStmt = ClavaJoinPoints.ifStmt(ClavaJoinPoints.binaryOp("<", condition, ranges[middle].lowJp), asScope(createNode(first, middle - 1)));
+            nodeStmt.setElse(asScope(createNode(middle, last)));
+            return nodeStmt;
+        };
+
+        const rootStmt = isContiguous ?
+            ClavaJoinPoints.ifStmt(
+                ClavaJoinPoints.binaryOp("||",
+                    ClavaJoinPoints.binaryOp("<", condition, ranges[0].lowJp),
+                    ClavaJoinPoints.binaryOp(">", condition, ranges[ranges.length - 1].highJp)
+                ),
+                ClavaJoinPoints.scope(...defaultStmts)
+            ) : 
+            createNode(0, ranges.length - 1) as If;
+        if (isContiguous) {
+            rootStmt.setElse(asScope(createNode(0, ranges.length - 1)));
+        }
+        return rootStmt;
+    }
+
     /**
      * Removes all break statements from the given scope
      * @param scope - The scope from which the break statements will be removed
@@ -0,0 +1,306 @@
+import { FunctionJp } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+
+/**
+ * Replacement of a disallowed library function, as specified in the configuration file
+ */
+export interface DisallowedFunctionFix {
+    /**
+     * Name of the replacement function
+     */
+    replacement: string;
+    /**
+     * Path suffix of the file that defines the replacement function
+     */
+    location: string;
+}
+
+/**
+ * Generated replacement of the memory allocation functions of <stdlib.h>, as specified in the configuration file
+ */
+export interface PoolAllocatorConfig {
+    /**
+     * Path of the source file to generate, relative to the program
+     */
+    location: string;
+    /**
+     * Sizes, in bytes, of the blocks of each pool, or undefined to derive them from the sizes requested by the calls
+     */
+    blockSizes: number[] | undefined;
+    /**
+     * Number of blocks of each pool
+     */
+    blocksPerPool: number | undefined;
+}
+
+/**
+ * Generated replacement of the numeric conversion functions of <stdlib.h>, as specified in the configuration file
+ */
+export interface NumericConversionsConfig {
+    /**
+     * Path of the source file to generate, relative to the program
+     */
+    location: string;
+}
+
+/**
+ * Whole-program reachability analysis that removes the declarations not reachable from the entry points, as specified in the configuration file
+ */
+export interface ReachabilityConfig {
+    /**
+     * Names of the functions called from outside the program (e.g., interrupt handlers), in addition to 'main'
+     */
+    entryPoints: string[];
+}
+
+/**
+ * Approved deviation that suppresses rules in part of the program, as specified in the configuration file
+ */
+export interface DeviationConfig {
+    /**
+     * Identifier of the deviation record
+     */
+    id: string;
+    /**
+     * Rules covered by the deviation, or '*' for all rules
+     */
+    rules: string[];
+    /**
+     * Glob of the paths of the covered files (e.g., 'vendor/**'), or undefined for all files
+     */
+    file: string | undefined;
+    /**
+     * Name of the covered function, or undefined for the whole file
+     */
+    function: string | undefined;
+    /**
+     * First and last covered lines, or undefined for the whole file
+     */
+    lines: [number, number] | undefined;
+    /**
+     * Justification of the deviation
+     */
+    reason: string | undefined;
+}
+
+/**
+ * User-provided configuration that assists in violation correction, compiled into typed lookup tables when it is loaded.
+ *
+ * Each section is undefined if it is missing from the configuration file. Entries that cannot be used as fixes are kept
+ * as undefined values, so that rules can explain why a violation was not corrected, and are reported once in {@link issues}.
+ * Functions named by the entries are resolved through an index of the function definitions by name,
+ * built once and kept until the program is rebuilt.
+ */
+export default class MISRAConfig {
+    /**
+     * Default return values, indexed by return type
+     */
+    readonly defaultValues: Map<string, string> | undefined;
+
+    /**
+     * Header or source file that declares each implicitly called function, or undefined if the entry is not a .h or .c reference
+     */
+    readonly implicitCalls: Map<string, string | undefined> | undefined;
+
+    /**
+     * Replacements of the disallowed functions of each standard library, or undefined if the entry is incomplete
+     */
+    readonly disallowedFunctions: Map<string, Map<string, DisallowedFunctionFix | undefined>> | undefined;
+
+    /**
+     * Options of the conversion of switch statements into if statements
+     */
+    readonly switchConversion: { decisionTreeThreshold?: number } | undefined;
+
+    /**
+     * Pool allocator generated to replace the memory allocation functions, or undefined if it is not requested or is invalid
+     */
+    readonly poolAllocator: PoolAllocatorConfig | undefined;
+
+    /**
+     * Numeric conversions generated to replace the conversion functions, or undefined if they are not requested or are invalid
+     */
+    readonly numericConversions: NumericConversionsConfig | undefined;
+
+    /**
+     * Entry points of the reachability analysis, or undefined if the analysis is not requested
+     */
+    readonly reachability: ReachabilityConfig | undefined;
+
+    /**
+     * Approved deviations, in the order they are specified
+     */
+    readonly deviations: DeviationConfig[] | undefined;
+
+    /**
+     * Descriptions of the invalid entries found when compiling the configuration
+     */
+    readonly issues: string[] = [];
+
+    /**
+     * Function definitions of the program, indexed by name
+     */
+    #definitions: Map<string, FunctionJp[]> | undefined = undefined;
+
+    /**
+     * Definitions already resolved, indexed by name and location
+     */
+    #resolvedDefinitions = new Map<string, FunctionJp | undefined>();
+
+    /**
+     * @param data The parsed content of the configuration file
+     */
+    constructor(data: Record<string, any>) {
+        this.defaultValues = this.compileSection(data, "defaultValues", (entries) => new Map(
+            Object.entries(entries)
+                .filter(([, value]) => value !== undefined)
+                .map(([type, value]): [string, string] => [type, String(value)])
+        ));
+
+        this.implicitCalls = this.compileSection(data, "implicitCalls", (entries) => new Map(
+            Object.entries(entries).map(([functionName, location]): [string, string | undefined] => {
+                const isValid = typeof location === "string" && (location.endsWith(".h") || location.endsWith(".c"));
+                if (!isValid) {
+                    this.issues.push(`Entry 'implicitCalls.${functionName}' is not a .h or .c reference.`);
+                }
+                return [functionName, isValid ? location : undefined];
+            })
+        ));
+
+        this.disallowedFunctions = this.compileSection(data, "disallowedFunctions", (libraries) => new Map(
+            Object.entries(libraries).map(([library, functions]): [string, Map<string, DisallowedFunctionFix | undefined>] => {
+                if (!isObject(functions)) {
+                    this.issues.push(`Entry 'disallowedFunctions.${library}' must be an object.`);
+                }
+                return [library, new Map(
+                    Object.entries(isObject(functions) ? functions : {}).map(([functionName, fix]): [string, DisallowedFunctionFix | undefined] => {
+                        const isValid = isObject(fix) && typeof fix.replacement === "string" && typeof fix.location === "string";
+                        if (!isValid) {
+                            this.issues.push(`Entry 'disallowedFunctions.${library}.${functionName}' must define 'replacement' and 'location'.`);
+                        }
+                        return [functionName, isValid ? { replacement: fix.replacement, location: fix.location } : undefined];
+                    })
+                )];
+            })
+        ));
+
+        this.switchConversion = this.compileSection(data, "switchConversion", (options) => {
+            const threshold = options.decisionTreeThreshold;
+            const isValid = threshold === undefined || (Number.isInteger(threshold) && threshold >= 2);
+            if (!isValid) {
+                this.issues.push(`Entry 'switchConversion.decisionTreeThreshold' must be an integer greater than or equal to 2.`);
+            }
+            return { decisionTreeThreshold: isValid ? threshold : undefined };
+        });
+
+        this.poolAllocator = this.compileSection(data, "poolAllocator", (options) => {
+            const { location, blockSizes, blocksPerPool } = options;
+            if (typeof location !== "string" || !location.endsWith(".c")) {
+                this.issues.push(`Entry 'poolAllocator.location' must be a .c file.`);
+                return undefined;
+            }
+            const validSizes = blockSizes === undefined || 
+                (Array.isArray(blockSizes) && blockSizes.length > 0 && blockSizes.every(size => Number.isInteger(size) && size > 0));
+            if (!validSizes) {
+                this.issues.push(`Entry 'poolAllocator.blockSizes' must be a non-empty list of positive integers.`);
+            }
+            const validCount = blocksPerPool === undefined || (Number.isInteger(blocksPerPool) && blocksPerPool > 0);
+            if (!validCount) {
+                this.issues.push(`Entry 'poolAllocator.blocksPerPool' must be a positive integer.`);
+            }
+            return {
+                location,
+                blockSizes: validSizes ? blockSizes : undefined,
+                blocksPerPool: validCount ? blocksPerPool : undefined
+            };
+        });
+
+        this.numericConversions = this.compileSection(data, "numericConversions", (options) => {
+            if (typeof options.location !== "string" || !options.location.endsWith(".c")) {
+                this.issues.push(`Entry 'numericConversions.location' must be a .c file.`);
+                return undefined;
+            }
+            return { location: options.location };
+        });
+
+        this.reachability = this.compileSection(data, "reachability", (options) => {
+            const entryPoints = options.entryPoints ?? [];
+            const isValid = Array.isArray(entryPoints) && entryPoints.every(name => typeof name === "string");
+            if (!isValid) {
+                this.issues.push(`Entry 'reachability.entryPoints' must be a list of function names.`);
+            }
+            return { entryPoints: isValid ? entryPoints : [] };
+        });
+
+        this.deviations = this.compileSection(data, "deviations", (entries) => 
+            Object.entries(entries).flatMap(([id, entry]): DeviationConfig[] => {
+                if (!isObject(entry) || !Array.isArray(entry.rules) || entry.rules.length === 0 || !entry.rules.every((rule: any) => typeof rule === "string")) {
+                    this.issues.push(`Entry 'deviations.${id}' must define 'rules' as a non-empty list of rule identifiers.`);
+                    return [];
+                }
+                const lines = entry.lines;
+                const validLines = lines === undefined || 
+                    (Array.isArray(lines) && lines.length === 2 && lines.every(line => Number.isInteger(line) && line > 0) && lines[0] <= lines[1]);
+                if (!validLines || !["file", "function", "reason"].every(field => entry[field] === undefined || typeof entry[field] === "string")) {
+                    this.issues.push(`Entry 'deviations.${id}' must have text 'file', 'function' and 'reason', and 'lines' as [first, last].`);
+                    return [];
+                }
+                return [{ id, rules: entry.rules, file: entry.file, function: entry.function, lines, reason: entry.reason }];
+            })
+        );
+    }
+
+    private compileSection<T>(data: Record<string, any>, section: string, compile: (entries: Record<string, any>) => T): T | undefined {
+        if (data[section] === undefined) {
+            return undefined;
+        }
+        if (!isObject(data[section])) {
+            this.issues.push(`Section '${section}' must be an object.`);
+            return undefined;
+        }
+        return compile(data[section]);
+    }
+
+    /**
+     * Returns the first definition of the given function in a file whose path ends with the given suffix
+     *
+     * @param functionName Name of the function
+     * @param pathSuffix File path suffix
+     * @returns The function definition, or undefined if not found
+     */
+    findFunctionDef(functionName: string, pathSuffix: string): FunctionJp | undefined {
+        const key = `${functionName}@${pathSuffix}`;
+        if (this.#resolvedDefinitions.has(key)) {
+            return this.#resolvedDefinitions.get(key);
+        }
+
+        if (this.#definitions === undefined) {
+            this.#definitions = new Map();
+            for (const functionJp of Query.search(FunctionJp, {isImplementation: true}).get()) {
+                this.#definitions.set(functionJp.name, [...(this.#definitions.get(functionJp.name) ?? []), functionJp]);
+            }
+        }
+
+        const functionDef = this.#definitions.get(functionName)?.find(functionJp => {
+            try {
+                return functionJp.filepath.endsWith(pathSuffix);
+            } catch (error) {
+                return false;
+            }
+        });
+        this.#resolvedDefinitions.set(key, functionDef);
+        return functionDef;
+    }
+
+    /**
+     * Discards the index of function definitions, e.g., after rebuilding files
+     */
+    invalidateDefinitions() {
+        this.#definitions = undefined;
+        this.#resolvedDefinitions.clear();
+    }
+}
+
+function isObject(value: any): value is Record<string, any> {
+    return typeof value === "object" && value !== null && !Array.isArray(value);
+}
@@ -1,8 +1,17 @@
-import { EnumDecl, FunctionJp, Joinpoint, LabelStmt, RecordJp, TypedefDecl, Vardecl } from "@specs-feup/clava/api/Joinpoints.js";
-import { MISRAError, MISRATransformationResults, MISRATransformationType } from "./MISRA.js";
+import { EnumDecl, FileJp, FunctionJp, Joinpoint, LabelStmt, RecordJp, Switch, TypedefDecl, Vardecl } from "@specs-feup/clava/api/Joinpoints.js";
+import { MISRAError, MISRASwitchConverter, MISRATransformationResults, MISRATransformationType, SourceLocation, SwitchConversionOptions } from "./MISRA.js";
 import * as fs from 'fs';
 import Context from "./ast-visitor/Context.js";
-import { compareLocation, getFileLocation } from "./utils/JoinpointUtils.js";
+import MISRATransaction from "./MISRATransaction.js";
+import { SwitchSummary } from "./utils/SwitchUtils.js";
+import { FunctionCfg } from "./utils/CfgUtils.js";
+import { SideEffectAnalysis } from "./utils/SideEffectUtils.js";
+import { EssentialTypeAnalysis } from "./utils/EssentialTypeUtils.js";
+import MISRAConfig from "./MISRAConfig.js";
+import MISRAErrorStore from "./MISRAErrorStore.js";
+import MISRADeviations from "./MISRADeviations.js";
+import { ConsoleFormatter, ReportFormatter, sortErrorsByLocation, SuppressedError, writeReport } from "./MISRAReport.js";
+import { ChangeImpact } from "./utils/ChangeImpactUtils.js";
 
 /**
  * Tracks MISRA-C violations during the analysis and/or transformation of the code.
@@ -15,13 +24,82 @@ export default class MISRAContext extends Context<MISRATransformationResults> {
      * When checking compliance, this includes all detected violations.
      * When performing transformations, it includes only the violations that could not be resolved.
      */
-    #misraErrors: MISRAError[] = [];
-    #misraErrorKeys = new Set<string>();
+    #misraErrors = new MISRAErrorStore(() => this.#changeCount);
+
+    /**
+     * Stores the violations suppressed by approved deviations, with the deviation that suppressed each one
+     */
+    #suppressedErrors = new MISRAErrorStore(() => this.#changeCount);
+
+    /**
+     * Identifiers of the impacted files and shared declarations analyzed in diff-aware mode, or undefined if the whole program is analyzed
+     */
+    #analysisScope: { files: Set<string>, decls: Set<string> } | undefined = undefined;
 
     /**
      * User-provided configuration to assist in violation correction
      */
-    #config: Map<string, any> | undefined = undefined;
+    #config: MISRAConfig | undefined = undefined;
+
+    /**
+     * Index of the approved deviations of the configuration and of the source code, created on first use
+     */
+    #deviations: MISRADeviations | undefined = undefined;
+
+    /**
+     * Number of the current correction iteration (0 during analysis)
+     */
+    #iteration = 0;
+
+    /**
+     * Summaries of switch statements, computed once per iteration and shared by the rules that analyze them
+     */
+    #switchSummaries = new Map<string, {iteration: number, summary: SwitchSummary}>();
+
+    /**
+     * Control flow information of the functions, kept while the functions do not change
+     */
+    #functionCfgs = new Map<string, {epoch: string, cfg: FunctionCfg}>();
+
+    /**
+     * Number of changes that may affect any function (e.g., changes to a whole file)
+     */
+    #globalEpoch = 0;
+
+    /**
+     * Number of changes made inside each function, or at the file scope of each file
+     */
+    #scopeEpochs = new Map<string, number>();
+
+    /**
+     * Total number of changes
+     */
+    #changeCount = 0;
+
+    /**
+     * Number of changes that may affect any file
+     */
+    #programVersion = 0;
+
+    /**
+     * Number of changes made to each file
+     */
+    #fileVersions = new Map<string, number>();
+
+    /**
+     * Paths of the files changed by the correction, whose nodes keep the positions of the text they were parsed from
+     */
+    #editedFiles = new Set<string>();
+
+    /**
+     * Side effect summaries of the functions, kept while the functions and the functions they call do not change
+     */
+    #sideEffects = new SideEffectAnalysis(functionId => this.getFunctionEpoch(functionId), () => this.#changeCount);
+
+    /**
+     * Essential types of the expressions, kept while the functions (or the file scopes) that contain them do not change
+     */
+    #essentialTypes = new EssentialTypeAnalysis($jp => getScope($jp)?.astId ?? "", scopeId => this.getFunctionEpoch(scopeId));
 
     #varCounter = 0;
     #functionCounter = 0;
@@ -43,39 +121,66 @@ export default class MISRAContext extends Context<MISRATransformationResults> {
      * Returns all violations found in the source code.
      */
     get errors(): MISRAError[] {
-        return this.#misraErrors;
+        return this.#misraErrors.getErrors();
+    }
+
+    /**
+     * Returns the violations suppressed by approved deviations, ordered by location, with the deviation that suppressed each one
+     *
+     * @param activeOnly Whether only the violations linked to nodes that are still present in the AST are returned (e.g., after correction)
+     */
+    getSuppressedErrors(activeOnly: boolean = false): SuppressedError[] {
+        const errors = activeOnly ? this.#suppressedErrors.getActiveErrors(filepath => this.isFileEdited(filepath)) : this.#suppressedErrors.getErrors();
+        sortErrorsByLocation(errors);
+        const deviations = new Map(this.deviations.appliedDeviations.map(deviation => [deviation.id, deviation]));
+        return errors.map(error => ({ error, deviation: deviations.get(error.deviationId!)! }));
+    }
+
+    /**
+     * Returns the number of violations found in the source code, without creating their views
+     */
+    get errorCount(): number {
+        return this.#misraErrors.size;
     }
 
     /**
      * Returns violations linked to nodes that are still present in the AST after correction.
+     * Violations in files changed by the correction refer to the whole file, since their positions are no longer valid.
      */
     get activeErrors(): MISRAError[] {
-        return this.#misraErrors.filter(error => error.isActiveError());
+        return this.#misraErrors.getActiveErrors(filepath => this.isFileEdited(filepath));
     }
 
     /**
-     * Orders errors according to their location
+     * Returns the number of the current correction iteration. During analysis, it is always 0.
      */
-    private sortErrors(errors?: MISRAError[]) {
-        let errorList = errors ? errors : this.#misraErrors;
-        errorList.sort((error1, error2) => compareLocation(error1.joinpoint, error2.joinpoint));
+    get iteration(): number {
+        return this.#iteration;
+    }
+
+    /**
+     * Starts a new correction iteration, so that data computed once per iteration is recomputed
+     */
+    nextIteration() {
+        this.#iteration++;
     }
 
    /**
     * Returns the user-provided configuration that assists in violation correction, if provided. Otherwise, returns undefined. 
     */
-    get config(): Map<string, any> | undefined {
+    get config(): MISRAConfig | undefined {
         return this.#config;
     }
 
     /**
-     * Loads the JSON config file and transforms it into an internal Map representation.
+     * Loads the JSON config file and compiles it into typed lookup tables, reporting its invalid entries once.
      * If the file does not exist, logs an error and exits the process.
      */
     set config(configFilePath: string) {
         if (fs.existsSync(configFilePath)) {
             const data = fs.readFileSync(configFilePath, 'utf-8');
-            this.#config = new Map(Object.entries(JSON.parse(data)));
+            this.#config = new MISRAConfig(JSON.parse(data));
+            this.#config.issues.forEach(issue => console.log(`[Clava-MISRATool] Invalid configuration: ${issue}`));
         } else {
             console.error(`[Clava-MISRATool] Provided configuration file was not found.`);
             process.exit(1);
@@ -83,14 +188,214 @@ export default class MISRAContext extends Context<MISRATransformationResults> {
     }
 
     /**
-     * Clears stored information.
+     * Returns the index of the approved deviations, created from the configuration and the annotations of the files when first used
+     */
+    get deviations(): MISRADeviations {
+        if (this.#deviations === undefined) {
+            this.#deviations = new MISRADeviations(this.#config?.deviations);
+        }
+        return this.#deviations;
+    }
+
+    /**
+     * Restricts the analysis to the part of the program impacted by some changes. Whole-program rules still analyze the whole program,
+     * but only the violations in the impacted files and in the declarations that share their names are recorded.
+     *
+     * @param impact The impacted part of the program
+     */
+    setAnalysisScope(impact: ChangeImpact) {
+        this.#analysisScope = {
+            files: new Set(impact.files.map(fileJp => fileJp.astId)),
+            decls: new Set(impact.sharedDecls.map(declJp => declJp.astId))
+        };
+    }
+
+    /**
+     * Checks if the given node is analyzed: always, unless the analysis is restricted to the part of the program impacted by some changes,
+     * in which case the node must belong to an impacted file or to a shared declaration
+     *
+     * @param $jp The node
+     */
+    isInAnalysisScope($jp: Joinpoint): boolean {
+        const scope = this.#analysisScope;
+        if (scope === undefined) {
+            return true;
+        }
+
+        const fileJp = $jp instanceof FileJp ? $jp : $jp.getAncestor("file") as FileJp | undefined;
+        if (fileJp !== undefined && scope.files.has(fileJp.astId)) {
+            return true;
+        }
+        for (let jp: Joinpoint | undefined = $jp; jp; jp = jp.parent) {
+            if (scope.decls.has(jp.astId)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Clears stored information, e.g., after the whole program is rebuilt.
+     * The deviations of the files are located again in the rebuilt program, while the applied deviations are kept for the report.
      */
     resetStorage() {
         [...this.storage.keys()].forEach(key => {
             this.storage.set(key, new Map())
         });
-        this.#misraErrors = [];
-        this.#misraErrorKeys = new Set<string>();
+        this.#misraErrors.clear();
+        this.#suppressedErrors.clear();
+        this.#deviations?.reset();
+        this.#switchSummaries.clear();
+        this.#functionCfgs.clear();
+        this.#sideEffects.clear();
+        this.#essentialTypes.clear();
+        this.#config?.invalidateDefinitions();
+    }
+
+    /**
+     * Clears stored information about the given nodes, e.g., the nodes of files that were rebuilt.
+     * 
+     * @param nodeIds Identifiers of the nodes whose transformation results and errors are discarded
+     */
+    resetNodeStorage(nodeIds: Set<string>) {
+        for (const transformations of this.storage.values()) {
+            nodeIds.forEach(nodeId => transformations.delete(nodeId));
+        }
+        this.#misraErrors.removeNodes(nodeIds);
+        this.#suppressedErrors.removeNodes(nodeIds);
+        nodeIds.forEach(nodeId => {
+            this.#switchSummaries.delete(nodeId);
+            this.#functionCfgs.delete(nodeId);
+        });
+        this.#config?.invalidateDefinitions();
+    }
+
+    /**
+     * Returns the summary of the given switch statement, computing it if it was not computed in the current iteration
+     * 
+     * @param switchJp The switch statement
+     */
+    getSwitchSummary(switchJp: Switch): SwitchSummary {
+        const entry = this.#switchSummaries.get(switchJp.astId);
+        if (entry !== undefined && entry.iteration === this.#iteration) {
+            return entry.summary;
+        }
+
+        const summary = new SwitchSummary(switchJp);
+        this.#switchSummaries.set(switchJp.astId, {iteration: this.#iteration, summary});
+        return summary;
+    }
+
+    /**
+     * Discards the summary of a switch statement, e.g., after a rule changes it
+     * 
+     * @param switchJp The changed switch statement
+     */
+    invalidateSwitchSummary(switchJp: Switch) {
+        this.#switchSummaries.delete(switchJp.astId);
+    }
+
+    /**
+     * Records that a transformation was applied, so that the data derived from the changed code is recomputed
+     * 
+     * @param functionJp The function that contains the changes, or undefined if they may affect any function
+     */
+    notifyChange(functionJp?: FunctionJp) {
+        this.#changeCount++;
+        if (functionJp === undefined) {
+            this.#globalEpoch++;
+        } else {
+            this.#scopeEpochs.set(functionJp.astId, (this.#scopeEpochs.get(functionJp.astId) ?? 0) + 1);
+        }
+    }
+
+    /**
+     * Records a change limited to the given node (e.g., a renamed declaration), which only affects the function that contains it,
+     * or the file scope of its file if it is outside functions. A changed function also discards the index of function definitions by name.
+     * 
+     * @param $jp The changed node
+     */
+    notifyNodeChange($jp: Joinpoint) {
+        const scopeJp = getScope($jp);
+        this.#changeCount++;
+        if (scopeJp !== undefined) {
+            this.#scopeEpochs.set(scopeJp.astId, (this.#scopeEpochs.get(scopeJp.astId) ?? 0) + 1);
+        }
+        if ($jp instanceof FunctionJp) {
+            this.#config?.invalidateDefinitions();
+        }
+    }
+
+    /**
+     * Records that a transformation changed the given file, so that the data derived from its text is recomputed
+     * 
+     * @param fileJp The changed file, or undefined if the changes may affect any file
+     */
+    notifyFileChange(fileJp?: FileJp) {
+        if (fileJp === undefined) {
+            this.#programVersion++;
+        } else {
+            this.#fileVersions.set(fileJp.astId, (this.#fileVersions.get(fileJp.astId) ?? 0) + 1);
+            this.#editedFiles.add(fileJp.filepath);
+        }
+    }
+
+    /**
+     * Checks if the given file was changed by the correction, so that the positions of its nodes no longer match its code
+     *
+     * @param filepath Path of the file
+     */
+    isFileEdited(filepath: string): boolean {
+        return this.#programVersion > 0 || this.#editedFiles.has(filepath);
+    }
+
+    /**
+     * Returns the current version of the given file, which changes whenever a change may affect it
+     * 
+     * @param fileJp The file
+     */
+    getFileVersion(fileJp: FileJp): number {
+        return this.#programVersion + (this.#fileVersions.get(fileJp.astId) ?? 0);
+    }
+
+    /**
+     * Returns the current version of the given function (or file scope), which changes whenever a change may affect it
+     * 
+     * @param functionId Identifier of the function, or of the file for its file scope
+     */
+    getFunctionEpoch(functionId: string): string {
+        return `${this.#globalEpoch}.${this.#scopeEpochs.get(functionId) ?? 0}`;
+    }
+
+    /**
+     * Returns the control flow information of the given function, computing it again only if the function changed since it was computed
+     * 
+     * @param functionJp The function
+     */
+    getFunctionCfg(functionJp: FunctionJp): FunctionCfg {
+        const epoch = this.getFunctionEpoch(functionJp.astId);
+        const entry = this.#functionCfgs.get(functionJp.astId);
+        if (entry !== undefined && entry.epoch === epoch) {
+            return entry.cfg;
+        }
+
+        const cfg = new FunctionCfg(functionJp);
+        this.#functionCfgs.set(functionJp.astId, {epoch, cfg});
+        return cfg;
+    }
+
+    /**
+     * Returns the interprocedural side effect analysis, whose summaries are shared by the rules
+     */
+    get sideEffects(): SideEffectAnalysis {
+        return this.#sideEffects;
+    }
+
+    /**
+     * Returns the essential type inference, whose results are shared by the rules of the essential type model
+     */
+    get essentialTypes(): EssentialTypeAnalysis {
+        return this.#essentialTypes;
     }
 
     /**
@@ -122,23 +427,56 @@ export default class MISRAContext extends Context<MISRATransformationResults> {
     }
 
     /**
-     * Registers a new violation of the standard
+     * Registers a new violation of the standard, or a suppressed violation if an approved deviation covers it
      * 
      * @param ruleID Identifier of the violated rule
      * @param $jp Joinpoint where the error was detected
      * @param message Description of the error
+     * @param location Position of the violation in the file, if more precise than the joinpoint
      */
-    addMISRAError(ruleID: string, $jp: Joinpoint, message: string) {
-        const key = `${ruleID}-${$jp.astId}-${message}`;
-        if (!this.#misraErrorKeys.has(key)) {
-            this.#misraErrorKeys.add(key);
-            this.#misraErrors.push(new MISRAError(ruleID, $jp, message));
+    addMISRAError(ruleID: string, $jp: Joinpoint, message: string, location?: SourceLocation) {
+        if (!this.isInAnalysisScope($jp)) { // Outside the part of the program impacted by the changes (e.g., found by whole-program rules)
+            return;
+        }
+        const deviation = this.deviations.find(ruleID, $jp, location);
+        if (deviation !== undefined) { // Covered by an approved deviation, so it is only listed as suppressed
+            this.#suppressedErrors.add(ruleID, $jp, message, location, deviation.id);
+            return;
         }
+        this.#misraErrors.add(ruleID, $jp, message, location);
+    }
+
+    /**
+     * Starts recording the AST edits of a fix attempt, so that they can be committed or rolled back at once
+     * 
+     * @returns The new transaction
+     */
+    beginTransaction(): MISRATransaction {
+        return new MISRATransaction();
+    }
+
+    /**
+     * Returns the options of the conversion of switch statements into if statements: the decision tree threshold of the configuration,
+     * the constant values of the essential type analysis and the names of the generated variables
+     */
+    get switchConversionOptions(): SwitchConversionOptions {
+        return {
+            decisionTreeThreshold: this.#config?.switchConversion?.decisionTreeThreshold ?? MISRASwitchConverter.DEFAULT_DECISION_TREE_THRESHOLD,
+            evaluate: exprJp => this.#essentialTypes.getConstantValue(exprJp),
+            generateName: () => this.generateVariableName()
+        };
+    }
+
+    /**
+     * @returns A new name for a generated variable
+     */
+    generateVariableName(): string {
+        return `${this.#varPrefix}${this.#varCounter++}`;
     }
 
     generateIdentifierName($jp: Joinpoint) {
         if ($jp instanceof Vardecl) {
-            return `${this.#varPrefix}${this.#varCounter++}`;
+            return this.generateVariableName();
         } else if ($jp instanceof FunctionJp) {
             return `${this.#funcPrefix}${this.#functionCounter++}`;
         } else if ($jp instanceof LabelStmt) {
@@ -155,28 +493,35 @@ export default class MISRAContext extends Context<MISRATransformationResults> {
     }
 
     /**
-     * Outputs a formatted MISRA-C rule violation message
+     * Reports all violations found in the source code, ordered by location, followed by the suppressed violations.
      * 
-     * @param error - The MISRA error object containing the rule ID, message, and location
+     * @param formatter The formatter of the report, by default the console
      */
-    private outputError(error: MISRAError): void {
-        console.log(`- [Rule ${error.ruleID}] at ${getFileLocation(error.joinpoint)}: ${error.message}\n`);
+    outputAllErrors(formatter: ReportFormatter = new ConsoleFormatter()): void {
+        const errors = this.errors;
+        sortErrorsByLocation(errors);
+        writeReport(errors, formatter, this.getSuppressedErrors());
     }
     
     /**
-     * Displays all violations found in the source code.
-     */
-    outputAllErrors(): void {
-        this.sortErrors();
-        this.#misraErrors.forEach(error => this.outputError(error));
-    }
-    
-    /**
-     * Displays violations linked to nodes that are still present in the AST after correction.
+     * Reports violations linked to nodes that are still present in the AST after correction, ordered by location,
+     * followed by the suppressed violations of those nodes.
+     * 
+     * @param formatter The formatter of the report, by default the console
      */
-    outputActiveErrors(): void {
+    outputActiveErrors(formatter: ReportFormatter = new ConsoleFormatter()): void {
         const errors = this.activeErrors;
-        this.sortErrors(errors);
-        errors.forEach(error => this.outputError(error));
+        sortErrorsByLocation(errors);
+        writeReport(errors, formatter, this.getSuppressedErrors(true));
+    }
+}
+
+/**
+ * Returns the scope whose version covers the given node: the function that contains it, or its file if it is outside functions
+ */
+function getScope($jp: Joinpoint): Joinpoint | undefined {
+    if ($jp instanceof FunctionJp || $jp instanceof FileJp) {
+        return $jp;
     }
+    return ($jp.getAncestor("function") ?? $jp.getAncestor("file")) as Joinpoint | undefined;
 }
@@ -0,0 +1,318 @@
+import { FileJp, FunctionJp, Joinpoint, Program } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import * as fs from 'fs';
+import path from "path";
+import { DeviationConfig } from "./MISRAConfig.js";
+import { SourceLocation } from "./MISRA.js";
+import { TokenKind, tokenize } from "./utils/LexerUtils.js";
+
+/**
+ * An approved deviation, from the configuration or from an annotation in the source code
+ */
+export interface Deviation {
+    /**
+     * Identifier of the deviation: the key of the configuration entry, or the location of the annotation
+     */
+    id: string;
+    /**
+     * Rules covered by the deviation, or undefined for all rules
+     */
+    rules: Set<string> | undefined;
+    /**
+     * Justification of the deviation
+     */
+    reason: string | undefined;
+    /**
+     * Whether the deviation is annotated in the source code, instead of recorded in the configuration
+     */
+    inSource: boolean;
+}
+
+/**
+ * Lines of a file covered by a deviation
+ */
+interface DeviationInterval {
+    first: number;
+    last: number;
+    deviation: Deviation;
+}
+
+/**
+ * Position of a node, located once and checked against the deviations of every rule
+ */
+export interface DeviationPosition {
+    /**
+     * Deviations of the lines of the file, ordered by their first line
+     */
+    intervals: DeviationInterval[];
+    /**
+     * Line of the node, or undefined if the node is a whole file
+     */
+    line: number | undefined;
+    /**
+     * Deviations of the enclosing function of the node
+     */
+    functionDeviations: Deviation[];
+}
+
+/**
+ * Last line of a file, used by the deviations that cover whole files
+ */
+const END_OF_FILE = Number.MAX_SAFE_INTEGER;
+
+/**
+ * Annotation of a deviation in a comment: 'misra-deviation <rules>: <reason>' covers the lines of the comment and the next line,
+ * while 'misra-deviation-begin <rules>: <reason>' covers the lines until the next 'misra-deviation-end' (or the end of the file).
+ * Rules are separated by commas or spaces, and '*' covers all rules.
+ */
+const ANNOTATION_PATTERN = /misra-deviation(-begin|-end)?(?![\w-])([^:]*)(?::([\s\S]*))?/;
+
+/**
+ * Index of the approved deviations, consulted when a violation is logged, so that the covered violations are only recorded as suppressed,
+ * and before correcting the nodes, so that the rules skip the suppressed code. Rules that correct the whole program at once,
+ * from the program node, check the deviations of each of their candidates instead.
+ *
+ * The deviations of each file (configuration entries with a matching file glob, with or without line ranges, and the annotations
+ * of the file) are kept as intervals of lines, computed once per version of the file. Annotations are read from the text
+ * that the line numbers of the nodes refer to: the original file, or the generated code of files rebuilt by the correction.
+ * Deviations of functions are resolved through the enclosing function of each node.
+ */
+export default class MISRADeviations {
+    /**
+     * Deviations of the configuration
+     */
+    #configDeviations: { config: DeviationConfig, deviation: Deviation, filePattern: RegExp | undefined }[];
+
+    /**
+     * Intervals of each file, indexed by the identifier of the file
+     */
+    #fileIntervals = new Map<string, DeviationInterval[]>();
+
+    /**
+     * Identifiers of the files parsed from their original text
+     */
+    #originalFiles: Set<string>;
+
+    /**
+     * Deviations that suppressed the report or correction of some violation, indexed by identifier,
+     * so that the deviations located again in a rebuilt program are listed once
+     */
+    #appliedDeviations = new Map<string, Deviation>();
+
+    /**
+     * Whether there are no deviations, or undefined if not computed yet
+     */
+    #isEmpty: boolean | undefined = undefined;
+
+    /**
+     * @param configDeviations The deviations of the configuration file, if any
+     */
+    constructor(configDeviations: DeviationConfig[] = []) {
+        this.#configDeviations = configDeviations.map(config => ({
+            config,
+            deviation: { id: config.id, rules: config.rules.includes("*") ? undefined : new Set(config.rules), reason: config.reason, inSource: false },
+            filePattern: config.file !== undefined ? globToRegExp(config.file) : undefined
+        }));
+        this.#originalFiles = new Set(Query.search(FileJp).get().map(fileJp => fileJp.astId));
+    }
+
+    /**
+     * Deviations that suppressed the report or correction of some violation, in the order they were applied
+     */
+    get appliedDeviations(): Deviation[] {
+        return Array.from(this.#appliedDeviations.values());
+    }
+
+    /**
+     * Discards the deviations computed for each file, e.g., after the program is rebuilt from its generated code,
+     * keeping the deviations already applied
+     */
+    reset() {
+        this.#fileIntervals.clear();
+        this.#originalFiles.clear();
+        this.#isEmpty = undefined;
+    }
+
+    /**
+     * Locates a node, so that the deviations of each rule at its position can be checked without querying the AST again
+     *
+     * @param $jp The node
+     * @param fileJp The file that contains the node, if already known
+     * @param location Position of a violation, if more precise than the node
+     * @returns The position of the node, or undefined if the node is not in a file or no deviation applies to its file
+     */
+    locate($jp: Joinpoint, fileJp?: FileJp, location?: SourceLocation): DeviationPosition | undefined {
+        if ($jp instanceof Program) {
+            return undefined;
+        }
+        const file = fileJp ?? ($jp instanceof FileJp ? $jp : $jp.getAncestor("file") as FileJp | undefined);
+        if (file === undefined) {
+            return undefined;
+        }
+
+        const intervals = this.getFileIntervals(file);
+        const functionConfigs = this.#configDeviations.filter(({ config, filePattern }) => config.function !== undefined && matchesFile(file, filePattern));
+        if (intervals.length === 0 && functionConfigs.length === 0) {
+            return undefined;
+        }
+
+        const line = location?.line ?? ($jp instanceof FileJp ? undefined : $jp.line);
+        let functionDeviations: Deviation[] = [];
+        if (functionConfigs.length > 0) {
+            const functionJp = $jp instanceof FunctionJp ? $jp : $jp.getAncestor("function") as FunctionJp | undefined;
+            functionDeviations = functionConfigs.filter(({ config }) => config.function === functionJp?.name).map(({ deviation }) => deviation);
+        }
+        return { intervals, line, functionDeviations };
+    }
+
+    /**
+     * Returns the deviation of the given rule at a position, marking it as applied
+     *
+     * @param ruleID Identifier of the rule
+     * @param position The position returned by {@link locate}
+     * @returns The deviation, or undefined if the rule is not suppressed at the position
+     */
+    findAt(ruleID: string, position: DeviationPosition | undefined): Deviation | undefined {
+        if (position === undefined) {
+            return undefined;
+        }
+        const covers = (deviation: Deviation) => deviation.rules === undefined || deviation.rules.has(ruleID);
+
+        let deviation = position.functionDeviations.find(covers);
+        const line = position.line;
+        for (const interval of position.intervals) {
+            if (deviation !== undefined || interval.first > (line ?? 1)) { // Intervals are ordered by their first line
+                break;
+            }
+            const coversLine = line !== undefined ? line <= interval.last : interval.last === END_OF_FILE;
+            if (coversLine && covers(interval.deviation)) {
+                deviation = interval.deviation;
+            }
+        }
+        if (deviation !== undefined) {
+            this.#appliedDeviations.set(deviation.id, deviation);
+        }
+        return deviation;
+    }
+
+    /**
+     * Returns the deviation of the given rule at the location of a node, marking it as applied
+     *
+     * @param ruleID Identifier of the rule
+     * @param $jp The node
+     * @param location Position of a violation, if more precise than the node
+     */
+    find(ruleID: string, $jp: Joinpoint, location?: SourceLocation): Deviation | undefined {
+        return this.isEmpty ? undefined : this.findAt(ruleID, this.locate($jp, undefined, location));
+    }
+
+    /**
+     * Whether there are no deviations, in which case nodes do not need to be located.
+     * Computed once, since the correction does not add annotations.
+     */
+    get isEmpty(): boolean {
+        if (this.#isEmpty === undefined) {
+            this.#isEmpty = this.#configDeviations.length === 0 && Query.search(FileJp).get().every(fileJp => this.getFileIntervals(fileJp).length === 0);
+        }
+        return this.#isEmpty;
+    }
+
+    private getFileIntervals(fileJp: FileJp): DeviationInterval[] {
+        let intervals = this.#fileIntervals.get(fileJp.astId);
+        if (intervals !== undefined) {
+            return intervals;
+        }
+
+        intervals = this.#configDeviations
+            .filter(({ config, filePattern }) => config.function === undefined && matchesFile(fileJp, filePattern))
+            .map(({ config, deviation }) => ({ first: config.lines?.[0] ?? 1, last: config.lines?.[1] ?? END_OF_FILE, deviation }));
+        intervals.push(...getAnnotatedIntervals(fileJp, this.getLineText(fileJp)));
+        intervals.sort((a, b) => a.first - b.first);
+
+        this.#fileIntervals.set(fileJp.astId, intervals);
+        return intervals;
+    }
+
+    /**
+     * Returns the text that the line numbers of the nodes of the file refer to
+     */
+    private getLineText(fileJp: FileJp): string {
+        if (this.#originalFiles.has(fileJp.astId) && fs.existsSync(fileJp.filepath)) {
+            return fs.readFileSync(fileJp.filepath, 'utf-8');
+        }
+        return fileJp.code;
+    }
+}
+
+/**
+ * Finds the deviations annotated in the comments of a file
+ */
+function getAnnotatedIntervals(fileJp: FileJp, code: string): DeviationInterval[] {
+    if (!code.includes("misra-deviation")) {
+        return [];
+    }
+
+    const intervals: DeviationInterval[] = [];
+    const open: { first: number, deviation: Deviation }[] = [];
+    for (const token of tokenize(code)) {
+        if (token.kind !== TokenKind.LINE_COMMENT && token.kind !== TokenKind.BLOCK_COMMENT) {
+            continue;
+        }
+        const annotation = ANNOTATION_PATTERN.exec(token.text);
+        if (annotation === null) {
+            continue;
+        }
+
+        const [, kind, ruleList, reasonText] = annotation;
+        const lastLine = token.line + (token.text.match(/\n/g)?.length ?? 0);
+        if (kind === "-end") {
+            const begin = open.pop();
+            if (begin !== undefined) {
+                intervals.push({ first: begin.first, last: lastLine, deviation: begin.deviation });
+            }
+            continue;
+        }
+
+        const rules = ruleList.replace(/\*\/\s*$/, "").split(/[\s,]+/).filter(rule => /^(\d+\.\d+|\*)$/.test(rule));
+        const reason = reasonText?.replace(/\*\/\s*$/, "").trim();
+        const deviation: Deviation = {
+            id: `${fileJp.name}@${token.line}`,
+            rules: rules.length === 0 || rules.includes("*") ? undefined : new Set(rules),
+            reason: reason || undefined,
+            inSource: true
+        };
+        if (kind === "-begin") {
+            open.push({ first: token.line, deviation });
+        } else {
+            intervals.push({ first: token.line, last: lastLine + 1, deviation });
+        }
+    }
+    open.forEach(begin => intervals.push({ first: begin.first, last: END_OF_FILE, deviation: begin.deviation }));
+    return intervals;
+}
+
+/**
+ * Checks if the path of a file, relative to the source folder or absolute, matches the glob of a deviation
+ */
+function matchesFile(fileJp: FileJp, filePattern: RegExp | undefined): boolean {
+    if (filePattern === undefined) {
+        return true;
+    }
+    const relativePath = path.join(fileJp.relativeFolderpath ?? "", fileJp.name).split(path.sep).join("/");
+    return filePattern.test(relativePath) || filePattern.test(fileJp.filepath.split(path.sep).join("/"));
+}
+
+/**
+ * Converts a glob into a regular expression: '**' matches any path, '**\/' any sequence of folders (including none),
+ * '*' any part of a name and '?' a single character
+ */
+function globToRegExp(glob: string): RegExp {
+    const pattern = glob.split(/(\*\*\/?|\*|\?)/).map(part => {
+        if (part === "**/") return "(?:.*/)?";
+        if (part === "**") return ".*";
+        if (part === "*") return "[^/]*";
+        if (part === "?") return "[^/]";
+        return part.replace(/[.+^${}()|[\]\\]/g, "\\$&");
+    }).join("");
+    return new RegExp(`(^|/)${pattern}$`);
+}
@@ -0,0 +1,267 @@
+import { Joinpoint } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { MISRAError, SourceLocation } from "./MISRA.js";
+import { getFilepath } from "./utils/JoinpointUtils.js";
+
+/**
+ * Fields of each record, stored consecutively
+ */
+enum Field {
+    RULE,
+    MESSAGE,
+    NODE,
+    FILE,
+    LINE,
+    COLUMN,
+    HAS_LOCATION,
+    DEVIATION
+}
+
+const RECORD_SIZE = Field.DEVIATION + 1;
+
+/**
+ * Table of distinct strings, each stored once and referenced by its index
+ */
+class StringTable {
+    #indices = new Map<string, number>();
+    #values: string[] = [];
+
+    /**
+     * @param value The string
+     * @returns The index of the string, added to the table if it is new
+     */
+    intern(value: string): number {
+        let index = this.#indices.get(value);
+        if (index === undefined) {
+            index = this.#values.length;
+            this.#values.push(value);
+            this.#indices.set(value, index);
+        }
+        return index;
+    }
+
+    get(index: number): string {
+        return this.#values[index];
+    }
+
+    /**
+     * Number of distinct strings
+     */
+    get size(): number {
+        return this.#values.length;
+    }
+}
+
+/**
+ * Stores the violations as compact records of integers: the interned rule, message, node identifier and file,
+ * the line, the column and the interned deviation that suppressed the violation, if any.
+ * Records do not reference joinpoints, so that the errors of removed nodes do not keep them alive,
+ * and repeated messages and file paths are stored once.
+ * {@link MISRAError} views are created only when the errors are read.
+ *
+ * The joinpoints of the errors are found in an index of the nodes of the AST by identifier, built once per version of the AST.
+ */
+export default class MISRAErrorStore {
+    #rules = new StringTable();
+    #messages = new StringTable();
+    #nodes = new StringTable();
+    #files = new StringTable();
+    #deviations = new StringTable();
+
+    /**
+     * Returns the version of the AST, which changes whenever a transformation is applied
+     */
+    #getVersion: () => number;
+
+    /**
+     * Nodes of the AST indexed by identifier, and the version of the AST they were collected from
+     */
+    #astNodes: { version: number, nodes: Map<string, Joinpoint> } | undefined = undefined;
+
+    #records = new Int32Array(RECORD_SIZE * 64);
+    #count = 0;
+
+    /**
+     * Keys of the stored records, used to avoid duplicates
+     */
+    #keys = new Set<string>();
+
+    /**
+     * @param getVersion Returns the version of the AST, which changes whenever a transformation is applied
+     */
+    constructor(getVersion: () => number = () => 0) {
+        this.#getVersion = getVersion;
+    }
+
+    /**
+     * Number of stored errors
+     */
+    get size(): number {
+        return this.#count;
+    }
+
+    /**
+     * Number of distinct strings referenced by the stored errors
+     */
+    get stringCount(): number {
+        return this.#rules.size + this.#messages.size + this.#nodes.size + this.#files.size + this.#deviations.size;
+    }
+
+    /**
+     * Stores a violation, unless an equal violation was already stored
+     *
+     * @param ruleID Identifier of the violated rule
+     * @param $jp Joinpoint where the error was detected
+     * @param message Description of the error
+     * @param location Position of the violation in the file, if more precise than the joinpoint
+     * @param deviationId Identifier of the approved deviation that suppressed the violation, if any
+     */
+    add(ruleID: string, $jp: Joinpoint, message: string, location?: SourceLocation, deviationId?: string) {
+        const rule = this.#rules.intern(ruleID), node = this.#nodes.intern($jp.astId), messageIndex = this.#messages.intern(message);
+        const key = location ? `${rule},${node},${messageIndex}@${location.line}:${location.column}` : `${rule},${node},${messageIndex}`;
+        if (this.#keys.has(key)) {
+            return;
+        }
+        this.#keys.add(key);
+
+        const position = location ?? $jp;
+        const line = position.line ?? 0;
+        const deviation = deviationId !== undefined ? this.#deviations.intern(deviationId) : -1;
+        this.push([rule, messageIndex, node, this.#files.intern(getFilepath($jp)), line, line > 0 ? position.column ?? 0 : 0, location ? 1 : 0, deviation]);
+    }
+
+    /**
+     * @returns All stored errors
+     */
+    getErrors(): MISRAError[] {
+        return Array.from({ length: this.#count }, (_, index) => this.getError(index));
+    }
+
+    /**
+     * Returns the errors whose joinpoints are still present in the AST.
+     * The nodes of the AST are indexed once, instead of searching the joinpoint of each error.
+     *
+     * @param isEdited Checks if a file was changed after its errors were detected, in which case they refer to the whole file
+     */
+    getActiveErrors(isEdited: (filepath: string) => boolean = () => false): MISRAError[] {
+        const astNodes = this.getAstNodes();
+        const errors: MISRAError[] = [];
+        for (let index = 0; index < this.#count; index++) {
+            if (astNodes.has(this.#nodes.get(this.#records[index * RECORD_SIZE + Field.NODE]))) {
+                const error = this.getError(index);
+                errors.push(isEdited(error.filepath) ? error.withoutPosition() : error);
+            }
+        }
+        return errors;
+    }
+
+    /**
+     * Returns the joinpoint of the given node, if it is still present in the AST
+     *
+     * @param nodeId Identifier of the node
+     */
+    findNode(nodeId: string): Joinpoint | undefined {
+        return this.getAstNodes().get(nodeId);
+    }
+
+    /**
+     * Discards the errors detected on the given nodes (e.g., the nodes of rebuilt files),
+     * together with the strings only referenced by them
+     *
+     * @param nodeIds Identifiers of the nodes
+     */
+    removeNodes(nodeIds: Set<string>) {
+        const records = this.#records;
+        let count = 0;
+        for (let index = 0; index < this.#count; index++) {
+            const offset = index * RECORD_SIZE;
+            if (!nodeIds.has(this.#nodes.get(records[offset + Field.NODE]))) {
+                records.copyWithin(count * RECORD_SIZE, offset, offset + RECORD_SIZE);
+                count++;
+            }
+        }
+        this.#count = count;
+        this.compactStrings();
+        this.#keys = new Set(Array.from({ length: count }, (_, index) => this.getKey(index)));
+        this.#astNodes = undefined;
+    }
+
+    /**
+     * Discards all errors and their strings
+     */
+    clear() {
+        this.#count = 0;
+        this.#keys = new Set<string>();
+        this.#rules = new StringTable();
+        this.#messages = new StringTable();
+        this.#nodes = new StringTable();
+        this.#files = new StringTable();
+        this.#deviations = new StringTable();
+        this.#astNodes = undefined;
+    }
+
+    /**
+     * Returns the nodes of the AST indexed by identifier, indexing them again if the AST changed
+     */
+    private getAstNodes(): Map<string, Joinpoint> {
+        const version = this.#getVersion();
+        if (this.#astNodes === undefined || this.#astNodes.version !== version) {
+            const root = Query.root() as Joinpoint;
+            this.#astNodes = { version, nodes: new Map([root, ...root.descendants].map($jp => [$jp.astId, $jp])) };
+        }
+        return this.#astNodes.nodes;
+    }
+
+    /**
+     * Interns the strings of the remaining records in new tables, so that the strings of discarded records are released
+     */
+    private compactStrings() {
+        const rules = new StringTable(), messages = new StringTable(), nodes = new StringTable(), files = new StringTable(), deviations = new StringTable();
+        const records = this.#records;
+        for (let offset = 0; offset < this.#count * RECORD_SIZE; offset += RECORD_SIZE) {
+            records[offset + Field.RULE] = rules.intern(this.#rules.get(records[offset + Field.RULE]));
+            records[offset + Field.MESSAGE] = messages.intern(this.#messages.get(records[offset + Field.MESSAGE]));
+            records[offset + Field.NODE] = nodes.intern(this.#nodes.get(records[offset + Field.NODE]));
+            records[offset + Field.FILE] = files.intern(this.#files.get(records[offset + Field.FILE]));
+            if (records[offset + Field.DEVIATION] >= 0) {
+                records[offset + Field.DEVIATION] = deviations.intern(this.#deviations.get(records[offset + Field.DEVIATION]));
+            }
+        }
+        this.#rules = rules;
+        this.#messages = messages;
+        this.#nodes = nodes;
+        this.#files = files;
+        this.#deviations = deviations;
+    }
+
+    private push(fields: number[]) {
+        if ((this.#count + 1) * RECORD_SIZE > this.#records.length) {
+            const records = new Int32Array(this.#records.length * 2);
+            records.set(this.#records);
+            this.#records = records;
+        }
+        this.#records.set(fields, this.#count * RECORD_SIZE);
+        this.#count++;
+    }
+
+    private getError(index: number): MISRAError {
+        const record = this.#records.subarray(index * RECORD_SIZE, (index + 1) * RECORD_SIZE);
+        return new MISRAError(
+            this.#rules.get(record[Field.RULE]),
+            this.#nodes.get(record[Field.NODE]),
+            this.#messages.get(record[Field.MESSAGE]),
+            this.#files.get(record[Field.FILE]),
+            record[Field.LINE],
+            record[Field.COLUMN],
+            record[Field.HAS_LOCATION] === 1,
+            nodeId => this.findNode(nodeId),
+            record[Field.DEVIATION] >= 0 ? this.#deviations.get(record[Field.DEVIATION]) : undefined
+        );
+    }
+
+    private getKey(index: number): string {
+        const record = this.#records.subarray(index * RECORD_SIZE, (index + 1) * RECORD_SIZE);
+        const key = `${record[Field.RULE]},${record[Field.NODE]},${record[Field.MESSAGE]}`;
+        return record[Field.HAS_LOCATION] === 1 ? `${key}@${record[Field.LINE]}:${record[Field.COLUMN]}` : key;
+    }
+}
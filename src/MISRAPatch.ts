@@ -0,0 +1,144 @@
+import { FileJp, Program } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { createHash } from "crypto";
+import * as fs from 'fs';
+import path from "path";
+import { createUnifiedDiff } from "./utils/DiffUtils.js";
+
+/**
+ * A file whose code changed during correction
+ */
+export interface ModifiedFile {
+    /**
+     * Path of the file, relative to the source folder of the program
+     */
+    relativePath: string;
+    /**
+     * The file after correction
+     */
+    fileJp: FileJp;
+    /**
+     * Whether the file was created during correction (e.g., a generated replacement of a library function)
+     */
+    isNew: boolean;
+}
+
+/**
+ * Tracks the files changed by the correction, so that only those files are written and their changes can be reviewed as a unified diff.
+ *
+ * Files are identified by their path relative to the source folder, which is kept when files are rebuilt.
+ * A file is modified if its generated code differs from the code generated before the correction, so that changes made
+ * by any rule to any file (including changes to other files than the one being visited) are found, while formatting
+ * differences between the original text and the generated code do not mark untouched files as modified.
+ */
+export default class MISRAPatch {
+    /**
+     * Hash of the generated code of each file before the correction, indexed by relative path
+     */
+    #baseline = new Map<string, string>();
+
+    /**
+     * Original text of the files overwritten by {@link writeFiles}, indexed by relative path, so that they can still be diffed
+     */
+    #overwrittenTexts = new Map<string, string>();
+
+    /**
+     * Records the code of every file before the correction
+     *
+     * @param programJp The program
+     */
+    captureBaseline(programJp: Program = Query.root() as Program) {
+        this.#baseline.clear();
+        for (const fileJp of Query.searchFrom(programJp, FileJp).get()) {
+            this.#baseline.set(getRelativePath(fileJp), hashCode(fileJp.code));
+        }
+    }
+
+    /**
+     * Returns the files whose code changed since the baseline was captured, ordered by path
+     *
+     * @param programJp The program
+     */
+    getModifiedFiles(programJp: Program = Query.root() as Program): ModifiedFile[] {
+        return Query.searchFrom(programJp, FileJp).get()
+            .map(fileJp => ({ fileJp, relativePath: getRelativePath(fileJp) }))
+            .filter(({ fileJp, relativePath }) => this.#baseline.get(relativePath) !== hashCode(fileJp.code))
+            .map(({ fileJp, relativePath }) => ({ fileJp, relativePath, isNew: !this.#baseline.has(relativePath) }))
+            .sort((a, b) => a.relativePath.localeCompare(b.relativePath));
+    }
+
+    /**
+     * Writes the modified files, either over the original files or into the given folder, keeping their relative paths
+     *
+     * @param files The modified files
+     * @param outputFolder The folder where files are written, or undefined to overwrite the original files
+     * @returns The paths of the written files
+     */
+    writeFiles(files: ModifiedFile[], outputFolder?: string): string[] {
+        const sourceFolder = outputFolder ?? getSourceFolder();
+        return files.map(file => {
+            const targetPath = outputFolder === undefined && !file.isNew ? file.fileJp.filepath : path.join(sourceFolder, file.relativePath);
+            if (!file.isNew && targetPath === file.fileJp.filepath && !this.#overwrittenTexts.has(file.relativePath)) {
+                this.#overwrittenTexts.set(file.relativePath, readOriginalText(file));
+            }
+            fs.mkdirSync(path.dirname(targetPath), { recursive: true });
+            fs.writeFileSync(targetPath, file.fileJp.code, 'utf-8');
+            return targetPath;
+        });
+    }
+
+    /**
+     * Writes a unified diff of the modified files, from their original text to their corrected code.
+     * The original text of the files already overwritten by {@link writeFiles} is the text they had before being written.
+     * The diff can be applied to the source folder with 'patch -p1'.
+     *
+     * @param files The modified files
+     * @param patchPath Path of the diff file
+     */
+    writeDiff(files: ModifiedFile[], patchPath: string) {
+        const fd = fs.openSync(patchPath, "w");
+        try {
+            for (const file of files) {
+                const originalText = this.#overwrittenTexts.get(file.relativePath) ?? readOriginalText(file);
+                const relativePath = file.relativePath.split(path.sep).join("/");
+                fs.writeSync(fd, createUnifiedDiff(file.isNew ? undefined : relativePath, relativePath, originalText, file.fileJp.code));
+            }
+        } finally {
+            fs.closeSync(fd);
+        }
+    }
+}
+
+/**
+ * @param fileJp The file
+ * @returns The path of the file relative to the source folder of the program
+ */
+function getRelativePath(fileJp: FileJp): string {
+    return path.join(fileJp.relativeFolderpath ?? "", fileJp.name);
+}
+
+/**
+ * @param file The modified file
+ * @returns The text of the file on disk, or an empty text if it was created during correction or does not exist on disk
+ */
+function readOriginalText(file: ModifiedFile): string {
+    return !file.isNew && fs.existsSync(file.fileJp.filepath) ? fs.readFileSync(file.fileJp.filepath, 'utf-8') : "";
+}
+
+/**
+ * Returns the source folder of the program, obtained by removing the relative path from the path of a file that exists in it,
+ * or the current folder if there is no such file
+ */
+function getSourceFolder(): string {
+    for (const fileJp of Query.search(FileJp).get()) {
+        const filepath = path.normalize(fileJp.filepath), relativePath = path.normalize(getRelativePath(fileJp));
+        if (fs.existsSync(filepath) && filepath.endsWith(relativePath)) {
+            return filepath.slice(0, filepath.length - relativePath.length) || ".";
+        }
+    }
+    return ".";
+}
+
+function hashCode(code: string): string {
+    return createHash("sha1").update(code).digest("hex");
+}
@@ -0,0 +1,305 @@
+import * as fs from 'fs';
+import path from "path";
+import { pathToFileURL } from "url";
+import { MISRAError } from "./MISRA.js";
+import { Deviation } from "./MISRADeviations.js";
+
+/**
+ * Formats in which the violations can be reported
+ */
+export enum ReportFormat {
+    CONSOLE = "console",
+    JSON_LINES = "jsonl",
+    SARIF = "sarif"
+}
+
+/**
+ * Categories of the MISRA C:2012 guidelines
+ */
+export enum RuleCategory {
+    MANDATORY = "mandatory",
+    REQUIRED = "required",
+    ADVISORY = "advisory"
+}
+
+/**
+ * Implemented rules of the mandatory and advisory categories. Every other rule is required.
+ */
+const MANDATORY_RULES = new Set(["13.6", "17.3", "17.4", "17.6"]);
+const ADVISORY_RULES = new Set(["2.3", "2.4", "2.6", "2.7", "2.8", "5.9", "8.7", "8.9", "10.5", "15.4"]);
+
+/**
+ * @param ruleID Identifier of the rule
+ * @returns The category of the rule according to MISRA C:2012
+ */
+export function getRuleCategory(ruleID: string): RuleCategory {
+    if (MANDATORY_RULES.has(ruleID)) {
+        return RuleCategory.MANDATORY;
+    }
+    return ADVISORY_RULES.has(ruleID) ? RuleCategory.ADVISORY : RuleCategory.REQUIRED;
+}
+
+/**
+ * A violation suppressed by an approved deviation
+ */
+export interface SuppressedError {
+    error: MISRAError;
+    deviation: Deviation;
+}
+
+/**
+ * Writes the violations of a report, one at a time, in a given format
+ */
+export interface ReportFormatter {
+    /**
+     * Starts the report
+     *
+     * @param errors All violations of the report, including the suppressed ones, in the order they are written
+     */
+    begin(errors: MISRAError[]): void;
+
+    /**
+     * Writes a violation
+     *
+     * @param error The violation
+     */
+    write(error: MISRAError): void;
+
+    /**
+     * Writes a violation suppressed by an approved deviation, after all other violations
+     *
+     * @param suppressed The violation and its deviation
+     */
+    writeSuppressed(suppressed: SuppressedError): void;
+
+    /**
+     * Finishes the report, releasing its output
+     */
+    end(): void;
+}
+
+/**
+ * Orders errors by file, line and column, in place.
+ * The files are ranked once, so that each comparison only compares numbers.
+ * Errors without position (e.g., on an include) come first in their file.
+ *
+ * @param errors The errors to sort
+ */
+export function sortErrorsByLocation(errors: MISRAError[]) {
+    const filepaths = Array.from(new Set(errors.map(error => error.filepath))).sort((a, b) => a.localeCompare(b));
+    const fileRanks = new Map(filepaths.map((filepath, index) => [filepath, index]));
+
+    const keyed = errors.map(error => ({ error, file: fileRanks.get(error.filepath)!, line: error.line, column: error.column }));
+    keyed.sort((a, b) => a.file - b.file || a.line - b.line || a.column - b.column);
+    keyed.forEach((entry, index) => errors[index] = entry.error);
+}
+
+/**
+ * Writes each violation to the console, in a human-readable format.
+ * Suppressed violations are not written, since the applied deviations are listed after the report.
+ */
+export class ConsoleFormatter implements ReportFormatter {
+    begin(errors: MISRAError[]) {}
+
+    write(error: MISRAError) {
+        console.log(`- [Rule ${error.ruleID}] at ${error.fileLocation}: ${error.message}\n`);
+    }
+
+    writeSuppressed(suppressed: SuppressedError) {}
+
+    end() {}
+}
+
+/**
+ * Base class of the formatters that stream the report to a file, flushing the written text in chunks
+ */
+abstract class FileFormatter implements ReportFormatter {
+    static readonly #CHUNK_SIZE = 1 << 16;
+
+    #filePath: string;
+    #fd: number | undefined = undefined;
+    #chunks: string[] = [];
+    #chunkLength = 0;
+
+    /**
+     * @param filePath Path of the report file, which is overwritten
+     */
+    constructor(filePath: string) {
+        this.#filePath = filePath;
+    }
+
+    begin(errors: MISRAError[]) {
+        this.#fd = fs.openSync(this.#filePath, "w");
+    }
+
+    abstract write(error: MISRAError): void;
+
+    abstract writeSuppressed(suppressed: SuppressedError): void;
+
+    end() {
+        this.flush();
+        if (this.#fd !== undefined) {
+            fs.closeSync(this.#fd);
+            this.#fd = undefined;
+        }
+    }
+
+    /**
+     * Appends text to the report, flushing it to the file once enough text is pending
+     *
+     * @param text The text to append
+     */
+    protected append(text: string) {
+        this.#chunks.push(text);
+        this.#chunkLength += text.length;
+        if (this.#chunkLength >= FileFormatter.#CHUNK_SIZE) {
+            this.flush();
+        }
+    }
+
+    private flush() {
+        if (this.#fd !== undefined && this.#chunks.length > 0) {
+            fs.writeSync(this.#fd, this.#chunks.join(""));
+        }
+        this.#chunks = [];
+        this.#chunkLength = 0;
+    }
+}
+
+/**
+ * Writes each violation as a JSON object in its own line, with its rule, file, line, column and message.
+ * Suppressed violations also have the identifier and the reason of their deviation.
+ */
+export class JsonLinesFormatter extends FileFormatter {
+    write(error: MISRAError) {
+        this.append(JSON.stringify(this.toRecord(error)) + "\n");
+    }
+
+    writeSuppressed({ error, deviation }: SuppressedError) {
+        this.append(JSON.stringify({ ...this.toRecord(error), deviation: deviation.id, reason: deviation.reason }) + "\n");
+    }
+
+    private toRecord(error: MISRAError): Record<string, any> {
+        return {
+            rule: error.ruleID,
+            file: error.filepath,
+            line: error.line,
+            column: error.column,
+            message: error.message
+        };
+    }
+}
+
+/**
+ * Writes the violations as a SARIF 2.1.0 log with a single run, with a result per violation.
+ * Files are referenced by absolute 'file://' URIs. Violations of advisory rules are warnings, and those of mandatory and required rules are errors.
+ * Violations without position (e.g., those in files modified by the correction) have no region.
+ * Suppressed violations are results with a suppression: 'inSource' for the deviations annotated in the code and 'external'
+ * for those of the configuration, justified by the reason of the deviation.
+ */
+export class SarifFormatter extends FileFormatter {
+    #isFirst = true;
+
+    begin(errors: MISRAError[]) {
+        super.begin(errors);
+        const ruleIDs = Array.from(new Set(errors.map(error => error.ruleID))).sort(compareRuleIDs);
+        const driver = {
+            name: "Clava-MISRATool",
+            rules: ruleIDs.map(ruleID => ({
+                id: ruleID,
+                name: `MISRA C:2012 Rule ${ruleID}`,
+                defaultConfiguration: { level: getSarifLevel(ruleID) },
+                properties: { category: getRuleCategory(ruleID) }
+            }))
+        };
+
+        this.append(`{"$schema":"https://json.schemastore.org/sarif-2.1.0.json","version":"2.1.0","runs":[{"tool":{"driver":${JSON.stringify(driver)}},"results":[`);
+        this.#isFirst = true;
+    }
+
+    write(error: MISRAError) {
+        this.appendResult(this.toResult(error));
+    }
+
+    writeSuppressed({ error, deviation }: SuppressedError) {
+        const suppression: Record<string, any> = { kind: deviation.inSource ? "inSource" : "external", status: "accepted" };
+        if (deviation.reason !== undefined) {
+            suppression.justification = deviation.reason;
+        }
+        this.appendResult({ ...this.toResult(error), suppressions: [suppression], properties: { deviation: deviation.id } });
+    }
+
+    private toResult(error: MISRAError): Record<string, any> {
+        const physicalLocation: Record<string, any> = { artifactLocation: { uri: pathToFileURL(path.resolve(error.filepath)).href } };
+        if (error.line > 0) {
+            physicalLocation.region = { startLine: error.line, startColumn: Math.max(error.column, 1) };
+        }
+
+        return {
+            ruleId: error.ruleID,
+            level: getSarifLevel(error.ruleID),
+            message: { text: error.message },
+            locations: [{ physicalLocation }]
+        };
+    }
+
+    private appendResult(result: Record<string, any>) {
+        this.append((this.#isFirst ? "\n" : ",\n") + JSON.stringify(result));
+        this.#isFirst = false;
+    }
+
+    end() {
+        this.append("\n]}]}\n");
+        super.end();
+    }
+}
+
+/**
+ * @param ruleID Identifier of the rule
+ * @returns The SARIF level of the violations of the rule
+ */
+function getSarifLevel(ruleID: string): string {
+    return getRuleCategory(ruleID) === RuleCategory.ADVISORY ? "warning" : "error";
+}
+
+/**
+ * Creates the formatter of the given format
+ *
+ * @param format The report format
+ * @param filePath Path of the report file, for the formats written to a file
+ */
+export function createReportFormatter(format: ReportFormat, filePath: string): ReportFormatter {
+    switch (format) {
+        case ReportFormat.JSON_LINES:
+            return new JsonLinesFormatter(filePath);
+        case ReportFormat.SARIF:
+            return new SarifFormatter(filePath);
+        default:
+            return new ConsoleFormatter();
+    }
+}
+
+/**
+ * Writes the errors with the given formatter, followed by the suppressed errors
+ *
+ * @param errors The errors, already sorted
+ * @param formatter The formatter of the report
+ * @param suppressed The errors suppressed by approved deviations, already sorted
+ */
+export function writeReport(errors: MISRAError[], formatter: ReportFormatter, suppressed: SuppressedError[] = []) {
+    formatter.begin(suppressed.length > 0 ? [...errors, ...suppressed.map(({ error }) => error)] : errors);
+    try {
+        errors.forEach(error => formatter.write(error));
+        suppressed.forEach(suppressedError => formatter.writeSuppressed(suppressedError));
+    } finally {
+        formatter.end();
+    }
+}
+
+/**
+ * Orders rule identifiers numerically by section and rule (e.g., 2.1 < 10.1)
+ */
+function compareRuleIDs(ruleID1: string, ruleID2: string): number {
+    const [section1, rule1] = ruleID1.split(".").map(Number), [section2, rule2] = ruleID2.split(".").map(Number);
+    return section1 !== section2 ? section1 - section2 : rule1 - rule2;
+}
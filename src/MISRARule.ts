@@ -1,11 +1,12 @@
-import { Joinpoint, Program } from "@specs-feup/clava/api/Joinpoints.js";
+import { FileJp, Joinpoint, Program } from "@specs-feup/clava/api/Joinpoints.js";
 import MISRAContext from "./MISRAContext.js";
-import { AnalysisType, MISRATransformationReport, MISRATransformationResults } from "./MISRA.js";
+import { AnalysisType, MISRATransformationReport, MISRATransformationResults, SourceLocation } from "./MISRA.js";
 import { LaraJoinPoint } from "@specs-feup/lara/api/LaraJoinPoint.js";
 import Clava from "@specs-feup/clava/api/clava/Clava.js";
 import Query from "@specs-feup/lara/api/weaver/Query.js";
-import { resetCaches } from "./utils/ProgramUtils.js";
+import { refreshFileCaches, resetCaches } from "./utils/ProgramUtils.js";
 import StandardGuideline from "./StandardGuideline.js";
+import { replaceFileCode } from "./utils/FileUtils.js";
 
 /**
  * Represents a MISRA Rule that detects and corrects violations in the code according to MISRA standards.
@@ -65,9 +66,21 @@ export default abstract class MISRARule extends StandardGuideline<MISRATransform
      * 
      * @param $jp - The joinpoint where the violation occurred
      * @param msg - Description of the violation
+     * @param location - Position of the violation in the file, if more precise than the joinpoint
      */
-    protected logMISRAError($jp: Joinpoint, msg:string): void {
-        this.context.addMISRAError(this.ruleID, $jp, msg); 
+    protected logMISRAError($jp: Joinpoint, msg:string, location?: SourceLocation): void {
+        this.context.addMISRAError(this.ruleID, $jp, msg, location); 
+    }
+
+    /**
+     * Checks if an approved deviation of this rule covers the given node, in which case its violations are not corrected.
+     * Rules that correct the whole program at once use it to skip their suppressed candidates.
+     * 
+     * @param $jp - The node
+     * @param location - Position of the violation in the file, if more precise than the joinpoint
+     */
+    protected isDeviated($jp: Joinpoint, location?: SourceLocation): boolean {
+        return this.context.deviations.find(this.ruleID, $jp, location) !== undefined;
     }
 
     /**
@@ -86,6 +99,52 @@ export default abstract class MISRARule extends StandardGuideline<MISRATransform
         resetCaches();
     }
 
+    /**
+     * Rebuilds only the given files, clearing the data stored in the shared context and the cached identifiers that belong to them.
+     * Since headers affect every file that includes them, the whole program is rebuilt if any of the files is a header.
+     * 
+     * @param files The modified files
+     * @returns Returns true if only the given files were rebuilt, or false if the whole program was rebuilt
+     */
+    protected rebuildFiles(files: FileJp[]): boolean {
+        if (files.some(fileJp => fileJp.isHeader)) {
+            this.rebuildProgram();
+            return false;
+        }
+
+        const staleIds = new Set(files.flatMap(fileJp => [fileJp, ...fileJp.descendants].map(jp => jp.astId)));
+        const rebuiltFiles = files.map(fileJp => fileJp.rebuild());
+        this.context.resetNodeStorage(staleIds);
+        refreshFileCaches(staleIds, rebuiltFiles);
+        return true;
+    }
+
+    /**
+     * Replaces the code of a file by the given text and rebuilds it, clearing the data stored about its previous version.
+     * Since headers affect every file that includes them, the whole program is rebuilt if the file is a header.
+     * 
+     * @param fileJp The file to modify
+     * @param code The new code of the file
+     * @returns The rebuilt file (in the rebuilt program, if the file is a header), or undefined if the new code does not compile
+     */
+    protected rewriteFile(fileJp: FileJp, code: string): FileJp | undefined {
+        const staleIds = new Set([fileJp, ...fileJp.descendants].map(jp => jp.astId));
+        const rebuiltFile = replaceFileCode(fileJp, code);
+        if (rebuiltFile === undefined) {
+            return undefined;
+        }
+
+        if (rebuiltFile.isHeader) {
+            // Only the header is visited again, instead of the whole rebuilt program
+            const filepath = rebuiltFile.filepath;
+            this.rebuildProgram();
+            return (Query.root() as Program).children.find(jp => jp instanceof FileJp && jp.filepath === filepath) as FileJp | undefined;
+        }
+        this.context.resetNodeStorage(staleIds);
+        refreshFileCaches(staleIds, [rebuiltFile]);
+        return rebuiltFile;
+    }
+
     /**
      * Transforms the joinpoint to comply with the MISRA-C rule
      * 
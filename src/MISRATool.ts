@@ -2,11 +2,18 @@ import Query from "@specs-feup/lara/api/weaver/Query.js";
 import { FileJp, FunctionJp, Joinpoint, Program } from "@specs-feup/clava/api/Joinpoints.js";
 import MISRARule from "./MISRARule.js";
 import MISRAContext from "./MISRAContext.js";
-import { MISRATransformationType } from "./MISRA.js";
+import { AnalysisType, MISRATransformationType } from "./MISRA.js";
 import Clava from "@specs-feup/clava/api/clava/Clava.js";
 import { resetCaches } from "./utils/ProgramUtils.js";
 import { selectRules } from "./rules/index.js";
 import ClavaJoinPoints from "@specs-feup/clava/api/clava/ClavaJoinPoints.js";
+import { invalidateValidationContext, loadValidationCache, resetValidationCache, saveValidationCache } from "./utils/ValidationCache.js";
+import { invalidateFileReferences, resetHeaderUsageCache } from "./utils/HeaderUsageCache.js";
+import { createReportFormatter, ReportFormat } from "./MISRAReport.js";
+import MISRAPatch from "./MISRAPatch.js";
+import { ChangeImpact, getChangedPaths, getChangeImpact } from "./utils/ChangeImpactUtils.js";
+import * as fs from 'fs';
+import path from "path";
 
 enum ExecutionMode {
     CORRECTION,
@@ -18,6 +25,7 @@ export default class MISRATool {
     public static context: MISRAContext;
     static readonly #standards = new Set(["c90", "c99", "c11"]);
     static readonly #ruleTypes = new Set(["all", "single", "system"]);
+    static readonly #reportFormats = new Set<string>(Object.values(ReportFormat));
 
     /**
      * Checks whether the source code complies with MISRA C coding guidelines and reports all violations identified during the analysis
@@ -26,14 +34,60 @@ export default class MISRATool {
     public static checkCompliance(startingPoint: Program | FileJp = Query.root() as Program) {
         this.init();
 
-        const nodes = [startingPoint, ...startingPoint.descendants];
+        // In diff-aware mode, only the part of the program impacted by the changes is analyzed
+        const changeSpec = this.getArgValue("changed-since");
+        const impact = changeSpec && startingPoint instanceof Program ? this.getChangeImpact(changeSpec) : undefined;
+        if (impact) {
+            this.context.setAnalysisScope(impact);
+        }
+
+        const nodes = impact ? [startingPoint, ...impact.files.flatMap(fileJp => [fileJp, ...fileJp.descendants])] : [startingPoint, ...startingPoint.descendants];
+        this.matchRules(nodes, this.#misraRules);
+
+        const systemRules = this.#misraRules.filter(rule => rule.analysisType === AnalysisType.SYSTEM);
+        this.matchRules(impact?.sharedDecls ?? [], systemRules);
+        this.outputReport(ExecutionMode.DETECTION);
+    } 
+
+    /**
+     * Logs the violations of the given rules in the given nodes.
+     * The violations covered by approved deviations are recorded as suppressed by the context, so that the report can list them.
+     * 
+     * @param nodes The nodes to analyze
+     * @param rules The rules to check
+     */
+    private static matchRules(nodes: Joinpoint[], rules: MISRARule[]) {
         for (const node of nodes) {
-            for (const rule of this.#misraRules) {
+            for (const rule of rules) {
                 rule.match(node, true);
             }
         }
-        this.outputReport(ExecutionMode.DETECTION);
-    } 
+    }
+
+    /**
+     * Computes the files impacted by the changes since the given git revision, or listed in the given file.
+     * If the changed files cannot be obtained, logs an error and exits the process.
+     * 
+     * @param changeSpec A git revision or the path of a file that lists the changed files
+     * @returns The impacted part of the program
+     */
+    private static getChangeImpact(changeSpec: string): ChangeImpact {
+        const sourceFile = Query.search(FileJp).get().find(fileJp => fs.existsSync(fileJp.filepath));
+        const folder = sourceFile ? path.dirname(sourceFile.filepath) : process.cwd();
+
+        let changedPaths: Set<string>;
+        try {
+            changedPaths = getChangedPaths(changeSpec, folder);
+        } catch (error) {
+            console.error(`[Clava-MISRATool] Could not obtain the files changed since '${changeSpec}'.`);
+            process.exit(1);
+        }
+
+        const impact = getChangeImpact(changedPaths);
+        const fileCount = Query.search(FileJp).get().length;
+        console.log(`[Clava-MISRATool] Analyzing ${impact.files.length} of ${fileCount} files impacted by the changes since '${changeSpec}'.\n`);
+        return impact;
+    }
 
     /**
      * Transforms the source code to comply with the coding guidelines. 
@@ -42,17 +96,24 @@ export default class MISRATool {
     public static correctViolations() {
         this.init();
 
-        // Store config file in context, if provided
-        const configFilePath = this.getArgValue("config");
-        if (configFilePath) {
-            this.context.config = configFilePath;
+        // Load validation results of previous runs, if a cache file is provided
+        const validationCachePath = this.getArgValue("validationCache");
+        if (validationCachePath) {
+            loadValidationCache(validationCachePath);
         }
 
+        // Record the code of the files before correction, if only the modified files are written or diffed
+        const writeModified = this.getArgValue("writeModified");
+        const patchPath = this.getArgValue("patch");
+        const patch = writeModified || patchPath ? new MISRAPatch() : undefined;
+        patch?.captureBaseline();
+
         // Correct violations
         let iteration = 0;
         let modified = true;
         while (modified) {
             console.log(`[Clava-MISRATool] Iteration #${++iteration}: Applying MISRA-C transformations...`);
+            this.context.nextIteration();
             modified = this.transformAST(Query.root() as Program);
         }
 
@@ -64,6 +125,12 @@ export default class MISRATool {
             }
         })
 
+        if (validationCachePath) {
+            saveValidationCache(validationCachePath);
+        }
+        if (patch) {
+            this.outputModifiedFiles(patch, writeModified, patchPath);
+        }
         this.outputReport(ExecutionMode.CORRECTION);
     }
 
@@ -71,37 +138,83 @@ export default class MISRATool {
      * Recursively transforms the AST using a pre-order traversal
      * 
      * @param $jp  AST node from which to start the visit.
+     * @param functionJp The function that contains the node, if any
      * @returns Return true if any modification was made (removal, replacement or changes in descendants). Otherwise, returns false.
      */
-    private static transformAST($jp: Joinpoint): boolean {
+    private static transformAST($jp: Joinpoint, functionJp?: FunctionJp): boolean {
         let modified = false;
+        let fileJp = $jp instanceof FileJp ? $jp : $jp.getAncestor("file") as FileJp | undefined;
+        const deviations = this.context.deviations;
+        const position = deviations.isEmpty ? undefined : deviations.locate($jp, fileJp);
 
         for (const rule of this.#misraRules) {
+            if (deviations.findAt(rule.ruleID, position) !== undefined) { // Suppressed by an approved deviation, so no fix is attempted
+                rule.match($jp, true);
+                continue;
+            }
             const transformReport = rule.apply($jp);
 
             if (transformReport.type !== MISRATransformationType.NoChange) {
                 modified = true;
+                this.invalidateReferences(fileJp);
+                if (fileJp === undefined && transformReport.changedNodes !== undefined) { // Only the files of the changed nodes are affected
+                    new Set(transformReport.changedNodes.map(nodeJp => nodeJp.getAncestor("file") as FileJp | undefined))
+                        .forEach(changedFile => this.context.notifyFileChange(changedFile));
+                } else {
+                    this.context.notifyFileChange(fileJp);
+                }
+                if (transformReport.changedNodes !== undefined) {
+                    transformReport.changedNodes.forEach(nodeJp => this.context.notifyNodeChange(nodeJp));
+                } else {
+                    this.context.notifyChange($jp instanceof FunctionJp ? $jp : functionJp);
+                }
                 if (transformReport.type === MISRATransformationType.Removal)
                     return modified;
-                else if (transformReport.type === MISRATransformationType.Replacement)
+                else if (transformReport.type === MISRATransformationType.Replacement) {
                     $jp = transformReport.newNode as Joinpoint;
+                    if ($jp instanceof FileJp) { // A rewritten file has a new identifier
+                        fileJp = $jp;
+                    }
+                }
             }
         }
 
+        const enclosingFunction = $jp instanceof FunctionJp ? $jp : functionJp;
         for (const child of $jp.children) {
-            if (this.transformAST(child)) 
+            if (this.transformAST(child, enclosingFunction)) 
                 modified = true;
         }
         return modified;
     }
 
     /**
-     * Validates the C standard, creates a MISRA context, and initializes rules. 
+     * Discards the cached references and validation hashes of the file modified by a transformation, or of all files if the whole program may have changed
+     *
+     * @param fileJp The file that contains the transformed node, if any
+     */
+    private static invalidateReferences(fileJp: FileJp | undefined) {
+        if (fileJp === undefined) {
+            resetHeaderUsageCache();
+        } else {
+            invalidateFileReferences(fileJp);
+        }
+        invalidateValidationContext(fileJp);
+    }
+
+    /**
+     * Validates the C standard, creates a MISRA context, stores the config file in it, if provided, and initializes rules.
+     * The config file is also used in detection, since it may define the entry points of the program.
+     * Validation results of previous analyses in the same process are discarded; only the cache file, if provided, is reused.
      */
     private static init() {
         this.validateStdVersion();
         this.context = new MISRAContext();
+        const configFilePath = this.getArgValue("config");
+        if (configFilePath) {
+            this.context.config = configFilePath;
+        }
         resetCaches();
+        resetValidationCache();
         this.initRules();
     }
 
@@ -140,34 +253,88 @@ export default class MISRATool {
         return value;
     }
 
+    /**
+     * Writes the files modified by the correction and/or a unified diff of their changes
+     * 
+     * @param patch The tracker of modified files, with the code of the files before correction
+     * @param writeModified Folder where the modified files are written, or 'inplace' to overwrite the original files
+     * @param patchPath Path of the unified diff
+     */
+    private static outputModifiedFiles(patch: MISRAPatch, writeModified: string | undefined, patchPath: string | undefined) {
+        const modifiedFiles = patch.getModifiedFiles();
+        console.log(`[Clava-MISRATool] ${modifiedFiles.length} file${modifiedFiles.length === 1 ? " was" : "s were"} modified by the correction.\n`);
+
+        // The diff is written first, while the original files are still on disk
+        if (patchPath) {
+            patch.writeDiff(modifiedFiles, patchPath);
+            console.log(`[Clava-MISRATool] Diff written to ${patchPath}\n`);
+        }
+        if (writeModified) {
+            patch.writeFiles(modifiedFiles, writeModified === "inplace" ? undefined : writeModified)
+                .forEach(filePath => console.log(`[Clava-MISRATool] Written ${filePath}`));
+        }
+    }
+
     /**
      * Displays standard violations based on execution mode. 
      * - In detection mode, all violations are shown.
      * - In correction mode, only the remaining violations are displayed
      * 
+     * The violations are written in the format given by 'reportFormat' (console by default). Other formats are written
+     * to the file given by 'reportFile', or to 'misra_report.<format>' if it is not provided, replacing the report of a previous run.
+     * 
      * @param mode execution mode 
      */
     private static outputReport(mode: ExecutionMode) {
         const isDetection = mode === ExecutionMode.DETECTION;
         const errorCount = isDetection ? this.getErrorCount() : this.getActiveErrorCount();
+        const format = (this.getArgValue("reportFormat", this.#reportFormats) ?? ReportFormat.CONSOLE) as ReportFormat;
+        const reportFile = this.getArgValue("reportFile") ?? `misra_report.${format}`;
+        const isConsole = format === ReportFormat.CONSOLE;
 
         if (errorCount > 0) {
           console.log(isDetection
-            ? `[Clava-MISRATool] Detected ${errorCount} MISRA-C violation${errorCount === 1 ? "" : "s"}:\n`
-            : `[Clava-MISRATool] ${errorCount} MISRA-C violation${errorCount === 1 ? "" : "s"} remain${errorCount === 1 ? "s" : ""} after transformation:\n`
+            ? `[Clava-MISRATool] Detected ${errorCount} MISRA-C violation${errorCount === 1 ? "" : "s"}${isConsole ? ":" : "."}\n`
+            : `[Clava-MISRATool] ${errorCount} MISRA-C violation${errorCount === 1 ? "" : "s"} remain${errorCount === 1 ? "s" : ""} after transformation${isConsole ? ":" : "."}\n`
           );
-          isDetection ? this.context.outputAllErrors() : this.context.outputActiveErrors();
         } 
         else {
           console.log(isDetection ? "[Clava-MISRATool] No MISRA-C violations detected.\n" : "[Clava-MISRATool] All detected violations were corrected.\n");
         }
+
+        // Report files are written even if empty, so that their consumers can tell a clean run from a missing report
+        if (errorCount > 0 || !isConsole) {
+          const formatter = createReportFormatter(format, reportFile);
+          isDetection ? this.context.outputAllErrors(formatter) : this.context.outputActiveErrors(formatter);
+        }
+        if (!isConsole) {
+          console.log(`[Clava-MISRATool] Report written to ${reportFile}\n`);
+        }
+        this.outputDeviations();
+    }
+
+    /**
+     * Lists the approved deviations that suppressed the report or correction of some violations.
+     * The suppressed violations themselves are written to the report by its formatter.
+     */
+    private static outputDeviations() {
+        const deviations = this.context.deviations.appliedDeviations;
+        if (deviations.length === 0) {
+            return;
+        }
+
+        console.log(`[Clava-MISRATool] ${deviations.length} deviation${deviations.length === 1 ? " was" : "s were"} applied:\n`);
+        for (const deviation of deviations) {
+            const rules = deviation.rules ? `Rule${deviation.rules.size === 1 ? "" : "s"} ${[...deviation.rules].join(", ")}` : "All rules";
+            console.log(`- [Deviation ${deviation.id}] ${rules}${deviation.reason ? `: ${deviation.reason}` : ""}\n`);
+        }
     }
 
     /**
      * @returns Returns the number of identified violations.
      */
     public static getErrorCount(): number {
-        return this.context.errors.length;
+        return this.context.errorCount;
     }
 
     /**
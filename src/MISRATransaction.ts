@@ -0,0 +1,173 @@
+import { Call, FileJp, FunctionJp, Include, Joinpoint, NamedDecl, StorageClass, Vardecl } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+
+/**
+ * Records the AST edits of a fix attempt in an undo log, so that the attempt can be committed or rolled back at once.
+ *
+ * Edits must be performed through the transaction (or registered with {@link record}) to be undone.
+ * Rolling back restores the original nodes in reverse order, without rebuilding or copying the file.
+ */
+export default class MISRATransaction {
+    /**
+     * Operations that revert each recorded edit, in the order the edits were made
+     */
+    #undoLog: (() => void)[] = [];
+
+    /**
+     * Whether the transaction was already committed or rolled back
+     */
+    #closed = false;
+
+    /**
+     * @returns Returns true if the transaction was committed or rolled back
+     */
+    get isClosed(): boolean {
+        return this.#closed;
+    }
+
+    /**
+     * @returns Number of edits recorded in the transaction
+     */
+    get size(): number {
+        return this.#undoLog.length;
+    }
+
+    /**
+     * Registers an operation that reverts an edit made outside the transaction
+     *
+     * @param undo Operation that reverts the edit
+     */
+    record(undo: () => void) {
+        if (this.#closed) {
+            throw new Error("[Clava-MISRATool] Cannot record edits in a closed transaction.");
+        }
+        this.#undoLog.push(undo);
+    }
+
+    /**
+     * Inserts a node before the given node
+     *
+     * @returns The inserted node
+     */
+    insertBefore(anchorJp: Joinpoint, newJp: Joinpoint): Joinpoint {
+        const insertedJp = anchorJp.insertBefore(newJp);
+        this.record(() => insertedJp.detach());
+        return insertedJp;
+    }
+
+    /**
+     * Inserts a node after the given node
+     *
+     * @returns The inserted node
+     */
+    insertAfter(anchorJp: Joinpoint, newJp: Joinpoint): Joinpoint {
+        const insertedJp = anchorJp.insertAfter(newJp);
+        this.record(() => insertedJp.detach());
+        return insertedJp;
+    }
+
+    /**
+     * Inserts a node as the first child of the given node
+     *
+     * @returns The inserted node
+     */
+    setFirstChild(parentJp: Joinpoint, newJp: Joinpoint): Joinpoint {
+        const insertedJp = parentJp.setFirstChild(newJp);
+        this.record(() => insertedJp.detach());
+        return insertedJp;
+    }
+
+    /**
+     * Replaces a node, keeping the original one to restore it on rollback
+     *
+     * @returns The node that replaced the original one
+     */
+    replaceWith(oldJp: Joinpoint, newJp: Joinpoint): Joinpoint {
+        const replacementJp = oldJp.replaceWith(newJp);
+        this.record(() => replacementJp.replaceWith(oldJp));
+        return replacementJp;
+    }
+
+    /**
+     * Removes a node from the AST. On rollback, the node is reinserted next to its original siblings.
+     */
+    detach($jp: Joinpoint) {
+        const leftSibling = $jp.siblingsLeft.at(-1);
+        const rightSibling = $jp.siblingsRight.at(0);
+        const parentJp = $jp.parent;
+
+        $jp.detach();
+        this.record(() => {
+            if (leftSibling) {
+                leftSibling.insertAfter($jp);
+            } else if (rightSibling) {
+                rightSibling.insertBefore($jp);
+            } else {
+                parentJp.setFirstChild($jp);
+            }
+        });
+    }
+
+    /**
+     * Renames a call or a declaration
+     */
+    setName($jp: Call | NamedDecl, name: string) {
+        const previousName = $jp.name;
+        $jp.setName(name);
+        this.record(() => $jp.setName(previousName));
+    }
+
+    /**
+     * Changes the storage class of a function or variable
+     */
+    setStorageClass($jp: FunctionJp | Vardecl, storageClass: StorageClass) {
+        const previousStorageClass = $jp.storageClass;
+        $jp.setStorageClass(storageClass);
+        this.record(() => $jp.setStorageClass(previousStorageClass));
+    }
+
+    /**
+     * Adds an include directive to a file
+     *
+     * @param fileJp The file to modify
+     * @param includeName The name of the included file
+     * @param isAngled Whether the include uses angle brackets
+     */
+    addInclude(fileJp: FileJp, includeName: string, isAngled: boolean = false) {
+        fileJp.addInclude(includeName, isAngled);
+        this.record(() => Query.searchFrom(fileJp, Include, {name: includeName}).first()?.detach());
+    }
+
+    /**
+     * Keeps all recorded edits
+     */
+    commit() {
+        this.#undoLog = [];
+        this.#closed = true;
+    }
+
+    /**
+     * Reverts all recorded edits, in reverse order
+     */
+    rollback() {
+        while (this.#undoLog.length > 0) {
+            this.#undoLog.pop()!();
+        }
+        this.#closed = true;
+    }
+
+    /**
+     * Commits the transaction if the edits are valid, otherwise rolls it back
+     *
+     * @param isValid Validation of the edited AST, e.g., checking if the file compiles
+     * @returns Returns true if the transaction was committed, otherwise returns false
+     */
+    validate(isValid: () => boolean): boolean {
+        if (isValid()) {
+            this.commit();
+            return true;
+        }
+        this.rollback();
+        return false;
+    }
+}
@@ -0,0 +1,158 @@
+import { FileJp, Joinpoint } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRARule from "../MISRARule.js";
+import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../MISRA.js";
+import { applyTextEdits, TextEdit, Token, TokenKind } from "../utils/LexerUtils.js";
+import LexicalScanner from "./LexicalScanner.js";
+
+/**
+ * A violation found in the tokens of a file
+ */
+export interface LexicalViolation {
+    /**
+     * The token that violates the rule
+     */
+    token: Token;
+    /**
+     * Description of the violation
+     */
+    message: string;
+    /**
+     * Edit of the code that corrects the violation, if it can be corrected
+     */
+    edit?: TextEdit;
+}
+
+/**
+ * Abstract base class for MISRA-C rules that are checked on the text of the files (comments, literals and preprocessing directives),
+ * instead of the AST. The matchers of all lexical rules run in a single scan of the tokens of each file
+ * and their corrections are applied as text edits, followed by a single rebuild of the file.
+ *
+ * Need to implement/define:
+ *  - tokenKinds
+ *  - matchToken(tokens, index)
+ *  - name()
+ */
+export default abstract class LexicalRule extends MISRARule {
+    /**
+     * Scope of analysis
+     */
+    readonly analysisType = AnalysisType.SINGLE_TRANSLATION_UNIT;
+
+    /**
+     * Kinds of tokens analyzed by the rule
+     */
+    abstract readonly tokenKinds: TokenKind[];
+
+    /**
+     * Scanner of the files, shared with the linked rules
+     */
+    private scanner: LexicalScanner | undefined = undefined;
+
+    /**
+     * Rules that share the scan of the files and whose violations are corrected together
+     */
+    private linkedRules: LexicalRule[] = [this];
+
+    /**
+     * Checks if a token violates the rule
+     *
+     * @param tokens The tokens of the file
+     * @param index The index of the token to analyze, whose kind is one of {@link tokenKinds}
+     * @returns The violation, or undefined if the token complies with the rule
+     */
+    abstract matchToken(tokens: Token[], index: number): LexicalViolation | undefined;
+
+    /**
+     * Links the lexical rules among the given rules, so that they share a single scan of each file
+     *
+     * @param rules The selected rules
+     */
+    static linkRules(rules: MISRARule[]) {
+        const lexicalRules = rules.filter((rule): rule is LexicalRule => rule instanceof LexicalRule);
+        if (lexicalRules.length === 0) {
+            return;
+        }
+        const context = lexicalRules[0].context;
+        const scanner = new LexicalScanner(fileJp => context.getFileVersion(fileJp));
+
+        for (const rule of lexicalRules) {
+            scanner.register(rule);
+            rule.scanner = scanner;
+            rule.linkedRules = lexicalRules;
+        }
+    }
+
+    /**
+     * Returns the scanner of the files, creating one restricted to this rule if it was not linked with other rules
+     */
+    private getScanner(): LexicalScanner {
+        if (this.scanner === undefined) {
+            this.scanner = new LexicalScanner(fileJp => this.context.getFileVersion(fileJp));
+            this.scanner.register(this);
+        }
+        return this.scanner;
+    }
+
+    /**
+     * Checks if the code of the given file violates the rule
+     *
+     * @param $jp - Joinpoint to analyze
+     * @param logErrors - [logErrors=false] - Whether to log errors if a violation is detected
+     * @returns Returns true if the joinpoint violates the rule, false otherwise
+     */
+    match($jp: Joinpoint, logErrors: boolean = false): boolean {
+        if (!($jp instanceof FileJp && this.appliesToCurrentStandard())) return false;
+
+        const violations = this.getScanner().getViolations($jp, this.ruleID);
+        if (logErrors) {
+            violations.forEach(violation => this.logViolation($jp, violation));
+        }
+        return violations.length > 0;
+    }
+
+    /**
+     * Corrects the violations of this rule and of the rules linked with it, applying the edits of all rules to the code of the file.
+     * The edits are computed on the code generated from the AST, so that the changes made by other rules are kept.
+     * If the edited code does not compile, the file is kept and the violations are reported.
+     *
+     * @param $jp - Joinpoint to transform
+     * @returns Report detailing the transformation result
+     */
+    apply($jp: Joinpoint): MISRATransformationReport {
+        if (!($jp instanceof FileJp && this.match($jp))) {
+            return new MISRATransformationReport(MISRATransformationType.NoChange);
+        }
+
+        const scanner = this.getScanner();
+        if (this.context.getRuleResult(this.ruleID, $jp) !== MISRATransformationType.NoChange) {
+            const scan = scanner.getCodeScan($jp);
+            const edits = this.linkedRules
+                .filter(rule => rule.appliesToCurrentStandard())
+                .flatMap(rule => scan.violations.get(rule.ruleID) ?? [])
+                .flatMap(violation => violation.edit ? [violation.edit] : []);
+
+            if (edits.length > 0) {
+                const code = applyTextEdits(scan.code, edits);
+                const newJp = this.rewriteFile($jp, code);
+                if (newJp !== undefined) {
+                    if (!newJp.isHeader) { // Rebuilt headers are parsed from the code of the whole program instead
+                        scanner.recordSource(newJp, code);
+                    }
+                    return new MISRATransformationReport(MISRATransformationType.Replacement, newJp);
+                }
+            }
+            this.linkedRules.forEach(rule => this.context.addRuleResult(rule.ruleID, $jp, MISRATransformationType.NoChange));
+        }
+
+        // Report the violations that cannot be corrected, or whose edits were rejected
+        const failedEdits = this.context.getRuleResult(this.ruleID, $jp) === MISRATransformationType.NoChange;
+        scanner.getViolations($jp, this.ruleID)
+            .filter(violation => failedEdits || violation.edit === undefined)
+            .forEach(violation => this.logViolation($jp, violation));
+        return new MISRATransformationReport(MISRATransformationType.NoChange);
+    }
+
+    private logViolation(fileJp: FileJp, violation: LexicalViolation) {
+        this.logMISRAError(fileJp, violation.message, { line: violation.token.line, column: violation.token.column });
+    }
+}
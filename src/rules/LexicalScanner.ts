@@ -0,0 +1,190 @@
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import * as fs from 'fs';
+import { TokenKind, tokenize } from "../utils/LexerUtils.js";
+import LexicalRule, { LexicalViolation } from "./LexicalRule.js";
+
+/**
+ * Result of scanning the text of a file
+ */
+export interface LexicalScan {
+    /**
+     * The scanned text
+     */
+    code: string;
+    /**
+     * Version of the file when the text was scanned
+     */
+    version: number;
+    /**
+     * Violations found in the text, for each rule
+     */
+    violations: Map<string, LexicalViolation[]>;
+}
+
+/**
+ * Text a file was parsed from
+ */
+interface SourceText {
+    /**
+     * Version of the file when it was parsed
+     */
+    version: number;
+    /**
+     * The text, or undefined if it was not read from the file yet
+     */
+    text: string | undefined;
+}
+
+/**
+ * Token-level analysis of the files, shared by the lexical rules.
+ *
+ * Each version of a file is lexed once and every token is dispatched, according to its kind,
+ * to the matchers of the rules interested in it, producing the violations of all rules in a single linear scan.
+ *
+ * Violations are found in the text the positions of the file refer to: the original text of the files read from disk,
+ * or the text given to the files rewritten by the lexical rules, while they are not modified. Only when a file
+ * changes is its code generated from the AST, once per version.
+ */
+export default class LexicalScanner {
+    /**
+     * Rules interested in each kind of token
+     */
+    #dispatchTable = new Map<TokenKind, LexicalRule[]>();
+
+    /**
+     * Returns the version of a file, which changes whenever the file may have been modified
+     */
+    #getVersion: (fileJp: FileJp) => number;
+
+    /**
+     * Text each file was parsed from, indexed by the identifier of the file
+     */
+    #sources = new Map<string, SourceText>();
+
+    /**
+     * Last scan of the source text of each file, indexed by the identifier of the file
+     */
+    #scans = new Map<string, LexicalScan>();
+
+    /**
+     * Last scan of the generated code of each file, indexed by the identifier of the file
+     */
+    #codeScans = new Map<string, LexicalScan>();
+
+    /**
+     * @param getVersion Returns the version of a file, which changes whenever the file may have been modified
+     */
+    constructor(getVersion: (fileJp: FileJp) => number) {
+        this.#getVersion = getVersion;
+        for (const fileJp of Query.search(FileJp).get()) {
+            this.#sources.set(fileJp.astId, { version: getVersion(fileJp), text: undefined });
+        }
+    }
+
+    /**
+     * Registers the token matchers of a rule
+     *
+     * @param rule The lexical rule
+     */
+    register(rule: LexicalRule) {
+        for (const kind of rule.tokenKinds) {
+            const rules = this.#dispatchTable.get(kind) ?? [];
+            if (!rules.includes(rule)) {
+                rules.push(rule);
+            }
+            this.#dispatchTable.set(kind, rules);
+        }
+        this.#scans.clear();
+        this.#codeScans.clear();
+    }
+
+    /**
+     * Records the text a file was built from (e.g., the edited text of a rewritten file), so that it is scanned instead of generated code
+     *
+     * @param fileJp The built file
+     * @param text The text of the file
+     */
+    recordSource(fileJp: FileJp, text: string) {
+        this.#sources.set(fileJp.astId, { version: this.#getVersion(fileJp), text });
+    }
+
+    /**
+     * Returns the scan of the text the positions of the file refer to, scanning it if the file changed since the last scan.
+     * Once a file is modified, its generated code is scanned instead.
+     *
+     * @param fileJp The file to scan
+     */
+    getScan(fileJp: FileJp): LexicalScan {
+        const version = this.#getVersion(fileJp);
+        let scan = this.#scans.get(fileJp.astId);
+        if (scan !== undefined && scan.version === version) {
+            return scan;
+        }
+
+        const source = this.#sources.get(fileJp.astId);
+        if (source !== undefined && source.version === version) {
+            source.text ??= readSourceText(fileJp);
+            scan = { code: source.text, version, violations: this.scan(source.text) };
+        } else {
+            scan = this.getCodeScan(fileJp);
+        }
+        this.#scans.set(fileJp.astId, scan);
+        return scan;
+    }
+
+    /**
+     * Returns the scan of the code generated from the current AST of the file, which includes the changes made by other rules.
+     * The code is generated once per version of the file.
+     *
+     * @param fileJp The file to scan
+     */
+    getCodeScan(fileJp: FileJp): LexicalScan {
+        const version = this.#getVersion(fileJp);
+        let scan = this.#codeScans.get(fileJp.astId);
+        if (scan === undefined || scan.version !== version) {
+            const code = fileJp.code;
+            scan = { code, version, violations: this.scan(code) };
+            this.#codeScans.set(fileJp.astId, scan);
+        }
+        return scan;
+    }
+
+    /**
+     * Returns the violations of a rule in the text of the file
+     *
+     * @param fileJp The file to analyze
+     * @param ruleID Identifier of the rule
+     */
+    getViolations(fileJp: FileJp, ruleID: string): LexicalViolation[] {
+        return this.getScan(fileJp).violations.get(ruleID) ?? [];
+    }
+
+    private scan(code: string): Map<string, LexicalViolation[]> {
+        const violations = new Map<string, LexicalViolation[]>();
+        const tokens = tokenize(code);
+
+        tokens.forEach((token, index) => {
+            for (const rule of this.#dispatchTable.get(token.kind) ?? []) {
+                const violation = rule.matchToken(tokens, index);
+                if (violation === undefined) {
+                    continue;
+                }
+                let ruleViolations = violations.get(rule.ruleID);
+                if (ruleViolations === undefined) {
+                    ruleViolations = [];
+                    violations.set(rule.ruleID, ruleViolations);
+                }
+                ruleViolations.push(violation);
+            }
+        });
+        return violations;
+    }
+}
+
+/**
+ * Reads the original text of a file, or generates its code if the file does not exist on disk (e.g., files created by a script)
+ */
+function readSourceText(fileJp: FileJp): string {
+    return fs.existsSync(fileJp.filepath) ? fs.readFileSync(fileJp.filepath, 'utf-8') : fileJp.code;
+}
@@ -0,0 +1,106 @@
+import { BinaryOp, Expression, Joinpoint, TernaryOp, UnaryOp } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRARule from "../../MISRARule.js";
+import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
+import { EssentialTypeCategory } from "../../utils/EssentialTypeUtils.js";
+
+const { BOOLEAN, CHARACTER, SIGNED, UNSIGNED, ENUM, FLOATING } = EssentialTypeCategory;
+const NON_BOOLEAN = [CHARACTER, SIGNED, UNSIGNED, ENUM, FLOATING];
+const BITWISE = [BOOLEAN, CHARACTER, SIGNED, ENUM, FLOATING];
+
+/**
+ * Essential type categories that are inappropriate for the operands of each binary operator.
+ * Compound assignments are checked as their underlying operator.
+ */
+const BINARY_RESTRICTIONS: Record<string, EssentialTypeCategory[]> = {
+    add: [BOOLEAN, ENUM], sub: [BOOLEAN, ENUM],
+    mul: [BOOLEAN, CHARACTER, ENUM], div: [BOOLEAN, CHARACTER, ENUM],
+    rem: [BOOLEAN, CHARACTER, ENUM, FLOATING],
+    lt: [BOOLEAN], gt: [BOOLEAN], le: [BOOLEAN], ge: [BOOLEAN],
+    and: BITWISE, or: BITWISE, xor: BITWISE, shl: BITWISE, shr: BITWISE,
+    l_and: NON_BOOLEAN, l_or: NON_BOOLEAN
+};
+
+/**
+ * Essential type categories that are inappropriate for the operand of each unary operator
+ */
+const UNARY_RESTRICTIONS: Record<string, EssentialTypeCategory[]> = {
+    plus: [BOOLEAN, CHARACTER, ENUM],
+    minus: [BOOLEAN, CHARACTER, ENUM, UNSIGNED],
+    not: BITWISE,
+    l_not: NON_BOOLEAN
+};
+
+/**
+ * MISRA-C Rule 10.1: Operands shall not be of an inappropriate essential type
+ */
+export default class Rule_10_1_AppropriateOperandTypes extends MISRARule {
+    /**
+     * Scope of analysis
+     */
+    readonly analysisType = AnalysisType.SINGLE_TRANSLATION_UNIT;
+
+    /**
+     * @returns Rule identifier according to MISRA-C:2012
+     */
+    override get name(): string {
+        return "10.1";
+    }
+
+    /**
+     * Returns the operands of the given operation, with the essential type categories that are inappropriate for each one
+     */
+    private getRestrictedOperands($jp: Joinpoint): [Expression, EssentialTypeCategory[]][] {
+        if ($jp instanceof TernaryOp) {
+            return [[$jp.cond, NON_BOOLEAN]];
+        } else if ($jp instanceof UnaryOp) {
+            const restrictions = UNARY_RESTRICTIONS[$jp.kind];
+            return restrictions ? [[$jp.operand, restrictions]] : [];
+        } else if ($jp instanceof BinaryOp) {
+            const kind = $jp.kind.endsWith("_assign") ? $jp.kind.slice(0, -"_assign".length) : $jp.kind;
+            const restrictions = BINARY_RESTRICTIONS[kind];
+            if (!restrictions) {
+                return [];
+            }
+
+            // Exception: a non-negative integer constant expression of essentially signed type may be used as the right operand of a shift
+            const rightValue = this.context.essentialTypes.getConstantValue($jp.right);
+            const isShiftException = (kind === "shl" || kind === "shr") && rightValue !== undefined && rightValue >= 0n;
+            return isShiftException ?
+                [[$jp.left, restrictions], [$jp.right, restrictions.filter(category => category !== SIGNED)]] :
+                [[$jp.left, restrictions], [$jp.right, restrictions]];
+        }
+        return [];
+    }
+
+    /**
+     * Checks if the given joinpoint is an operation with an operand of an inappropriate essential type
+     * 
+     * @param $jp - Joinpoint to analyze
+     * @param logErrors - [logErrors=false] - Whether to log errors if a violation is detected
+     * @returns Returns true if the joinpoint violates the rule, false otherwise
+     */
+    match($jp: Joinpoint, logErrors: boolean = false): boolean {
+        const violations = this.getRestrictedOperands($jp)
+            .map(([operandJp, restrictions]) => ({ operandJp, category: this.context.essentialTypes.getEssentialType(operandJp).category, restrictions }))
+            .filter(operand => operand.restrictions.includes(operand.category));
+
+        if (logErrors) {
+            const operator = $jp instanceof TernaryOp ? "?:" : ($jp as UnaryOp | BinaryOp).operator;
+            violations.forEach(({ operandJp, category }) => {
+                this.logMISRAError(operandJp, `Operand '${operandJp.code}' of '${operator}' has an inappropriate essentially ${category} type.`);
+            });
+        }
+        return violations.length > 0;
+    }
+
+    /**
+     * Violations of this rule are reported but not corrected, since the appropriate operand depends on the intent of the expression
+     * 
+     * @param $jp - Joinpoint to transform
+     * @returns Report detailing the transformation result
+     */
+    apply($jp: Joinpoint): MISRATransformationReport {
+        this.match($jp, true);
+        return new MISRATransformationReport(MISRATransformationType.NoChange);
+    }
+}
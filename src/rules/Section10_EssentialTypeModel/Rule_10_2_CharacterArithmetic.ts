@@ -0,0 +1,72 @@
+import { BinaryOp, Joinpoint } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRARule from "../../MISRARule.js";
+import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
+import { EssentialTypeCategory, isIntegerCategory } from "../../utils/EssentialTypeUtils.js";
+
+/**
+ * MISRA-C Rule 10.2: Expressions of essentially character type shall not be used inappropriately in addition and subtraction operations
+ */
+export default class Rule_10_2_CharacterArithmetic extends MISRARule {
+    /**
+     * Scope of analysis
+     */
+    readonly analysisType = AnalysisType.SINGLE_TRANSLATION_UNIT;
+
+    /**
+     * @returns Rule identifier according to MISRA-C:2012
+     */
+    override get name(): string {
+        return "10.2";
+    }
+
+    /**
+     * Returns the description of the inappropriate use of a character operand, or undefined if the operation complies with the rule
+     */
+    private getViolation($jp: Joinpoint): string | undefined {
+        if (!($jp instanceof BinaryOp && /^(add|sub)(_assign)?$/.test($jp.kind))) return undefined;
+
+        const left = this.context.essentialTypes.getEssentialType($jp.left).category;
+        const right = this.context.essentialTypes.getEssentialType($jp.right).category;
+        const { CHARACTER, UNKNOWN } = EssentialTypeCategory;
+        if ((left !== CHARACTER && right !== CHARACTER) || left === UNKNOWN || right === UNKNOWN) return undefined;
+
+        if ($jp.kind.startsWith("add")) {
+            if (left === CHARACTER && right === CHARACTER) {
+                return `Both operands of the addition '${$jp.code}' have essentially character type.`;
+            } else if (!isIntegerCategory(left === CHARACTER ? right : left)) {
+                return `The addition '${$jp.code}' has an operand of essentially character type, so the other operand must be essentially signed or unsigned.`;
+            }
+        } else if (left !== CHARACTER) {
+            return `The right operand of the subtraction '${$jp.code}' can only have essentially character type if the left operand also has it.`;
+        } else if (right !== CHARACTER && !isIntegerCategory(right)) {
+            return `The left operand of the subtraction '${$jp.code}' has essentially character type, so the right operand must be essentially character, signed or unsigned.`;
+        }
+        return undefined;
+    }
+
+    /**
+     * Checks if the given joinpoint is an addition or subtraction that uses an operand of essentially character type inappropriately
+     * 
+     * @param $jp - Joinpoint to analyze
+     * @param logErrors - [logErrors=false] - Whether to log errors if a violation is detected
+     * @returns Returns true if the joinpoint violates the rule, false otherwise
+     */
+    match($jp: Joinpoint, logErrors: boolean = false): boolean {
+        const violation = this.getViolation($jp);
+        if (logErrors && violation !== undefined) {
+            this.logMISRAError($jp, violation);
+        }
+        return violation !== undefined;
+    }
+
+    /**
+     * Violations of this rule are reported but not corrected, since the intended operation cannot be inferred
+     * 
+     * @param $jp - Joinpoint to transform
+     * @returns Report detailing the transformation result
+     */
+    apply($jp: Joinpoint): MISRATransformationReport {
+        this.match($jp, true);
+        return new MISRATransformationReport(MISRATransformationType.NoChange);
+    }
+}
@@ -0,0 +1,73 @@
+import { Expression, Joinpoint } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRARule from "../../MISRARule.js";
+import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
+import { EssentialTypeCategory, getAssignedType, getEssentialTypeOfType } from "../../utils/EssentialTypeUtils.js";
+
+const { BOOLEAN, SIGNED, UNSIGNED, ENUM, UNKNOWN } = EssentialTypeCategory;
+
+/**
+ * MISRA-C Rule 10.3: The value of an expression shall not be assigned to an object with a narrower essential type or of a different essential type category
+ */
+export default class Rule_10_3_AssignmentTypeCategory extends MISRARule {
+    /**
+     * Scope of analysis
+     */
+    readonly analysisType = AnalysisType.SINGLE_TRANSLATION_UNIT;
+
+    /**
+     * @returns Rule identifier according to MISRA-C:2012
+     */
+    override get name(): string {
+        return "10.3";
+    }
+
+    /**
+     * Checks if the given joinpoint is a value assigned (including initializations, returns and arguments) to an object
+     * of a different essential type category or of a narrower essential type.
+     * Non-negative signed constants may be assigned to unsigned objects that can represent them, and the constants 0 and 1
+     * (to which 'false' and 'true' expand) to Boolean objects.
+     *
+     * @param $jp - Joinpoint to analyze
+     * @param logErrors - [logErrors=false] - Whether to log errors if a violation is detected
+     * @returns Returns true if the joinpoint violates the rule, false otherwise
+     */
+    match($jp: Joinpoint, logErrors: boolean = false): boolean {
+        if (!($jp instanceof Expression)) return false;
+
+        const assignedType = getAssignedType($jp);
+        if (assignedType === undefined) return false;
+
+        const targetType = getEssentialTypeOfType(assignedType);
+        const valueType = this.context.essentialTypes.getEssentialType($jp);
+        if (targetType.category === UNKNOWN || valueType.category === UNKNOWN) return false;
+
+        const value = this.context.essentialTypes.getConstantValue($jp);
+        if (value !== undefined && valueType.category === SIGNED && targetType.category === UNSIGNED &&
+            value >= 0n && (targetType.width === 0 || value < (1n << BigInt(targetType.width)))) {
+            return false;
+        } else if (targetType.category === BOOLEAN && (value === 0n || value === 1n)) {
+            return false;
+        }
+
+        const sameCategory = targetType.category === valueType.category && (targetType.category !== ENUM || targetType.enumName === valueType.enumName);
+        const narrower = sameCategory && targetType.width > 0 && valueType.width > targetType.width;
+
+        if (logErrors && !sameCategory) {
+            this.logMISRAError($jp, `Value '${$jp.code}' of essentially ${valueType.category} type must not be assigned to the essentially ${targetType.category} type '${assignedType.code}'.`);
+        } else if (logErrors && narrower) {
+            this.logMISRAError($jp, `Value '${$jp.code}' of ${valueType.width}-bit essential type must not be assigned to the narrower type '${assignedType.code}'.`);
+        }
+        return !sameCategory || narrower;
+    }
+
+    /**
+     * Violations of this rule are reported but not corrected, since an explicit cast would hide a possible loss of information
+     *
+     * @param $jp - Joinpoint to transform
+     * @returns Report detailing the transformation result
+     */
+    apply($jp: Joinpoint): MISRATransformationReport {
+        this.match($jp, true);
+        return new MISRATransformationReport(MISRATransformationType.NoChange);
+    }
+}
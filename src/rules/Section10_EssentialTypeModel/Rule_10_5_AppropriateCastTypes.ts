@@ -0,0 +1,74 @@
+import { Cast, Joinpoint } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRARule from "../../MISRARule.js";
+import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
+import { EssentialTypeCategory, getEssentialTypeOfType } from "../../utils/EssentialTypeUtils.js";
+
+const { BOOLEAN, CHARACTER, SIGNED, UNSIGNED, ENUM, FLOATING } = EssentialTypeCategory;
+
+/**
+ * Essential type categories that should not be cast to each category
+ */
+const INAPPROPRIATE_SOURCES: Record<string, EssentialTypeCategory[]> = {
+    [BOOLEAN]: [CHARACTER, SIGNED, UNSIGNED, ENUM, FLOATING],
+    [CHARACTER]: [BOOLEAN, FLOATING],
+    [SIGNED]: [BOOLEAN],
+    [UNSIGNED]: [BOOLEAN],
+    [ENUM]: [BOOLEAN, CHARACTER, SIGNED, UNSIGNED, ENUM, FLOATING],
+    [FLOATING]: [BOOLEAN, CHARACTER]
+};
+
+/**
+ * MISRA-C Rule 10.5: The value of an expression should not be cast to an inappropriate essential type
+ */
+export default class Rule_10_5_AppropriateCastTypes extends MISRARule {
+    /**
+     * Scope of analysis
+     */
+    readonly analysisType = AnalysisType.SINGLE_TRANSLATION_UNIT;
+
+    /**
+     * @returns Rule identifier according to MISRA-C:2012
+     */
+    override get name(): string {
+        return "10.5";
+    }
+
+    /**
+     * Checks if the given joinpoint is a cast of a value to an inappropriate essential type.
+     * The integer constants 0 and 1 may be cast to a Boolean type, and enumerations may be cast to their own type.
+     * 
+     * @param $jp - Joinpoint to analyze
+     * @param logErrors - [logErrors=false] - Whether to log errors if a violation is detected
+     * @returns Returns true if the joinpoint violates the rule, false otherwise
+     */
+    match($jp: Joinpoint, logErrors: boolean = false): boolean {
+        if (!($jp instanceof Cast)) return false;
+
+        const toType = getEssentialTypeOfType($jp.type);
+        const fromType = this.context.essentialTypes.getEssentialType($jp.subExpr);
+        const value = this.context.essentialTypes.getConstantValue($jp.subExpr);
+
+        let nonCompliant = INAPPROPRIATE_SOURCES[toType.category]?.includes(fromType.category) ?? false;
+        if (toType.category === BOOLEAN && (value === 0n || value === 1n)) {
+            nonCompliant = false;
+        } else if (toType.category === ENUM && fromType.category === ENUM && toType.enumName === fromType.enumName) {
+            nonCompliant = false;
+        }
+
+        if (logErrors && nonCompliant) {
+            this.logMISRAError($jp, `Value '${$jp.subExpr.code}' of essentially ${fromType.category} type should not be cast to the essentially ${toType.category} type '${$jp.type.code}'.`);
+        }
+        return nonCompliant;
+    }
+
+    /**
+     * Violations of this rule are reported but not corrected, since removing the cast would change the type of the expression
+     * 
+     * @param $jp - Joinpoint to transform
+     * @returns Report detailing the transformation result
+     */
+    apply($jp: Joinpoint): MISRATransformationReport {
+        this.match($jp, true);
+        return new MISRATransformationReport(MISRATransformationType.NoChange);
+    }
+}
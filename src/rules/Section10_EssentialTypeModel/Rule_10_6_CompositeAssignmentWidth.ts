@@ -0,0 +1,69 @@
+import { BinaryOp, Expression, Joinpoint } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRARule from "../../MISRARule.js";
+import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
+import { EssentialTypeCategory, castLeftmostOperand, getAssignedType, getEssentialTypeOfType, skipParentheses } from "../../utils/EssentialTypeUtils.js";
+
+/**
+ * MISRA-C Rule 10.6: The value of a composite expression shall not be assigned to an object with wider essential type
+ */
+export default class Rule_10_6_CompositeAssignmentWidth extends MISRARule {
+    /**
+     * Scope of analysis
+     */
+    readonly analysisType = AnalysisType.SINGLE_TRANSLATION_UNIT;
+
+    /**
+     * @returns Rule identifier according to MISRA-C:2012
+     */
+    override get name(): string {
+        return "10.6";
+    }
+
+    /**
+     * Checks if the given joinpoint is a composite expression assigned (including initializations, returns and arguments)
+     * to an object of the same essential type category with a wider essential type
+     * 
+     * @param $jp - Joinpoint to analyze
+     * @param logErrors - [logErrors=false] - Whether to log errors if a violation is detected
+     * @returns Returns true if the joinpoint violates the rule, false otherwise
+     */
+    match($jp: Joinpoint, logErrors: boolean = false): boolean {
+        if (!($jp instanceof Expression)) return false;
+
+        const assignedType = getAssignedType($jp);
+        if (assignedType === undefined || !this.context.essentialTypes.isComposite($jp)) return false;
+
+        const targetType = getEssentialTypeOfType(assignedType);
+        const compositeType = this.context.essentialTypes.getEssentialType($jp);
+        const nonCompliant = targetType.category !== EssentialTypeCategory.UNKNOWN &&
+            targetType.category === compositeType.category &&
+            targetType.width > compositeType.width;
+
+        if (logErrors && nonCompliant) {
+            this.logMISRAError($jp, `Composite expression '${$jp.code}' of ${compositeType.width}-bit essential type must not be assigned to the wider type '${assignedType.code}'.`);
+        }
+        return nonCompliant;
+    }
+
+    /**
+     * Casts the leftmost operand of the composite expression to the assigned type, so that the operation is performed in that type.
+     * Conditional expressions are reported instead.
+     * 
+     * @param $jp - Joinpoint to transform
+     * @returns Report detailing the transformation result
+     */
+    apply($jp: Joinpoint): MISRATransformationReport {
+        if (!this.match($jp)) {
+            return new MISRATransformationReport(MISRATransformationType.NoChange);
+        }
+
+        const compositeJp = skipParentheses($jp as Expression);
+        if (!(compositeJp instanceof BinaryOp)) {
+            this.logMISRAError($jp, `Composite expression '${$jp.code}' must not be assigned to a wider type. Could not correct because it is a conditional expression.`);
+            return new MISRATransformationReport(MISRATransformationType.NoChange);
+        }
+
+        castLeftmostOperand(compositeJp, getAssignedType($jp as Expression)!);
+        return new MISRATransformationReport(MISRATransformationType.DescendantChange);
+    }
+}
@@ -0,0 +1,78 @@
+import { BinaryOp, Cast, Joinpoint } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRARule from "../../MISRARule.js";
+import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
+import { EssentialTypeCategory, castLeftmostOperand, getEssentialTypeOfType, skipParentheses } from "../../utils/EssentialTypeUtils.js";
+
+/**
+ * MISRA-C Rule 10.8: The value of a composite expression shall not be cast to a different essential type category or a wider essential type
+ */
+export default class Rule_10_8_CompositeCastWidth extends MISRARule {
+    /**
+     * Scope of analysis
+     */
+    readonly analysisType = AnalysisType.SINGLE_TRANSLATION_UNIT;
+
+    /**
+     * @returns Rule identifier according to MISRA-C:2012
+     */
+    override get name(): string {
+        return "10.8";
+    }
+
+    /**
+     * Returns true if the cast only widens the composite expression, keeping its essential type category
+     */
+    private isWideningCast($jp: Cast): boolean {
+        const toType = getEssentialTypeOfType($jp.type);
+        const fromType = this.context.essentialTypes.getEssentialType($jp.subExpr);
+        return toType.category === fromType.category && toType.width > fromType.width;
+    }
+
+    /**
+     * Checks if the given joinpoint is a cast of a composite expression to a different essential type category or to a wider essential type
+     * 
+     * @param $jp - Joinpoint to analyze
+     * @param logErrors - [logErrors=false] - Whether to log errors if a violation is detected
+     * @returns Returns true if the joinpoint violates the rule, false otherwise
+     */
+    match($jp: Joinpoint, logErrors: boolean = false): boolean {
+        if (!($jp instanceof Cast && this.context.essentialTypes.isComposite($jp.subExpr))) return false;
+
+        const toType = getEssentialTypeOfType($jp.type);
+        const fromType = this.context.essentialTypes.getEssentialType($jp.subExpr);
+        if (toType.category === EssentialTypeCategory.UNKNOWN || fromType.category === EssentialTypeCategory.UNKNOWN) return false;
+
+        const differentCategory = toType.category !== fromType.category;
+        const nonCompliant = differentCategory || this.isWideningCast($jp);
+        if (logErrors && nonCompliant) {
+            this.logMISRAError($jp, differentCategory ?
+                `Composite expression '${$jp.subExpr.code}' of essentially ${fromType.category} type must not be cast to the essentially ${toType.category} type '${$jp.type.code}'.` :
+                `Composite expression '${$jp.subExpr.code}' of ${fromType.width}-bit essential type must not be cast to the wider type '${$jp.type.code}'.`);
+        }
+        return nonCompliant;
+    }
+
+    /**
+     * Moves a widening cast to the leftmost operand of the composite expression, so that the operation is performed in the wider type.
+     * Casts to a different essential type category, and of conditional expressions, are reported instead.
+     * 
+     * @param $jp - Joinpoint to transform
+     * @returns Report detailing the transformation result
+     */
+    apply($jp: Joinpoint): MISRATransformationReport {
+        if (!this.match($jp)) {
+            return new MISRATransformationReport(MISRATransformationType.NoChange);
+        }
+
+        const castJp = $jp as Cast;
+        const compositeJp = skipParentheses(castJp.subExpr);
+        if (!(this.isWideningCast(castJp) && compositeJp instanceof BinaryOp)) {
+            this.match($jp, true);
+            return new MISRATransformationReport(MISRATransformationType.NoChange);
+        }
+
+        castLeftmostOperand(compositeJp, castJp.type);
+        const newJp = castJp.replaceWith(castJp.subExpr.deepCopy());
+        return new MISRATransformationReport(MISRATransformationType.Replacement, newJp);
+    }
+}
@@ -0,0 +1,54 @@
+import { Expression, InitList, Joinpoint } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRARule from "../../MISRARule.js";
+import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
+
+/**
+ * MISRA-C Rule 13.1: Initializer lists shall not contain persistent side effects
+ */
+export default class Rule_13_1_InitListSideEffects extends MISRARule {
+    /**
+     * Scope of analysis
+     */
+    readonly analysisType = AnalysisType.SINGLE_TRANSLATION_UNIT;
+
+    /**
+     * @returns Rule identifier according to MISRA-C:2012
+     */
+    override get name(): string {
+        return "13.1";
+    }
+
+    /**
+     * Checks if the given joinpoint is an initializer list with an element that has persistent side effects.
+     * Calls are only considered if the summary of the called function has persistent side effects.
+     * 
+     * @param $jp - Joinpoint to analyze
+     * @param logErrors - [logErrors=false] - Whether to log errors if a violation is detected
+     * @returns Returns true if the joinpoint violates the rule, false otherwise
+     */
+    match($jp: Joinpoint, logErrors: boolean = false): boolean {
+        if (!($jp instanceof InitList)) return false;
+
+        // Nested initializer lists are analyzed on their own
+        const elements = $jp.children.filter((childJp): childJp is Expression => childJp instanceof Expression && !(childJp instanceof InitList));
+        const nonCompliantElements = elements.filter(elementJp => this.context.sideEffects.getExpressionSummary(elementJp).hasPersistentSideEffects);
+
+        if (logErrors) {
+            nonCompliantElements.forEach(elementJp => {
+                this.logMISRAError(elementJp, `Element '${elementJp.code}' of the initializer list has persistent side effects, whose order of evaluation is unspecified.`);
+            });
+        }
+        return nonCompliantElements.length > 0;
+    }
+
+    /**
+     * Violations of this rule are reported but not corrected, since the elements would have to be evaluated before the declaration
+     * 
+     * @param $jp - Joinpoint to transform
+     * @returns Report detailing the transformation result
+     */
+    apply($jp: Joinpoint): MISRATransformationReport {
+        this.match($jp, true);
+        return new MISRATransformationReport(MISRATransformationType.NoChange);
+    }
+}
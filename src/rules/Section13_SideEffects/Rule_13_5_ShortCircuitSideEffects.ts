@@ -0,0 +1,49 @@
+import { BinaryOp, Joinpoint } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRARule from "../../MISRARule.js";
+import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
+
+/**
+ * MISRA-C Rule 13.5: The right hand operand of a logical && or || operator shall not contain persistent side effects
+ */
+export default class Rule_13_5_ShortCircuitSideEffects extends MISRARule {
+    /**
+     * Scope of analysis
+     */
+    readonly analysisType = AnalysisType.SINGLE_TRANSLATION_UNIT;
+
+    /**
+     * @returns Rule identifier according to MISRA-C:2012
+     */
+    override get name(): string {
+        return "13.5";
+    }
+
+    /**
+     * Checks if the given joinpoint is a logical && or || operation whose right operand has persistent side effects.
+     * Calls are only considered if the summary of the called function has persistent side effects.
+     * 
+     * @param $jp - Joinpoint to analyze
+     * @param logErrors - [logErrors=false] - Whether to log errors if a violation is detected
+     * @returns Returns true if the joinpoint violates the rule, false otherwise
+     */
+    match($jp: Joinpoint, logErrors: boolean = false): boolean {
+        if (!($jp instanceof BinaryOp && ($jp.kind === "l_and" || $jp.kind === "l_or"))) return false;
+
+        const nonCompliant = this.context.sideEffects.getExpressionSummary($jp.right).hasPersistentSideEffects;
+        if (logErrors && nonCompliant) {
+            this.logMISRAError($jp.right, `Right operand '${$jp.right.code}' of '${$jp.operator}' has persistent side effects, which only take place depending on the left operand.`);
+        }
+        return nonCompliant;
+    }
+
+    /**
+     * Violations of this rule are reported but not corrected, since the evaluation of the operand depends on the left operand
+     * 
+     * @param $jp - Joinpoint to transform
+     * @returns Report detailing the transformation result
+     */
+    apply($jp: Joinpoint): MISRATransformationReport {
+        this.match($jp, true);
+        return new MISRATransformationReport(MISRATransformationType.NoChange);
+    }
+}
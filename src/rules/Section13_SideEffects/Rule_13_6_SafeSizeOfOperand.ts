@@ -52,7 +52,9 @@ export default class Rule_13_6_SafeSizeOfOperand extends MISRARule {
 
         if (isNonCompliant && logErrors) {
             this.#functionCalls.forEach(call => {
-                this.logMISRAError(call, `Function call '${call.name}' in sizeof is not allowed because it has no effect.`);
+                const reason = this.context.sideEffects.getExpressionSummary(call).hasPersistentSideEffects ?
+                    "its side effects would not take place" : "it is not evaluated";
+                this.logMISRAError(call, `Function call '${call.name}' in sizeof is not allowed because ${reason}.`);
             });
 
             this.#modifyingExpressions.forEach(expr => {
@@ -0,0 +1,51 @@
+import { FunctionJp, GotoStmt, Joinpoint } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRARule from "../../MISRARule.js";
+import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
+
+/**
+ * MISRA-C Rule 15.3: Any label referenced by a goto statement shall be declared in the same block, or in any block enclosing the goto statement.
+ */
+export default class Rule_15_3_GotoBlockEnclosed extends MISRARule {
+    /**
+     * Scope of analysis
+     */
+    readonly analysisType = AnalysisType.SINGLE_TRANSLATION_UNIT;
+
+    /**
+     * @returns Rule identifier according to MISRA-C:2012
+     */
+    override get name(): string {
+        return "15.3";
+    }
+
+    /**
+     * Checks if the given joinpoint is a goto statement whose label is declared in a block that does not enclose it
+     * 
+     * @param $jp - Joinpoint to analyze
+     * @param logErrors - [logErrors=false] - Whether to log errors if a violation is detected
+     * @returns Returns true if the joinpoint violates the rule, false otherwise
+     */
+    match($jp: Joinpoint, logErrors: boolean = false): boolean {
+        if (!($jp instanceof GotoStmt)) return false;
+
+        const functionJp = $jp.getAncestor("function") as FunctionJp | undefined;
+        const labelJp = functionJp ? this.context.getFunctionCfg(functionJp).getLabel($jp) : undefined;
+        const nonCompliant = labelJp !== undefined && !labelJp.parent.contains($jp);
+
+        if (logErrors && nonCompliant) {
+            this.logMISRAError($jp, `The label '${$jp.label.name}' of the goto statement must be declared in a block enclosing the goto.`);
+        }
+        return nonCompliant;
+    }
+
+    /**
+     * Violations of this rule are reported but not corrected, since moving the label would change the control flow of the function
+     * 
+     * @param $jp - Joinpoint to transform
+     * @returns Report detailing the transformation result
+     */
+    apply($jp: Joinpoint): MISRATransformationReport {
+        this.match($jp, true);
+        return new MISRATransformationReport(MISRATransformationType.NoChange);
+    }
+}
@@ -0,0 +1,51 @@
+import { FunctionJp, Joinpoint, Loop } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRARule from "../../MISRARule.js";
+import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
+
+/**
+ * MISRA-C Rule 15.4: There should be no more than one break or goto statement used to terminate any iteration statement.
+ */
+export default class Rule_15_4_LoopSingleExit extends MISRARule {
+    /**
+     * Scope of analysis
+     */
+    readonly analysisType = AnalysisType.SINGLE_TRANSLATION_UNIT;
+
+    /**
+     * @returns Rule identifier according to MISRA-C:2012
+     */
+    override get name(): string {
+        return "15.4";
+    }
+
+    /**
+     * Checks if the given joinpoint is a loop terminated by more than one break or goto statement
+     * 
+     * @param $jp - Joinpoint to analyze
+     * @param logErrors - [logErrors=false] - Whether to log errors if a violation is detected
+     * @returns Returns true if the joinpoint violates the rule, false otherwise
+     */
+    match($jp: Joinpoint, logErrors: boolean = false): boolean {
+        if (!($jp instanceof Loop)) return false;
+
+        const functionJp = $jp.getAncestor("function") as FunctionJp | undefined;
+        const exitCount = functionJp ? this.context.getFunctionCfg(functionJp).getLoopExits($jp).length : 0;
+        const nonCompliant = exitCount > 1;
+
+        if (logErrors && nonCompliant) {
+            this.logMISRAError($jp, `Loop is terminated by ${exitCount} break or goto statements, but should have at most one.`);
+        }
+        return nonCompliant;
+    }
+
+    /**
+     * Violations of this rule are reported but not corrected, since merging the exits requires restructuring the loop
+     * 
+     * @param $jp - Joinpoint to transform
+     * @returns Report detailing the transformation result
+     */
+    apply($jp: Joinpoint): MISRATransformationReport {
+        this.match($jp, true);
+        return new MISRATransformationReport(MISRATransformationType.NoChange);
+    }
+}
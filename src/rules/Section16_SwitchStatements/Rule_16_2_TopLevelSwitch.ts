@@ -1,6 +1,5 @@
 import { Break, Case, Joinpoint, Switch } from "@specs-feup/clava/api/Joinpoints.js";
 import MISRARule from "../../MISRARule.js";
-import Query from "@specs-feup/lara/api/weaver/Query.js";
 import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
 
 /**
@@ -37,8 +36,7 @@ export default class Rule_16_2_TopLevelSwitch extends MISRARule {
     match($jp: Joinpoint, logErrors: boolean = false): boolean {
         if (!($jp instanceof Switch)) return false;
 
-        this.#misplacedCases = Query.searchFrom($jp, Case).get()
-            .filter(caseLabel => !(caseLabel.currentRegion instanceof Switch));
+        this.#misplacedCases = this.context.getSwitchSummary($jp).misplacedCases;
 
         if (logErrors) {
             this.#misplacedCases.forEach(caseLabel =>
@@ -62,6 +60,7 @@ export default class Rule_16_2_TopLevelSwitch extends MISRARule {
         for (const caseLabel of this.#misplacedCases) {
             this.changeCaseLocation(caseLabel);
         }
+        this.context.invalidateSwitchSummary($jp as Switch);
         return new MISRATransformationReport(MISRATransformationType.DescendantChange);
     }
 
@@ -2,7 +2,6 @@ import { Break, Joinpoint, Switch, Case } from "@specs-feup/clava/api/Joinpoints
 import MISRARule from "../../MISRARule.js";
 import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
 import ClavaJoinPoints from "@specs-feup/clava/api/clava/ClavaJoinPoints.js";
-import { getLastStmtOfCase } from "../../utils/SwitchUtils.js";
 
 /**
  * MISRA-C Rule 16.3: An unconditional break statement shall terminate every switch-clause
@@ -33,8 +32,7 @@ export default class Rule_16_3_UnconditionalBreak extends MISRARule {
     match($jp: Joinpoint, logErrors: boolean = false): boolean {
         if (!($jp instanceof Switch)) return false;
 
-        this.#statementsNeedingBreakAfter = $jp.cases.map(caseLabel => getLastStmtOfCase(caseLabel))
-            .filter(lastStmt => lastStmt && !(lastStmt instanceof Break)) as Joinpoint[];
+        this.#statementsNeedingBreakAfter = this.context.getSwitchSummary($jp).statementsNeedingBreak;
 
         if (logErrors) {
             this.#statementsNeedingBreakAfter.forEach(stmt => {
@@ -79,6 +77,7 @@ export default class Rule_16_3_UnconditionalBreak extends MISRARule {
                 this.insertNextStatementsToExecute(stmt);
             }
         }
+        this.context.invalidateSwitchSummary($jp as Switch);
         return new MISRATransformationReport(MISRATransformationType.DescendantChange);
     }
 }
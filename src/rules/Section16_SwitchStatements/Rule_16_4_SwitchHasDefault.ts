@@ -28,7 +28,7 @@ export default class Rule_16_4_SwitchHasDefault extends MISRARule {
     match($jp: Joinpoint, logErrors: boolean = false): boolean {
         if (!($jp instanceof Switch)) return false;
 
-        const noDefaultCase = !$jp.hasDefaultCase;
+        const noDefaultCase = !this.context.getSwitchSummary($jp).hasDefault;
         if (noDefaultCase && logErrors) {
             this.logMISRAError($jp, "Switch statement is missing a default case.")
         }    
@@ -44,6 +44,7 @@ export default class Rule_16_4_SwitchHasDefault extends MISRARule {
             .insertAfter(ClavaJoinPoints.emptyStmt())
             .insertAfter(ClavaJoinPoints.breakStmt());
 
+        this.context.invalidateSwitchSummary($jp as Switch);
         this.context.addRuleResult(this.ruleID, $jp, MISRATransformationType.DescendantChange);
         return new MISRATransformationReport(MISRATransformationType.DescendantChange);
     }
@@ -64,20 +64,14 @@ export default class Rule_16_5_DefaultFirstOrLast extends MISRARule {
     match($jp: Joinpoint, logErrors: boolean = false): boolean {
         if (!($jp instanceof Switch)) return false;
 
-        const caseStmts = $jp.cases;
-        for (let i = 0; i < caseStmts.length; i++) {
-            const currentCase = caseStmts[i];
-            if (currentCase.isDefault) {
-                if (i == 0 || i == caseStmts.length - 1) {
-                    return false;
-                } 
-                if (logErrors) {
-                    this.logMISRAError(currentCase, "The default case of a switch statement must be the first or last label.")
-                }
-                return true;
-            }
+        const summary = this.context.getSwitchSummary($jp);
+        if (summary.isDefaultFirstOrLast) {
+            return false;
+        }
+        if (logErrors) {
+            this.logMISRAError(summary.cases[summary.defaultIndex], "The default case of a switch statement must be the first or last label.")
         }
-        return false;
+        return true;
     }
 
     /**
@@ -94,6 +88,7 @@ export default class Rule_16_5_DefaultFirstOrLast extends MISRARule {
         }
 
         const defaultCase = ($jp as Switch).getDefaultCase;
+        this.context.invalidateSwitchSummary($jp as Switch);
         const rightStatements = defaultCase.siblingsRight.filter(sibling => !isCommentStmt(sibling));
        
         //  Reposition the default case to the last position within its case clause list
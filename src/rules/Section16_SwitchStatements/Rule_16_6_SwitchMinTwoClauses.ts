@@ -1,7 +1,6 @@
 import {Joinpoint, Switch } from "@specs-feup/clava/api/Joinpoints.js";
 import MISRARule from "../../MISRARule.js";
 import { AnalysisType, MISRASwitchConverter, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
-import { countSwitchClauses, hasConditionalBreak } from "../../utils/SwitchUtils.js";
 
 /**
  * MISRA-C Rule 16.6:  Every switch statement shall have at least two switch-clauses.
@@ -33,7 +32,7 @@ export default class Rule_16_6_SwitchMinTwoClauses extends MISRARule {
     match($jp: Joinpoint, logErrors: boolean = false): boolean {
         if (!($jp instanceof Switch)) return false;
 
-        const nonCompliant = countSwitchClauses($jp) < 2;
+        const nonCompliant = this.context.getSwitchSummary($jp).clauseCount < 2;
         if (nonCompliant && logErrors) {
             this.logMISRAError($jp, "Switch statements should have at least two clauses.")
         }
@@ -52,14 +51,15 @@ export default class Rule_16_6_SwitchMinTwoClauses extends MISRARule {
             return new MISRATransformationReport(MISRATransformationType.NoChange);
         
         const switchJp = $jp as Switch;
-        if (hasConditionalBreak(switchJp)) {
+        if (this.context.getSwitchSummary(switchJp).hasConditionalBreak) {
             if (switchJp.hasDefaultCase) {
                 this.logMISRAError($jp, "Switch statement must have at least two clauses and cannot be transformed due to a conditional break statement.")
             }
             return new MISRATransformationReport(MISRATransformationType.NoChange);
         }
 
-        const transformResultNode = MISRASwitchConverter.convert(switchJp);
+        this.context.invalidateSwitchSummary(switchJp);
+        const transformResultNode = MISRASwitchConverter.convert(switchJp, this.context.switchConversionOptions);
         if (transformResultNode) {
             return new MISRATransformationReport(
                 MISRATransformationType.Replacement,
@@ -1,8 +1,6 @@
-import { BinaryOp, BuiltinType, Joinpoint, Switch, UnaryOp } from "@specs-feup/clava/api/Joinpoints.js";
+import { Joinpoint, Switch } from "@specs-feup/clava/api/Joinpoints.js";
 import MISRARule from "../../MISRARule.js";
 import { AnalysisType, MISRASwitchConverter, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
-import { hasConditionalBreak } from "../../utils/SwitchUtils.js";
-import { hasDefinedType } from "../../utils/JoinpointUtils.js";
 
 /**
  * MISRA-C Rule 16.7: A switch-expression shall not have essentially Boolean type.
@@ -31,16 +29,7 @@ export default class Rule_16_7_NonBooleanSwitchCondition extends MISRARule {
      * @returns Returns true if the switch statement has a Boolean condition, otherwise false
      */
     switchHasBooleanCondition(switchStmt: Switch): boolean {
-        const switchCondition = switchStmt.condition;
-
-        if (switchCondition instanceof BinaryOp || switchCondition instanceof UnaryOp) {
-            const logicalOps = new Set(["lt", "gt", "le", "ge", "eq", "ne", "not", "l_not", "and", "or"]);
-            return logicalOps.has(switchCondition.kind);
-        }
-        
-        return hasDefinedType(switchCondition) && 
-            switchCondition.type instanceof BuiltinType && 
-            switchCondition.type.builtinKind === "Bool";
+        return this.context.getSwitchSummary(switchStmt).hasBooleanCondition;
     }
 
     /**
@@ -70,12 +59,13 @@ export default class Rule_16_7_NonBooleanSwitchCondition extends MISRARule {
         if (!this.match($jp)) 
             return new MISRATransformationReport(MISRATransformationType.NoChange);
 
-        if (hasConditionalBreak($jp as Switch)) {
+        if (this.context.getSwitchSummary($jp as Switch).hasConditionalBreak) {
             this.logMISRAError($jp, `The switch statement's controlling expression ${($jp as Switch).condition.code} must not be of a boolean type and cannot be transformed due to a conditional break statement.`)
             return new MISRATransformationReport(MISRATransformationType.NoChange);
         }
         
-        const transformResultNode = MISRASwitchConverter.convert($jp as Switch);
+        this.context.invalidateSwitchSummary($jp as Switch);
+        const transformResultNode = MISRASwitchConverter.convert($jp as Switch, this.context.switchConversionOptions);
         if (transformResultNode) {
             return new MISRATransformationReport(
                 MISRATransformationType.Replacement,
@@ -1,10 +1,11 @@
-import { Call, FileJp, Joinpoint, Program } from "@specs-feup/clava/api/Joinpoints.js";
+import { Call, FileJp, FunctionJp, Joinpoint, Program } from "@specs-feup/clava/api/Joinpoints.js";
 import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
-import { findFunctionDef } from "../../utils/FunctionUtils.js";
-import { getCallIndex, isCallToImplicitFunction } from "../../utils/CallUtils.js";
+import { ImplicitCallResolver, isCompatibleCallee } from "../../utils/CallUtils.js";
 import Query from "@specs-feup/lara/api/weaver/Query.js";
-import { addExternFunctionDecl, getFilesWithCallToImplicitFunction, getIncludesOfFile, isValidFileWithExplicitCall, removeIncludeFromFile } from "../../utils/FileUtils.js";
+import { addExternFunctionDecl, getIncludesOfFile, isValidFileWithExplicitCalls, validateFixesInBatch } from "../../utils/FileUtils.js";
+import { isExternalLinkageIdentifier } from "../../utils/IdentifierUtils.js";
 import UserConfigurableRule from "../UserConfigurableRule.js";
+import MISRATransaction from "../../MISRATransaction.js";
 
 /**
  * MISRA-C Rule 17.3: A function shall not be declared implicitly
@@ -32,6 +33,35 @@ export default class Rule_17_3_ImplicitFunction extends UserConfigurableRule {
         return "17.3";
     }
 
+    /**
+     * Implicit call resolvers of the files, built once per iteration
+     */
+    #resolvers = new Map<string, ImplicitCallResolver>();
+
+    /**
+     * Iteration in which the stored resolvers were built
+     */
+    #resolversIteration: number | undefined = undefined;
+
+    /**
+     * Returns the implicit call resolver of the given file, building it if it was not built in the current iteration
+     * 
+     * @param fileJp The file to analyze
+     */
+    private getResolver(fileJp: FileJp): ImplicitCallResolver {
+        if (this.#resolversIteration !== this.context.iteration) {
+            this.#resolvers.clear();
+            this.#resolversIteration = this.context.iteration;
+        }
+
+        let resolver = this.#resolvers.get(fileJp.astId);
+        if (resolver === undefined) {
+            resolver = new ImplicitCallResolver(fileJp);
+            this.#resolvers.set(fileJp.astId, resolver);
+        }
+        return resolver;
+    }
+
     /**
      * Returns the prefix to be used for error messages related to the given joinpoint
      * 
@@ -56,20 +86,19 @@ export default class Rule_17_3_ImplicitFunction extends UserConfigurableRule {
             return undefined;
         }
     
-        let configFix: string | undefined;
-        try {
-            configFix = this.context.config.get("implicitCalls")[callJp.name];
-        } catch {
+        const implicitCalls = this.context.config.implicitCalls;
+        if (implicitCalls === undefined) {
             this.logMISRAError(callJp, `${errorMsgPrefix} Include or extern was not added as \'implicitCalls\' is not defined in the configuration file.`);
             return undefined;
         }
     
-        if (configFix === undefined) {
+        if (!implicitCalls.has(callJp.name)) {
             this.logMISRAError(callJp, `${errorMsgPrefix} Couldn't add include or extern due to missing configuration for function '${callJp.name}'.`);
             return undefined;
         }
     
-        if (!(configFix.endsWith(".h") || configFix.endsWith(".c"))) {
+        const configFix = implicitCalls.get(callJp.name);
+        if (configFix === undefined) {
             this.logMISRAError(callJp, `${errorMsgPrefix} Cannot add include or extern without a .h or .c reference.`);
             return undefined;
         }
@@ -78,6 +107,7 @@ export default class Rule_17_3_ImplicitFunction extends UserConfigurableRule {
 
     /**
      * Checks if the given joinpoint represents a call to an implicit function.
+     * Only the calls of the files in the analysis scope of the context (e.g., the files impacted by some changes) are resolved.
      * 
      * @param $jp - Joinpoint to analyze
      * @param logErrors - [logErrors=false] - Whether to log errors if a violation is detected
@@ -86,7 +116,9 @@ export default class Rule_17_3_ImplicitFunction extends UserConfigurableRule {
     match($jp: Joinpoint, logErrors: boolean = false): boolean {
         if (!($jp instanceof Program && this.appliesToCurrentStandard())) return false;
         
-        const implicitCalls = Query.searchFrom($jp, Call, (callJp) => isCallToImplicitFunction(callJp)). get();
+        const implicitCalls = Query.searchFrom($jp, FileJp).get()
+            .filter(fileJp => this.context.isInAnalysisScope(fileJp))
+            .flatMap(fileJp => this.getResolver(fileJp).implicitCalls);
         if (logErrors) {
             for (const callJp of implicitCalls) {
                 this.logMISRAError(callJp, this.getErrorMsgPrefix(callJp));
@@ -110,18 +142,14 @@ export default class Rule_17_3_ImplicitFunction extends UserConfigurableRule {
         if (!this.match($jp)) 
             return new MISRATransformationReport(MISRATransformationType.NoChange);
 
-        const filesWithImplicitCall = getFilesWithCallToImplicitFunction($jp as Program);
-        let changedDescendant = false;
+        const filesWithImplicitCall = Query.searchFrom($jp, FileJp).get().filter(fileJp => this.getResolver(fileJp).implicitCalls.length > 0);
+        const changedFiles = filesWithImplicitCall.filter(fileJp => this.solveImplicitCalls(fileJp));
 
-        for (const fileJp of filesWithImplicitCall) {
-            if (this.solveImplicitCalls(fileJp)) {
-                changedDescendant = true;
-            }
-        }
-
-        if (changedDescendant) {
-            this.rebuildProgram();
-            return new MISRATransformationReport(MISRATransformationType.Replacement, Query.root() as Program);
+        // Only the modified files are reparsed, so the program node remains valid
+        if (changedFiles.length > 0) {
+            return this.rebuildFiles(changedFiles) ? 
+                new MISRATransformationReport(MISRATransformationType.DescendantChange) :
+                new MISRATransformationReport(MISRATransformationType.Replacement, Query.root() as Program);
         } else {
             return new MISRATransformationReport(MISRATransformationType.NoChange);
         }
@@ -129,101 +157,154 @@ export default class Rule_17_3_ImplicitFunction extends UserConfigurableRule {
 
     /**
      * Attempts to resolve implicit function calls in a file by adding missing includes or extern statements based on the configuration file.
+     * Calls covered by an approved deviation are kept.
+     * All candidate fixes of the file are validated together, and only the failing ones are isolated and removed.
+     * 
      * @param fileJp The file to analyze
      * @returns `true` if any changes were made to the file, otherwise `false`.
      */
     private solveImplicitCalls(fileJp: FileJp): boolean {
-        const implicitCalls = Query.searchFrom(fileJp, Call, (callJp) => (isCallToImplicitFunction(callJp))).get();
+        const resolver = this.getResolver(fileJp);
+        const implicitCalls = resolver.implicitCalls;
         const originalIncludes = getIncludesOfFile(fileJp);
-        let solvedCalls = new Set<string>();
-        let addedIncludes = new Set<string>();
-        let changedFile = false;
+        const candidates = new Map<string, ImplicitCallFix>();
 
         for (const callJp of implicitCalls) {   
-            if (this.context.getRuleResult(this.ruleID, callJp) === MISRATransformationType.NoChange) {
+            if (this.context.getRuleResult(this.ruleID, callJp) === MISRATransformationType.NoChange || this.isDeviated(callJp)) {
                 continue;
             }
-            
-            if (solvedCalls.has(callJp.name)) {
+
+            const candidate = candidates.get(callJp.name);
+            if (candidate) {
+                candidate.calls.push(callJp);
                 continue;
-            } 
+            }
 
-            const configFix = this.getFixFromConfig(callJp);
-            if (configFix === undefined) {
+            const newCandidate = this.prepareFix(resolver, callJp, originalIncludes);
+            if (newCandidate === undefined) {
                 this.context.addRuleResult(this.ruleID, callJp, MISRATransformationType.NoChange);
                 continue;
             }
+            candidates.set(callJp.name, newCandidate);
+        }
 
-            const callIndex = getCallIndex(fileJp, callJp);
-            const isInclude = configFix.endsWith(".h");
-            const success = isInclude ? 
-                this.solveWithInclude(fileJp, callJp, configFix, originalIncludes, addedIncludes, callIndex) :
-                this.solveWithExtern(fileJp, callJp, configFix, callIndex);
-
-            if (success) {
-                solvedCalls.add(callJp.name);
-                changedFile = true;
-                if (isInclude) {
-                    addedIncludes.add(configFix);
+        // Discard extern declarations whose signature is incompatible with the calls, without compiling
+        for (const [name, candidate] of candidates) {
+            if (!candidate.isInclude && !candidate.calls.every(callJp => isCompatibleCallee(callJp, candidate.functionDef!))) {
+                for (const callJp of candidate.calls) {
+                    this.logMISRAError(callJp, `${this.getErrorMsgPrefix(callJp)} Provided definition at \'${candidate.configFix}\' is incompatible with the call.`);
+                    this.context.addRuleResult(this.ruleID, callJp, MISRATransformationType.NoChange);
                 }
-            } else {
-                this.context.addRuleResult(this.ruleID, callJp, MISRATransformationType.NoChange);
+                candidates.delete(name);
             }
         }
-        return changedFile;
-    }
 
-    private solveWithInclude(fileJp: FileJp, callJp: Call, includePath: string, originalIncludes: Set<string>, addedIncludes: Set<string>, callIndex: number): boolean {
-        const errorMsgPrefix = this.getErrorMsgPrefix(callJp);
-        let success = false;
-
-        if (originalIncludes.has(includePath)) {
-            this.logMISRAError(callJp, `${errorMsgPrefix} Provided include \'${includePath}\' does not fix the violation.`);
-        } 
-        else if (addedIncludes.has(includePath)) {
-            
-            if (isValidFileWithExplicitCall(fileJp, callJp.name, callIndex)) {
-                success = true;
-            } else {
-                this.logMISRAError(callJp, `${errorMsgPrefix} Provided include \'${includePath}\' does not fix the violation.`);
+        const addedIncludes = new Set<string>();
+        const solvedCandidates = validateFixesInBatch(
+            Array.from(candidates.values()),
+            (candidate) => this.applyFix(fileJp, candidate, addedIncludes),
+            (group) => isValidFileWithExplicitCalls(fileJp, group.map(candidate => (
+                {funcName: candidate.calls[0].name, callIndex: candidate.callIndex, checkNumParams: !candidate.isInclude}
+            )))
+        );
+
+        for (const candidate of candidates.values()) {
+            if (solvedCandidates.includes(candidate)) {
+                continue;
             }
-        } 
-        else {
-            fileJp.addInclude(includePath);
-            const fileCompiles = isValidFileWithExplicitCall(fileJp, callJp.name, callIndex);
-
-            if (fileCompiles) {
-                success = true;
-            } else {
-                removeIncludeFromFile(includePath, fileJp);
-                this.logMISRAError(callJp, `${errorMsgPrefix} Provided include \'${includePath}\' does not fix the violation.`);
+            const fixDescription = candidate.isInclude ? `include \'${candidate.configFix}\'` : `definition at \'${candidate.configFix}\'`;
+            for (const callJp of candidate.calls) {
+                this.logMISRAError(callJp, `${this.getErrorMsgPrefix(callJp)} Provided ${fixDescription} does not fix the violation.`);
+                this.context.addRuleResult(this.ruleID, callJp, MISRATransformationType.NoChange);
             }
         }
-        return success;
+        return solvedCandidates.length > 0;
     }
 
-    private solveWithExtern(fileJp: FileJp, callJp: Call, functionLocation: string, callIndex: number): boolean {
+    /**
+     * Builds the candidate fix of an implicit call from the configuration file, without changing the AST
+     * 
+     * @param resolver The implicit call resolver of the file of the call
+     * @param callJp The implicit call
+     * @param originalIncludes The includes of the file before any change
+     * @returns The candidate fix, or undefined if the configuration does not provide a usable fix
+     */
+    private prepareFix(resolver: ImplicitCallResolver, callJp: Call, originalIncludes: Set<string>): ImplicitCallFix | undefined {
+        const configFix = this.getFixFromConfig(callJp);
+        if (configFix === undefined) {
+            return undefined;
+        }
+
         const errorMsgPrefix = this.getErrorMsgPrefix(callJp);
-        const functionDef = findFunctionDef(callJp.name, functionLocation);
-        let success = false;
+        const callIndex = resolver.getOrdinal(callJp);
+        
+        if (configFix.endsWith(".h")) {
+            if (originalIncludes.has(configFix)) {
+                this.logMISRAError(callJp, `${errorMsgPrefix} Provided include \'${configFix}\' does not fix the violation.`);
+                return undefined;
+            }
+            return { calls: [callJp], callIndex, configFix, isInclude: true };
+        }
 
+        const functionDef = this.context.config!.findFunctionDef(callJp.name, configFix);
         if (!functionDef) {
-            this.logMISRAError(callJp, `${errorMsgPrefix} Provided file \'${functionLocation}\' does not have function definition.`);
+            this.logMISRAError(callJp, `${errorMsgPrefix} Provided file \'${configFix}\' does not have function definition.`);
+            return undefined;
+        }
+        if (!isExternalLinkageIdentifier(functionDef)) {
+            this.logMISRAError(callJp, `${errorMsgPrefix} Provided definition at \'${configFix}\' does not have external linkage.`);
+            return undefined;
+        }
+        return { calls: [callJp], callIndex, configFix, isInclude: false, functionDef };
+    }
+
+    /**
+     * Adds the include directive or extern statement of a candidate fix.
+     * Includes shared by several candidates are added only once, by the first candidate that needs them.
+     * 
+     * @returns The transaction with the edits of the candidate
+     */
+    private applyFix(fileJp: FileJp, candidate: ImplicitCallFix, addedIncludes: Set<string>): MISRATransaction {
+        const transaction = this.context.beginTransaction();
+
+        if (candidate.isInclude) {
+            if (!addedIncludes.has(candidate.configFix)) {
+                transaction.addInclude(fileJp, candidate.configFix);
+                addedIncludes.add(candidate.configFix);
+                transaction.record(() => addedIncludes.delete(candidate.configFix));
+            }
         } else {
-            const externDecl = addExternFunctionDecl(fileJp, functionDef);
-
-            if (!externDecl) {
-                this.logMISRAError(callJp, `${errorMsgPrefix} Provided definition at \'${functionLocation}\' does not have external linkage.`);
-            } else {
-                const fileCompiles = isValidFileWithExplicitCall(fileJp, callJp.name, callIndex, true);
-                if (fileCompiles) {
-                    success = true;
-                } else {
-                    externDecl.detach();
-                    this.logMISRAError(callJp, `${errorMsgPrefix} Provided definition at \'${functionLocation}\' does not fix the violation.`);
-                }
+            const externDecl = addExternFunctionDecl(fileJp, candidate.functionDef!);
+            if (externDecl) {
+                transaction.record(() => externDecl.detach());
             }
         }
-        return success;
+        return transaction;
     }
-}
\ No newline at end of file
+}
+
+/**
+ * Candidate fix for the implicit calls to a function within a file
+ */
+interface ImplicitCallFix {
+    /**
+     * Implicit calls to the function, in order of occurrence
+     */
+    calls: Call[];
+    /**
+     * Index of the first call among the calls with the same name
+     */
+    callIndex: number;
+    /**
+     * Include path or location of the definition, as specified in the configuration file
+     */
+    configFix: string;
+    /**
+     * Whether the fix adds an include directive or an extern statement
+     */
+    isInclude: boolean;
+    /**
+     * Function definition referenced by the extern statement
+     */
+    functionDef?: FunctionJp;
+}
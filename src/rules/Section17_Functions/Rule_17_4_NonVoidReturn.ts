@@ -1,14 +1,11 @@
-import { Body, BuiltinType, FileJp, FunctionJp, Joinpoint, ReturnStmt } from "@specs-feup/clava/api/Joinpoints.js";
+import { BuiltinType, FileJp, FunctionJp, Joinpoint, ReturnStmt } from "@specs-feup/clava/api/Joinpoints.js";
 import ClavaJoinPoints from "@specs-feup/clava/api/clava/ClavaJoinPoints.js";
 import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
-import { isValidFile } from "../../utils/FileUtils.js";
+import { isValidFile, validateFixesInBatch } from "../../utils/FileUtils.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { isCompatibleLiteral } from "../../utils/TypeUtils.js";
 import UserConfigurableRule from "../UserConfigurableRule.js";
-import ClavaNode from "@specs-feup/clava-flow/ClavaNode";
-import ReturnNode from "@specs-feup/clava-flow/cfg/node/ReturnNode";
-import ClavaCfgGenerator from "@specs-feup/clava-flow/transformation/ClavaCfgGenerator";
-import BaseNode from "@specs-feup/flow/graph/BaseNode";
-import Graph from "@specs-feup/flow/graph/Graph";
-import ControlFlowEdge from "@specs-feup/flow/flow/ControlFlowEdge";
+import MISRATransaction from "../../MISRATransaction.js";
 
 /**
 * MISRA-C Rule 17.4: All exit paths from a function with non-void return type shall have an explicit return statement with an expression. In a non-void function:
@@ -38,9 +35,8 @@ export default class Rule_17_4_NonVoidReturn extends UserConfigurableRule {
     match($jp: Joinpoint, logErrors: boolean = false): boolean {
         if (!($jp instanceof FunctionJp && $jp.isImplementation)) return false;
         if ($jp.returnType instanceof BuiltinType && $jp.returnType.isVoid) return false;
-        if ($jp.body.children.some(childJp => childJp instanceof ReturnStmt)) return false;
         
-        const nonCompliant = !this.allControlPathsReturn($jp);
+        const nonCompliant = !this.context.getFunctionCfg($jp).allExitPathsReturn;
 
         if (logErrors && nonCompliant) {
             this.logMISRAError($jp, `Function '${$jp.name}' reaches the end without a return statement.`)
@@ -49,76 +45,78 @@ export default class Rule_17_4_NonVoidReturn extends UserConfigurableRule {
     }
 
     /**
-     * Performs a depth.first search on the function's control flow graph (CFG) to check if all exit paths in the function have a return statement
-     * 
-     * @param functionJp  The function to analyze
-     * @returns Returns true if all exit paths in the function have an explicit return statement, otherwise returns false.
-     */
-    private allControlPathsReturn(functionJp: FunctionJp) {
-        // Generate control flow graph 
-        const cfg = Graph.create().apply(new ClavaCfgGenerator(functionJp));
-        const startNode: BaseNode.Class = cfg.nodes.filterIs(ClavaNode).filter(node => node.jp instanceof Body)[0];
-        cfg.edges.filter(edge => edge.is(ControlFlowEdge) && edge.as(ControlFlowEdge).isFake).forEach((edge) => {
-            edge.remove();
-        })
-        
-        const stack = [startNode];
-        const visited = new Set();
-    
-        while (stack.length > 0) {
-            const node = stack.pop()!;
-    
-            if (visited.has(node) || node?.is(ReturnNode)) 
-                continue;
-            
-            let children = Array.from(node.outgoers).map(edge => edge.target);
-            if (!children || children.length === 0)  
-                return false; // Reached the end of the graph without finding a single return statement
-    
-            children = children.filter(child => !visited.has(child));
-            children.forEach(child => stack.push(child.as(BaseNode)));
-        }
-        return true; 
-    }
-
-    /**
-     * Transforms a non-void function joinpoint that has no return statement at the end, by adding a default return value based on the config file.
+     * Transforms non-void functions that have no return statement at the end, by adding a default return value based on the config file.
      * - If the configuration file is missing/invalid or the specified default value is invalid, no transformation is performed and the function is left unchanged.
      * - Otherwise, a return statement is inserted as the last statement of the function. 
      * 
+     * When applied to a file, the return statements of all its non-compliant functions are validated together, 
+     * so that the file is rebuilt once when every default value is valid.
+     * 
      * @param $jp - Joinpoint to transform
      * @returns Report detailing the transformation result
      */
     apply($jp: Joinpoint): MISRATransformationReport {
-        const previousResult = $jp instanceof FunctionJp ? this.context.getRuleResult(this.ruleID, $jp) : undefined;
-        if (previousResult === MISRATransformationType.NoChange || !this.match($jp)) {
-            return new MISRATransformationReport(MISRATransformationType.NoChange);   
+        let functions: FunctionJp[] = [];
+        if ($jp instanceof FileJp) {
+            functions = Query.searchFrom($jp, FunctionJp).get();
+        } else if ($jp instanceof FunctionJp) {
+            functions = [$jp];
         }
-
-        const functionJp = $jp as FunctionJp;
-        const fileJp = functionJp.getAncestor("file") as FileJp;
-        const errorMsgPrefix = this.getErrorMsgPrefix(functionJp);
-
-        const defaultValueReturn = this.getFixFromConfig(functionJp);
-        if (defaultValueReturn === undefined) {
-            this.context.addRuleResult(this.ruleID, $jp, MISRATransformationType.NoChange);
+        functions = functions.filter(functionJp => this.context.getRuleResult(this.ruleID, functionJp) !== MISRATransformationType.NoChange && this.match(functionJp));
+        
+        if (functions.length === 0) {
             return new MISRATransformationReport(MISRATransformationType.NoChange);
         }
+        const fileJp = ($jp instanceof FileJp ? $jp : $jp.getAncestor("file")) as FileJp;
+
+        const candidates: ReturnFix[] = [];
+        for (const functionJp of functions) {
+            const defaultValueReturn = this.getFixFromConfig(functionJp);
+            if (defaultValueReturn === undefined) {
+                this.context.addRuleResult(this.ruleID, functionJp, MISRATransformationType.NoChange);
+            } else if (!isCompatibleLiteral(String(defaultValueReturn), functionJp.returnType)) { // Discard values that cannot convert to the return type, without compiling
+                this.logMISRAError(functionJp, `${this.getErrorMsgPrefix(functionJp)} Provided default value for type '${functionJp.type.code}' is invalid and was therefore not inserted.`);
+                this.context.addRuleResult(this.ruleID, functionJp, MISRATransformationType.NoChange);
+            } else {
+                candidates.push({ functionJp, defaultValueReturn });
+            }
+        }
 
-        // Insert return statement and validate it
-        const returnStmt = ClavaJoinPoints.returnStmt(ClavaJoinPoints.exprLiteral(String(defaultValueReturn), functionJp.returnType)) as ReturnStmt;
-        functionJp.body.lastChild ? functionJp.body.lastChild.insertAfter(returnStmt) : functionJp.body.setFirstChild(returnStmt);
+        // Insert return statements and validate them
+        const solvedCandidates = validateFixesInBatch(
+            candidates,
+            (candidate) => this.insertReturn(candidate),
+            () => isValidFile(fileJp) === true
+        );
 
-        // Validate the provided default value
-        if (isValidFile(fileJp)) {
-            return new MISRATransformationReport(MISRATransformationType.DescendantChange);
-        } 
+        // If the default value is invalid, the return stmt was removed
+        for (const candidate of candidates) {
+            if (solvedCandidates.includes(candidate)) {
+                continue;
+            }
+            const functionJp = candidate.functionJp;
+            this.logMISRAError(functionJp, `${this.getErrorMsgPrefix(functionJp)} Provided default value for type '${functionJp.type.code}' is invalid and was therefore not inserted.`);
+            this.context.addRuleResult(this.ruleID, functionJp, MISRATransformationType.NoChange);
+        }
 
-        // If the default value is invalid, the return stmt is removed
-        returnStmt.detach();
-        this.logMISRAError($jp, `${errorMsgPrefix} Provided default value for type '${functionJp.type.code}' is invalid and was therefore not inserted.`);
-        this.context.addRuleResult(this.ruleID, $jp, MISRATransformationType.NoChange);
-        return new MISRATransformationReport(MISRATransformationType.NoChange);
+        return solvedCandidates.length > 0 ? 
+            new MISRATransformationReport(MISRATransformationType.DescendantChange) : 
+            new MISRATransformationReport(MISRATransformationType.NoChange);
+    }
+
+    /**
+     * Inserts the default return statement as the last statement of the function
+     * 
+     * @param candidate The function and the default value to return
+     * @returns The transaction with the inserted statement
+     */
+    private insertReturn(candidate: ReturnFix): MISRATransaction {
+        const functionJp = candidate.functionJp;
+        const transaction = this.context.beginTransaction();
+        const returnStmt = ClavaJoinPoints.returnStmt(ClavaJoinPoints.exprLiteral(String(candidate.defaultValueReturn), functionJp.returnType)) as ReturnStmt;
+        
+        functionJp.body.lastChild ? transaction.insertAfter(functionJp.body.lastChild, returnStmt) : transaction.setFirstChild(functionJp.body, returnStmt);
+        return transaction;
     }
 
     /**
@@ -144,18 +142,31 @@ export default class Rule_17_4_NonVoidReturn extends UserConfigurableRule {
             return undefined;
         }
 
-        let defaultValueReturn: string | undefined = undefined;
-        const returnType = functionJp.type.code;
-        try {
-            defaultValueReturn = this.context.config.get("defaultValues")[returnType];
-        } catch (error) {  
+        const defaultValues = this.context.config.defaultValues;
+        if (defaultValues === undefined) {
             this.logMISRAError(functionJp, `${errorMsgPrefix} Default value return was not added as \'defaultValues\' is not defined in the configuration file.`);
             return undefined;
         }
 
+        const returnType = functionJp.type.code;
+        const defaultValueReturn = defaultValues.get(returnType);
         if (defaultValueReturn === undefined) {
             this.logMISRAError(functionJp, `${errorMsgPrefix} Default value return not added due to missing default value configuration for type '${returnType}'.`);
         }
         return defaultValueReturn;
     }
 }
+
+/**
+ * Candidate default return statement of a non-void function
+ */
+interface ReturnFix {
+    /**
+     * The non-compliant function
+     */
+    functionJp: FunctionJp;
+    /**
+     * Default value specified on the configuration file for the return type
+     */
+    defaultValueReturn: string;
+}
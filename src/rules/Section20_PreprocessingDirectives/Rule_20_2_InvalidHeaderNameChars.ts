@@ -0,0 +1,44 @@
+import LexicalRule, { LexicalViolation } from "../LexicalRule.js";
+import { Token, TokenKind } from "../../utils/LexerUtils.js";
+
+/**
+ * MISRA-C Rule 20.2: The ', " or \ characters and the /* or // character sequences shall not occur in a header file name.
+ */
+export default class Rule_20_2_InvalidHeaderNameChars extends LexicalRule {
+    /**
+     * Kinds of tokens analyzed by the rule
+     */
+    readonly tokenKinds = [TokenKind.DIRECTIVE];
+
+    /**
+     * @returns Rule identifier according to MISRA-C:2012
+     */
+    override get name(): string {
+        return "20.2";
+    }
+
+    /**
+     * Checks if the given directive includes a header whose name contains invalid characters.
+     * The violation cannot be corrected, since it would require renaming the header.
+     * 
+     * @param tokens - The tokens of the file
+     * @param index - The index of the directive to analyze
+     * @returns The violation, or undefined if the directive complies with the rule
+     */
+    matchToken(tokens: Token[], index: number): LexicalViolation | undefined {
+        const directive = tokens[index];
+        const includeMatch = directive.text.match(/^#\s*include\s*(?:<(.*)>|"(.*)")/);
+        if (!includeMatch) {
+            return undefined;
+        }
+
+        const headerName = includeMatch[1] ?? includeMatch[2];
+        if (!/('|"|\\|\/\*|\/\/)/.test(headerName)) {
+            return undefined;
+        }
+        return {
+            token: directive,
+            message: `Invalid characters in include for ${headerName}. Invalid characters are ', ", \\, and the sequences /* and //.`
+        };
+    }
+}
@@ -1,9 +1,15 @@
-import { Call, Joinpoint, Program, FileJp, Include } from "@specs-feup/clava/api/Joinpoints.js";
+import { Call, Joinpoint, Program, FileJp, Include, FunctionJp } from "@specs-feup/clava/api/Joinpoints.js";
 import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
 import Query from "@specs-feup/lara/api/weaver/Query.js";
-import { addExternFunctionDecl, findFilesReferencingHeader, getCallsToLibrary, getExternFunctionDecls, getIncludesOfFile, isValidFile } from "../../utils/FileUtils.js";
-import { findFunctionDef } from "../../utils/FunctionUtils.js";
+import { addExternFunctionDecl, getExternFunctionDecls, isValidFile, validateFixesInBatch } from "../../utils/FileUtils.js";
+import { DisallowedFunctionFix } from "../../MISRAConfig.js";
+import { isExternalLinkageIdentifier } from "../../utils/IdentifierUtils.js";
+import { isCompatibleCallee } from "../../utils/CallUtils.js";
 import UserConfigurableRule from "../UserConfigurableRule.js";
+import MISRATransaction from "../../MISRATransaction.js";
+import MISRARule from "../../MISRARule.js";
+import StdLibUsageIndex from "./StdLibUsageIndex.js";
+import { refreshFileCaches } from "../../utils/ProgramUtils.js";
 
 /**
  * 
@@ -47,6 +53,16 @@ export default abstract class DisallowedStdLibFunctionRule extends UserConfigura
      */
     protected filesWithRetainedHeaders: Set<string> = new Set<string>();
 
+    /**
+     * Index of library usages, shared with the linked rules
+     */
+    private usageIndex: StdLibUsageIndex | undefined = undefined;
+
+    /**
+     * Rules that share the library usage pass and whose violations are corrected together
+     */
+    private linkedRules: DisallowedStdLibFunctionRule[] = [this];
+
     /**
      * Specifies the scope of analysis: single unit or entire system.
      */
@@ -90,7 +106,7 @@ export default abstract class DisallowedStdLibFunctionRule extends UserConfigura
      * @param callJp - The disallowed function call 
      * @param msg - Description of the violation
      */
-    private logDisallowedCall(callJp: Call, msg: string) {
+    protected logDisallowedCall(callJp: Call, msg: string) {
         this.logMISRAError(callJp, msg);
         this.context.addRuleResult(this.ruleID, callJp, MISRATransformationType.NoChange);
         if (!this.unresolvedCalls.has(callJp.name)) {
@@ -113,7 +129,7 @@ export default abstract class DisallowedStdLibFunctionRule extends UserConfigura
      * @param $jp - Joinpoint where the violation was detected
      * @return The fix retrieved from the configuration for the violation, or `undefined` if no applicable fix is found.
      */
-    protected getFixFromConfig(callJp: Call): Map<string, string> | undefined {
+    protected getFixFromConfig(callJp: Call): DisallowedFunctionFix | undefined {
         const errorMsgPrefix = this.getErrorMsgPrefix(callJp);
 
         if (!this.context.config) {
@@ -121,33 +137,101 @@ export default abstract class DisallowedStdLibFunctionRule extends UserConfigura
             return undefined;
         }
 
-        let configFix = this.context.config.get("disallowedFunctions");
+        const configFix = this.context.config.disallowedFunctions;
         if (!configFix) {
             this.logDisallowedCall(callJp, `${errorMsgPrefix} Extern was not added as \'disallowedFunctions\' is not defined in the configuration file.`);
             return undefined;
         } 
 
-        if (!configFix[this.standardLibrary]) {
+        const libraryFixes = configFix.get(this.standardLibrary);
+        if (!libraryFixes) {
             this.logDisallowedCall(callJp, `${errorMsgPrefix} Couldn't add extern due to missing configuration for standard library <${this.standardLibrary}>.`);
             return undefined;
         }
 
-        if (!configFix[this.standardLibrary][callJp.name]) {
+        if (!libraryFixes.has(callJp.name)) {
             this.logDisallowedCall(callJp, `${errorMsgPrefix} Couldn't add extern due to missing configuration for function \'${callJp.name}\' of standard library <${this.standardLibrary}>.`);
             return undefined;
         }
 
-        const location = configFix[this.standardLibrary][callJp.name]["location"];
-        const replacement_func = configFix[this.standardLibrary][callJp.name]["replacement"];
-
-        if (location === undefined || replacement_func === undefined) {
+        const fix = libraryFixes.get(callJp.name);
+        if (fix === undefined) {
             this.logDisallowedCall(callJp, `${errorMsgPrefix} Couldn't add extern due to incomplete configuration for function \'${callJp.name}\' of standard library <${this.standardLibrary}>.`);
             return undefined;
         }
-        return new Map([
-            ["function", replacement_func],
-            ["location", location]
-        ]);
+        return fix;
+    }
+
+    /**
+     * Checks if the configuration file specifies a replacement for the given function, which takes precedence over generated replacements
+     * 
+     * @param functionName Name of the disallowed function
+     */
+    protected hasConfiguredReplacement(functionName: string): boolean {
+        return this.context.config?.disallowedFunctions?.get(this.standardLibrary)?.has(functionName) ?? false;
+    }
+
+    /**
+     * Adds a source file generated by the rule to the program, unless a file already exists at its location, 
+     * e.g., generated in a previous iteration or provided by the user. An existing file is only used if it defines the required functions,
+     * since it may have been generated for other calls.
+     * 
+     * @param programJp The program
+     * @param location Path of the file, as specified in the configuration file
+     * @param requiredFunctions Names of the functions the file must define
+     * @param generate Adds the generated file to the program, returning it or undefined if it does not compile
+     * @returns Returns true if a file that defines the required functions exists at the location, otherwise false
+     */
+    protected provideGeneratedFile(programJp: Program, location: string, requiredFunctions: string[], generate: () => FileJp | undefined): boolean {
+        const existingFile = Query.searchFrom(programJp, FileJp).get().find(fileJp => fileJp.filepath.endsWith(location));
+        if (existingFile !== undefined) {
+            const definedFunctions = new Set(Query.searchFrom(existingFile, FunctionJp, {isImplementation: true}).get().map(functionJp => functionJp.name));
+            return requiredFunctions.every(name => definedFunctions.has(name));
+        }
+
+        const generatedFile = generate();
+        if (generatedFile === undefined) {
+            return false;
+        }
+        refreshFileCaches(new Set(), [generatedFile]);
+        this.context.config?.invalidateDefinitions();
+        return true;
+    }
+
+    /**
+     * Prepares the replacement functions before the disallowed calls of {@link invalidFiles} are corrected, e.g., by generating them.
+     * By default, the replacements are the functions specified on the configuration file, so nothing is prepared.
+     * 
+     * @param programJp The program
+     */
+    protected prepareReplacements(programJp: Program) {}
+
+    /**
+     * Shares a single library usage pass among the given rules that disallow library functions, 
+     * so that their violations are also corrected together, file by file.
+     * 
+     * @param rules The selected rules
+     */
+    static linkRules(rules: MISRARule[]) {
+        const stdLibRules = rules.filter((rule): rule is DisallowedStdLibFunctionRule => rule instanceof DisallowedStdLibFunctionRule);
+        const usageIndex = new StdLibUsageIndex();
+
+        for (const rule of stdLibRules) {
+            usageIndex.register(rule.ruleID, rule.standardLibrary, rule.invalidFunctions);
+            rule.usageIndex = usageIndex;
+            rule.linkedRules = stdLibRules;
+        }
+    }
+
+    /**
+     * Returns the index of library usages, creating one restricted to this rule if it was not linked with other rules
+     */
+    private getUsageIndex(): StdLibUsageIndex {
+        if (this.usageIndex === undefined) {
+            this.usageIndex = new StdLibUsageIndex();
+            this.usageIndex.register(this.ruleID, this.standardLibrary, this.invalidFunctions);
+        }
+        return this.usageIndex;
     }
 
     /**
@@ -159,82 +243,190 @@ export default abstract class DisallowedStdLibFunctionRule extends UserConfigura
     match($jp: Joinpoint, logErrors: boolean = false): boolean {
         if (!($jp instanceof Program && this.appliesToCurrentStandard())) return false;
 
-        this.invalidFiles = new Map<FileJp, Call[]>();
-        const referencingFiles = findFilesReferencingHeader(this.standardLibrary);
-        let nonCompliant = false;
-
-        for (const fileJp of referencingFiles) {
-            const invalidCalls = getCallsToLibrary(fileJp, this.standardLibrary, this.invalidFunctions);
-            
-            if (invalidCalls.length > 0 || this.isLibraryFullyDisallowed()) {
-                this.invalidFiles.set(fileJp, invalidCalls);
-                nonCompliant = true;
-            }
-            if (logErrors) {
+        this.invalidFiles = this.getUsageIndex().getWorklist(this.ruleID, this.context.iteration);
+        if (logErrors) {
+            for (const [fileJp, invalidCalls] of this.invalidFiles) {
                 invalidCalls.forEach(callJp => this.logMISRAError(callJp, this.getErrorMsgPrefix(callJp)));
                 this.logDisallowedInclude(fileJp);
             } 
         }
-        return nonCompliant;
+        return this.invalidFiles.size > 0;
     }
 
     /**
+     * Corrects the violations of this rule and of the rules linked with it. 
+     * For each file, the replacements of all rules are validated in a single batch, followed by the removal of fully disallowed includes.
+     * Linked rules applied afterwards in the same iteration perform no changes.
      * 
      * @param $jp - Joinpoint to transform
      * @returns Report detailing the transformation result
      */
     apply($jp: Joinpoint): MISRATransformationReport {
-        if (!this.match($jp)) return new MISRATransformationReport(MISRATransformationType.NoChange);
-    
-        let changedDescendant = false;
-        for (const [fileJp, invalidCalls] of this.invalidFiles) {
-            if (this.solveDisallowedFunctions(fileJp, invalidCalls)) {
-                changedDescendant = true;
+        if (!($jp instanceof Program)) return new MISRATransformationReport(MISRATransformationType.NoChange);
+
+        const usageIndex = this.getUsageIndex();
+        if (usageIndex.appliedIteration === this.context.iteration) { // Already corrected by a linked rule
+            return new MISRATransformationReport(MISRATransformationType.NoChange);
+        }
+        usageIndex.appliedIteration = this.context.iteration;
+
+        const activeRules = this.linkedRules.filter(rule => rule.match($jp));
+        activeRules.forEach(rule => rule.prepareReplacements($jp));
+        const files = new Set(activeRules.flatMap(rule => Array.from(rule.invalidFiles.keys())));
+        
+        const changedFiles: FileJp[] = [];
+        for (const fileJp of files) {
+            if (DisallowedStdLibFunctionRule.solveDisallowedFunctions(fileJp, activeRules)) {
+                changedFiles.push(fileJp);
             }
         }
+        usageIndex.invalidate();
 
-        // Rebuild AST if any file changed
-        if (changedDescendant) { 
-            this.rebuildProgram();
-            return new MISRATransformationReport(MISRATransformationType.Replacement, Query.root() as Program);
+        // Rebuild the files that changed. The program node remains valid unless a header had to be rebuilt
+        if (changedFiles.length > 0) { 
+            return this.rebuildFiles(changedFiles) ? 
+                new MISRATransformationReport(MISRATransformationType.DescendantChange) :
+                new MISRATransformationReport(MISRATransformationType.Replacement, Query.root() as Program);
         }
         return new MISRATransformationReport(MISRATransformationType.NoChange);
     }
 
-    private solveDisallowedFunctions(fileJp: FileJp, invalidCalls: Call[]): boolean {
-        let externFunctions = this.getExternFunctionDeclIds(fileJp);
-        let changedFile = false;
-        let solvedCallsCount = 0;
-        let solvedCalls = new Map<string, string>();
+    /**
+     * Replaces the disallowed calls of a file by calls to the functions specified on the configuration file.
+     * The candidate replacements of all rules are validated together, and only the failing ones are isolated and reverted.
+     * Then, the includes of fully disallowed libraries whose calls were all fixed are removed, also validated together.
+     * Calls covered by an approved deviation of their rule are not replaced, so the includes they need are kept.
+     * 
+     * @param fileJp The file to modify
+     * @param rules The rules with violations in the program
+     * @returns `true` if any changes were made to the file, otherwise `false`.
+     */
+    private static solveDisallowedFunctions(fileJp: FileJp, rules: DisallowedStdLibFunctionRule[]): boolean {
+        const externFunctions = DisallowedStdLibFunctionRule.getExternFunctionDeclIds(fileJp);
+        const fileRules = rules.filter(rule => rule.invalidFiles.has(fileJp));
+        const candidates = fileRules.flatMap(rule => rule.prepareFixes(rule.invalidFiles.get(fileJp)!.filter(callJp => !rule.isDeviated(callJp)), externFunctions));
+
+        const solvedCandidates = validateFixesInBatch(
+            candidates,
+            (candidate) => candidate.rule.applyFix(fileJp, candidate),
+            () => isValidFile(fileJp) === true
+        );
+
+        const includeRemovals: IncludeRemoval[] = [];
+        for (const rule of fileRules) {
+            const ruleCandidates = candidates.filter(candidate => candidate.rule === rule);
+            let solvedCallsCount = 0;
+
+            for (const candidate of ruleCandidates) {
+                if (solvedCandidates.includes(candidate)) {
+                    solvedCallsCount += candidate.calls.length;
+                    continue;
+                }
+                // If file does not compile, mark calls as unfixable
+                const reason = candidate.generate ? 
+                    `Generated replacement \'${candidate.location}\' does not fix the violation.` : 
+                    `Provided definition at \'${candidate.location}\' does not fix the violation.`;
+                for (const callJp of candidate.calls) {
+                    rule.logDisallowedCall(callJp, `${rule.getErrorMsgPrefix(callJp)} ${reason}`);
+                }
+            }
 
-        for (const callJp of invalidCalls) {
-            if (this.solveDisallowedFunctionCall(callJp, fileJp, externFunctions, solvedCalls)) {
-                changedFile = true;
-                solvedCallsCount++;
+            const fixedAllCalls = solvedCallsCount === rule.invalidFiles.get(fileJp)!.length;
+            const includeJp = rule.prepareIncludeRemoval(fileJp, fixedAllCalls);
+            if (includeJp) {
+                includeRemovals.push({ rule, includeJp });
             }
         }
 
-        // Try to remove the include 
-        const fixedAllCalls = solvedCallsCount === invalidCalls.length;
-        this.removeInclude(fileJp, fixedAllCalls);
+        // Remove includes, restoring them and logging errors if any other library features are still referenced
+        const removedIncludes = validateFixesInBatch(
+            includeRemovals,
+            (removal) => {
+                const transaction = removal.rule.context.beginTransaction();
+                transaction.detach(removal.includeJp);
+                return transaction;
+            },
+            () => isValidFile(fileJp) === true
+        );
+        includeRemovals
+            .filter(removal => !removedIncludes.includes(removal))
+            .forEach(removal => removal.rule.logDisallowedInclude(fileJp));
 
-        return changedFile;
+        return solvedCandidates.length > 0 || removedIncludes.length > 0;
     }
 
-    private solveDisallowedFunctionCall(callJp: Call, fileJp: FileJp, externFunctions: Set<string>, solvedCalls: Map<string, string>): boolean {
-        if (solvedCalls.has(callJp.name)) {
-            callJp.setName(solvedCalls.get(callJp.name)!);
-            return true;
+    /**
+     * Builds the candidate replacements of the disallowed calls of a file, grouped by replacement, without changing the AST
+     * 
+     * @param invalidCalls The disallowed calls of the file
+     * @param externFunctions Identifiers of the definitions already declared as extern in the file
+     * @returns The candidate fixes whose replacement is compatible with the calls
+     */
+    private prepareFixes(invalidCalls: Call[], externFunctions: Set<string>): DisallowedCallFix[] {
+        const candidates = new Map<string, DisallowedCallFix>();
+        const generatedFixes = this.prepareGeneratedFixes(invalidCalls);
+        const generatedCalls = new Set(generatedFixes.flatMap(candidate => candidate.calls.map(callJp => callJp.astId)));
+
+        for (const callJp of invalidCalls.filter(callJp => !generatedCalls.has(callJp.astId))) {
+            const candidate = candidates.get(this.getReplacementGroup(callJp));
+            if (candidate) {
+                candidate.calls.push(callJp);
+                continue;
+            }
+
+            const newCandidate = this.prepareFix(callJp, externFunctions);
+            if (newCandidate) {
+                candidates.set(this.getReplacementGroup(callJp), newCandidate);
+            }
         }
-        
+
+        // Discard replacements whose signature is incompatible with the calls, without compiling
+        for (const [name, candidate] of candidates) {
+            if (!candidate.calls.every(callJp => isCompatibleCallee(callJp, candidate.functionDef!))) {
+                candidate.calls.forEach(callJp => this.logDisallowedCall(callJp, `${this.getErrorMsgPrefix(callJp)} Provided definition at \'${candidate.location}\' is incompatible with the call.`));
+                candidates.delete(name);
+            }
+        }
+        return [...generatedFixes, ...candidates.values()];
+    }
+
+    /**
+     * Returns the key of the group of calls that share the same replacement. By default, the calls of the same function are replaced together.
+     * 
+     * @param callJp The disallowed call
+     */
+    protected getReplacementGroup(callJp: Call): string {
+        return callJp.name;
+    }
+
+    /**
+     * Builds the candidate replacements of the disallowed calls of a file that are generated by the rule, instead of taken from the configuration file.
+     * The remaining calls are replaced as specified on the configuration file. By default, no replacements are generated.
+     * 
+     * @param invalidCalls The disallowed calls of the file
+     * @returns The candidate fixes, each with the edits that generate its replacement
+     */
+    protected prepareGeneratedFixes(invalidCalls: Call[]): DisallowedCallFix[] {
+        return [];
+    }
+
+    /**
+     * Builds the candidate replacement of a disallowed call from the configuration file, without changing the AST
+     * 
+     * @param callJp The disallowed call
+     * @param externFunctions Identifiers of the definitions already declared as extern in the file
+     * @returns The candidate fix, or undefined if the call cannot be fixed
+     */
+    private prepareFix(callJp: Call, externFunctions: Set<string>): DisallowedCallFix | undefined {
         // Skip call if previous AST visit marked it as unfixable
         if (this.context.getRuleResult(this.ruleID, callJp) === MISRATransformationType.NoChange) {
-            return false;
+            return undefined;
         }
 
         // Skip call if previous visits, before rebuild, marked it as unfixable
         if (this.unresolvedCalls.has(callJp.name)) {
             this.logDisallowedCall(callJp, this.unresolvedCalls.get(callJp.name)!);
+            return undefined;
         }
 
         const errorMsgPrefix = this.getErrorMsgPrefix(callJp);
@@ -242,44 +434,57 @@ export default abstract class DisallowedStdLibFunctionRule extends UserConfigura
        
         // Skip if config file was not specified or provides an invalid fix
         if (!configFix) { 
-            return false;
+            return undefined;
         }
 
-        const [location, replacement_func] = [configFix.get("location"), configFix.get("function")];
-        const functionDef = findFunctionDef(replacement_func!, location!);
+        const location = configFix.location;
+        const functionDef = this.context.config!.findFunctionDef(configFix.replacement, location);
 
         // Skip if specified function doesn't exist
         if (!functionDef) {
             this.logDisallowedCall(callJp, `${errorMsgPrefix} Provided file \'${location}\' does not have function definition.`);
-            return false;
+            return undefined;
         }
 
         // Skip if specified function doesn't have external linkage
-        let externDecl: Joinpoint | undefined;
-        if (!externFunctions.has(functionDef.astId)) {
-            externDecl = addExternFunctionDecl(fileJp, functionDef);
+        if (!isExternalLinkageIdentifier(functionDef)) {
+            this.logDisallowedCall(callJp, `${errorMsgPrefix} Provided definition at \'${location}\' does not have external linkage.`);
+            return undefined;
+        }
 
-            if (externDecl === undefined) {
-                this.logDisallowedCall(callJp, `${errorMsgPrefix} Provided definition at \'${location}\' does not have external linkage.`);
-                return false;
-            }
+        return {
+            rule: this,
+            calls: [callJp],
+            functionDef,
+            location,
+            needsExtern: !externFunctions.has(functionDef.astId)
+        };
+    }
+
+    /**
+     * Generates the replacement of the candidate or, if it is provided by the configuration file, 
+     * adds the extern declaration of the replacement function, if needed, and renames the calls
+     * 
+     * @returns The transaction with the edits of the candidate
+     */
+    private applyFix(fileJp: FileJp, candidate: DisallowedCallFix): MISRATransaction {
+        const transaction = this.context.beginTransaction();
+        if (candidate.generate) {
+            candidate.generate(transaction);
+            return transaction;
         }
 
-        const previousCallName = callJp.name;
-        callJp.setName(functionDef.name);
-        if (isValidFile(fileJp)) {
-            externFunctions.add(functionDef.astId);
-            solvedCalls.set(previousCallName, functionDef.name);
-            return true;
-        } else { // If file does not compile, remove added external declaration and mark call as unfixable
-            externDecl?.detach();
-            callJp.setName(previousCallName);
-            this.logDisallowedCall(callJp, `${errorMsgPrefix} Provided definition at \'${location}\' does not fix the violation.`);
-            return false;
+        if (candidate.needsExtern) {
+            const externDecl = addExternFunctionDecl(fileJp, candidate.functionDef!);
+            if (externDecl) {
+                transaction.record(() => externDecl.detach());
+            }
         }
+        candidate.calls.forEach(callJp => transaction.setName(callJp, candidate.functionDef!.name));
+        return transaction;
     }
 
-    private getExternFunctionDeclIds(fileJp: FileJp): Set<string> {
+    private static getExternFunctionDeclIds(fileJp: FileJp): Set<string> {
         return new Set(
           getExternFunctionDecls(fileJp)
             .filter((funcJp) => funcJp.definitionJp !== undefined)
@@ -288,30 +493,69 @@ export default abstract class DisallowedStdLibFunctionRule extends UserConfigura
     }
 
     /**
-     * Removes the standard library include if it is fully disallowed and all invalid calls were fixed.
-     * If the file is invalid after include removal  because other library features are still being used (e.g.: typedefs), the include is re-added.
+     * Checks if the standard library include can be removed, i.e., if it is fully disallowed and all invalid calls were fixed.
+     * Otherwise, the include is kept and an error is logged.
      * 
      * @param fileJp The file to modify
      * @param fixedAllCalls Flag to indicate whether all calls were fixed
+     * @returns The include to remove, if any
      */
-    private removeInclude(fileJp: FileJp, fixedAllCalls: boolean) {
-        if (!this.isLibraryFullyDisallowed()) return;
+    private prepareIncludeRemoval(fileJp: FileJp, fixedAllCalls: boolean): Include | undefined {
+        if (!this.isLibraryFullyDisallowed()) return undefined;
 
         const includeJp = Query.searchFrom(fileJp, Include, {name: this.standardLibrary}).get()[0];
         const ruleResult = this.context.getRuleResult(this.ruleID, includeJp);
 
-        if (ruleResult !== undefined) return;
+        if (ruleResult !== undefined) return undefined;
           
         if (this.filesWithRetainedHeaders.has(fileJp.name) || !fixedAllCalls) { // Keep include and log MISRA error 
             this.logDisallowedInclude(fileJp);
-        } else { 
-            includeJp.detach();
-
-            // Re-add include and log error if any other library features are still referenced
-            if (!isValidFile(fileJp)) { 
-                fileJp.addInclude(this.standardLibrary, true);
-                this.logDisallowedInclude(fileJp);
-            }
+            return undefined;
         }
+        return includeJp;
     }
 }
+
+/**
+ * Candidate replacement for the calls to a disallowed function within a file
+ */
+export interface DisallowedCallFix {
+    /**
+     * The rule that disallows the function
+     */
+    rule: DisallowedStdLibFunctionRule;
+    /**
+     * Calls to the disallowed function
+     */
+    calls: Call[];
+    /**
+     * Definition of the replacement function, if provided by the configuration file
+     */
+    functionDef?: FunctionJp;
+    /**
+     * Location of the replacement function, as specified in the configuration file, or the name of the generated replacement
+     */
+    location: string;
+    /**
+     * Whether an extern declaration of the replacement function must be added to the file
+     */
+    needsExtern: boolean;
+    /**
+     * Edits that generate the replacement in the file and rewrite the calls, if the replacement is generated by the rule
+     */
+    generate?: (transaction: MISRATransaction) => void;
+}
+
+/**
+ * Include of a fully disallowed library to remove from a file
+ */
+interface IncludeRemoval {
+    /**
+     * The rule that disallows the library
+     */
+    rule: DisallowedStdLibFunctionRule;
+    /**
+     * The include directive
+     */
+    includeJp: Include;
+}
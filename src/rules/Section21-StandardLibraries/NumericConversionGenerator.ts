@@ -0,0 +1,375 @@
+import { BinaryOp, Call, Cast, FileJp, ParenExpr, Program, Type, Vardecl } from "@specs-feup/clava/api/Joinpoints.js";
+import { NumericConversionsConfig } from "../../MISRAConfig.js";
+import { addGeneratedFile } from "../../utils/FileUtils.js";
+
+/**
+ * Conversion of a string into a value of an arithmetic type
+ */
+interface ConversionVariant {
+    /**
+     * Name of the generated function
+     */
+    name: string;
+    /**
+     * Type of the returned value
+     */
+    type: string;
+    /**
+     * Smallest value of the type, for integer types
+     */
+    min?: string;
+    /**
+     * Largest value of the type
+     */
+    max: string;
+    /**
+     * Unsigned type that holds the magnitude of integer values, or type that accumulates floating values
+     */
+    accumulator: string;
+    /**
+     * Suffix of the literals of the accumulator type
+     */
+    suffix: string;
+}
+
+/**
+ * Generator of replacements for the numeric conversion functions of <stdlib.h>: decimal, locale-independent parsers
+ * specialized for each arithmetic type, that saturate out of range values and report errors through a status function.
+ *
+ * The variant of each call is selected from the type its result is converted to (the type of the initialized variable,
+ * of the assigned object or of the cast), if it is a signed integer type for integer conversions or a floating type for atof.
+ * Otherwise, the return type of the converted function is used.
+ *
+ * Floating values are scaled by a single multiplication or division by a power of ten computed by repeated squaring,
+ * so they are within a few units in the last place of the correctly rounded value returned by strtod, but not always equal to it.
+ * Divisors beyond the range of the accumulator are applied in two steps, so that subnormal results are kept.
+ */
+export default class NumericConversionGenerator {
+    /**
+     * Generated conversions, indexed by the returned type
+     */
+    static readonly VARIANTS = new Map<string, ConversionVariant>([
+        ["signed char", { name: "misra_to_signed_char", type: "signed char", min: "SCHAR_MIN", max: "SCHAR_MAX", accumulator: "unsigned long", suffix: "UL" }],
+        ["short", { name: "misra_to_short", type: "short", min: "SHRT_MIN", max: "SHRT_MAX", accumulator: "unsigned long", suffix: "UL" }],
+        ["int", { name: "misra_to_int", type: "int", min: "INT_MIN", max: "INT_MAX", accumulator: "unsigned long", suffix: "UL" }],
+        ["long", { name: "misra_to_long", type: "long", min: "LONG_MIN", max: "LONG_MAX", accumulator: "unsigned long", suffix: "UL" }],
+        ["long long", { name: "misra_to_long_long", type: "long long", min: "LLONG_MIN", max: "LLONG_MAX", accumulator: "unsigned long long", suffix: "ULL" }],
+        ["float", { name: "misra_to_float", type: "float", max: "FLT_MAX", accumulator: "double", suffix: "" }],
+        ["double", { name: "misra_to_double", type: "double", max: "DBL_MAX", accumulator: "double", suffix: "" }],
+        ["long double", { name: "misra_to_long_double", type: "long double", max: "LDBL_MAX", accumulator: "long double", suffix: "L" }]
+    ]);
+
+    /**
+     * Return type of each disallowed conversion function
+     */
+    static readonly FUNCTION_TYPES = new Map([
+        ["atoi", "int"],
+        ["atol", "long"],
+        ["atoll", "long long"],
+        ["atof", "double"]
+    ]);
+
+    #config: NumericConversionsConfig;
+
+    /**
+     * Variants required by the calls
+     */
+    #variants = new Map<string, ConversionVariant>();
+
+    /**
+     * @param config The numeric conversions section of the configuration
+     */
+    constructor(config: NumericConversionsConfig) {
+        this.#config = config;
+    }
+
+    /**
+     * Returns the conversion that replaces the given call
+     *
+     * @param callJp A call to atoi, atol, atoll or atof
+     */
+    static getVariant(callJp: Call): ConversionVariant {
+        const functionType = NumericConversionGenerator.FUNCTION_TYPES.get(callJp.name)!;
+        const isFloating = callJp.name === "atof";
+        const targetType = getDestinationType(callJp);
+        const targetVariant = targetType !== undefined ? NumericConversionGenerator.VARIANTS.get(targetType.desugarAll.code) : undefined;
+
+        if (targetVariant !== undefined && (targetVariant.min === undefined) === isFloating) {
+            return targetVariant;
+        }
+        return NumericConversionGenerator.VARIANTS.get(functionType)!;
+    }
+
+    /**
+     * Records the conversion required by a call
+     *
+     * @param callJp A call to atoi, atol, atoll or atof
+     */
+    recordCall(callJp: Call) {
+        const variant = NumericConversionGenerator.getVariant(callJp);
+        this.#variants.set(variant.type, variant);
+    }
+
+    /**
+     * Adds the generated source file to the program, at the location specified in the configuration
+     *
+     * @param programJp The program
+     * @returns The rebuilt file, or undefined if the generated code does not compile
+     */
+    addToProgram(programJp: Program): FileJp | undefined {
+        return addGeneratedFile(programJp, this.#config.location, this.generateCode());
+    }
+
+    /**
+     * Generates the C source of the required conversions and of the status function, compatible with C90
+     */
+    generateCode(): string {
+        const variants = Array.from(NumericConversionGenerator.VARIANTS.values()).filter(variant => this.#variants.has(variant.type));
+        const lines: string[] = [
+            "/* Decimal, locale-independent replacements of the numeric conversion functions of <stdlib.h> (MISRA C:2012 Rule 21.7).",
+            " * Out of range values are saturated. The result of the last conversion is returned by misra_conversion_status:",
+            " * MISRA_CONVERSION_OK, MISRA_CONVERSION_INVALID (no digits or trailing characters) or MISRA_CONVERSION_RANGE. */",
+            "#include <limits.h>",
+            "#include <float.h>",
+            "",
+            "#define MISRA_CONVERSION_OK 0",
+            "#define MISRA_CONVERSION_INVALID 1",
+            "#define MISRA_CONVERSION_RANGE 2",
+            "",
+            "int misra_conversion_status(void);",
+            ...variants.map(variant => `${variant.type} ${variant.name}(const char *text);`),
+            "",
+            "static int misra_conversion_last_status = MISRA_CONVERSION_OK;",
+            "",
+            "int misra_conversion_status(void)",
+            "{",
+            "    return misra_conversion_last_status;",
+            "}",
+            "",
+            ...Array.from(POWERS_OF_TEN).filter(([accumulator]) => variants.some(variant => variant.min === undefined && variant.accumulator === accumulator))
+                .flatMap(([accumulator, power]) => generatePowerOfTen(accumulator, power)),
+            "static const char *misra_conversion_skip_spaces(const char *text)",
+            "{",
+            "    const char *c = text;",
+            "    while ((*c == ' ') || ((*c >= '\\t') && (*c <= '\\r'))) {",
+            "        c++;",
+            "    }",
+            "    return c;",
+            "}",
+            ""
+        ];
+
+        for (const variant of variants) {
+            lines.push(...(variant.min !== undefined ? generateIntegerConversion(variant) : generateFloatingConversion(variant)), "");
+        }
+        return lines.join("\n");
+    }
+}
+
+/**
+ * Returns the type the result of a call is converted to: the type of the initialized variable, of the assigned object or of the cast
+ */
+function getDestinationType(callJp: Call): Type | undefined {
+    let exprJp = callJp.parent;
+    while (exprJp instanceof ParenExpr) {
+        exprJp = exprJp.parent;
+    }
+
+    if (exprJp instanceof Vardecl || exprJp instanceof Cast) {
+        return exprJp.type;
+    } else if (exprJp instanceof BinaryOp && exprJp.kind === "assign") {
+        return exprJp.left.type;
+    }
+    return undefined;
+}
+
+function generateIntegerConversion(variant: ConversionVariant): string[] {
+    const { name, type, min, max, accumulator, suffix } = variant;
+    return [
+        `${type} ${name}(const char *text)`,
+        "{",
+        "    const char *c = misra_conversion_skip_spaces(text);",
+        `    ${accumulator} magnitude = 0${suffix};`,
+        `    ${accumulator} limit = (${accumulator}) ${max};`,
+        "    int status = MISRA_CONVERSION_INVALID;",
+        "    int negative = 0;",
+        `    ${type} value;`,
+        "",
+        "    if ((*c == '+') || (*c == '-')) {",
+        "        if (*c == '-') {",
+        "            negative = 1;",
+        `            limit = limit + 1${suffix};`,
+        "        }",
+        "        c++;",
+        "    }",
+        "    while ((*c >= '0') && (*c <= '9')) {",
+        `        ${accumulator} digit = (${accumulator}) *c - (${accumulator}) '0';`,
+        `        if (magnitude > ((limit - digit) / 10${suffix})) {`,
+        "            magnitude = limit;",
+        "            status = MISRA_CONVERSION_RANGE;",
+        "        } else {",
+        `            magnitude = (magnitude * 10${suffix}) + digit;`,
+        "            if (status == MISRA_CONVERSION_INVALID) {",
+        "                status = MISRA_CONVERSION_OK;",
+        "            }",
+        "        }",
+        "        c++;",
+        "    }",
+        "    c = misra_conversion_skip_spaces(c);",
+        "    if ((status == MISRA_CONVERSION_OK) && (*c != '\\0')) {",
+        "        status = MISRA_CONVERSION_INVALID;",
+        "    }",
+        "",
+        "    if (negative == 0) {",
+        `        value = (${type}) magnitude;`,
+        "    } else if (magnitude == limit) {",
+        `        value = ${min};`,
+        "    } else {",
+        `        value = -(${type}) magnitude;`,
+        "    }",
+        "    misra_conversion_last_status = status;",
+        "    return value;",
+        "}"
+    ];
+}
+
+/**
+ * Function that computes the powers of ten of each floating accumulator type, and the largest exponent they can represent
+ */
+const POWERS_OF_TEN = new Map([
+    ["double", { name: "misra_conversion_power_of_ten", maxExponent: "DBL_MAX_10_EXP", max: "DBL_MAX", suffix: "" }],
+    ["long double", { name: "misra_conversion_power_of_ten_long", maxExponent: "LDBL_MAX_10_EXP", max: "LDBL_MAX", suffix: "L" }]
+]);
+
+function generatePowerOfTen(accumulator: string, power: { name: string, maxExponent: string, suffix: string }): string[] {
+    const { name, maxExponent, suffix } = power;
+    return [
+        `/* Returns 10 raised to the given exponent, between 0 and ${maxExponent}, computed by repeated squaring */`,
+        `static ${accumulator} ${name}(int exponent)`,
+        "{",
+        `    ${accumulator} result = 1.0${suffix};`,
+        `    ${accumulator} square = 10.0${suffix};`,
+        "    int remaining = exponent;",
+        "    while (remaining > 0) {",
+        "        if ((remaining % 2) != 0) {",
+        "            result = result * square;",
+        "        }",
+        "        remaining = remaining / 2;",
+        "        if (remaining > 0) {",
+        "            square = square * square;",
+        "        }",
+        "    }",
+        "    return result;",
+        "}",
+        ""
+    ];
+}
+
+function generateFloatingConversion(variant: ConversionVariant): string[] {
+    const { name, type, max, accumulator, suffix } = variant;
+    const { name: powerOfTen, maxExponent, max: accumulatorMax } = POWERS_OF_TEN.get(accumulator)!;
+    const digitLoop = (indent: string, whenFits: string[], whenFull: string[]) => [
+        `${indent}while ((*c >= '0') && (*c <= '9')) {`,
+        `${indent}    if (value < (${accumulatorMax} / 10.0${suffix})) {`,
+        `${indent}        value = (value * 10.0${suffix}) + (${accumulator}) ((int) *c - (int) '0');`,
+        ...whenFits.map(line => `${indent}        ${line}`),
+        ...(whenFull.length > 0 ? [`${indent}    } else {`, ...whenFull.map(line => `${indent}        ${line}`)] : []),
+        `${indent}    }`,
+        `${indent}    status = MISRA_CONVERSION_OK;`,
+        `${indent}    c++;`,
+        `${indent}}`
+    ];
+
+    return [
+        `${type} ${name}(const char *text)`,
+        "{",
+        "    const char *c = misra_conversion_skip_spaces(text);",
+        `    ${accumulator} value = 0.0${suffix};`,
+        `    ${accumulator} power = 1.0${suffix};`,
+        "    int exponent = 0;",
+        "    int status = MISRA_CONVERSION_INVALID;",
+        "    int negative = 0;",
+        "",
+        "    if ((*c == '+') || (*c == '-')) {",
+        "        if (*c == '-') {",
+        "            negative = 1;",
+        "        }",
+        "        c++;",
+        "    }",
+        "    /* Digits that do not fit in the accumulator only scale the value */",
+        ...digitLoop("    ", [], ["exponent++;"]),
+        "    if (*c == '.') {",
+        "        c++;",
+        ...digitLoop("        ", ["exponent--;"], []),
+        "    }",
+        "    if ((status == MISRA_CONVERSION_OK) && ((*c == 'e') || (*c == 'E'))) {",
+        "        const char *mark = c;",
+        "        int exponentValue = 0;",
+        "        int exponentNegative = 0;",
+        "        c++;",
+        "        if ((*c == '+') || (*c == '-')) {",
+        "            if (*c == '-') {",
+        "                exponentNegative = 1;",
+        "            }",
+        "            c++;",
+        "        }",
+        "        if ((*c < '0') || (*c > '9')) {",
+        "            c = mark; /* Not an exponent */",
+        "        }",
+        "        while ((*c >= '0') && (*c <= '9')) {",
+        "            if (exponentValue < 10000) {",
+        "                exponentValue = (exponentValue * 10) + ((int) *c - (int) '0');",
+        "            }",
+        "            c++;",
+        "        }",
+        "        if (exponentNegative == 0) {",
+        "            exponent = exponent + exponentValue;",
+        "        } else {",
+        "            exponent = exponent - exponentValue;",
+        "        }",
+        "    }",
+        "    c = misra_conversion_skip_spaces(c);",
+        "    if ((status == MISRA_CONVERSION_OK) && (*c != '\\0')) {",
+        "        status = MISRA_CONVERSION_INVALID;",
+        "    }",
+        "",
+        `    if ((value > 0.0${suffix}) && (exponent > 0)) {`,
+        `        if (exponent > ${maxExponent}) {`,
+        `            value = ${max};`,
+        "            status = MISRA_CONVERSION_RANGE;",
+        "        } else {",
+        `            power = ${powerOfTen}(exponent);`,
+        `            if (value > (${max} / power)) {`,
+        `                value = ${max};`,
+        "                status = MISRA_CONVERSION_RANGE;",
+        "            } else {",
+        "                value = value * power;",
+        "            }",
+        "        }",
+        `    } else if ((value > 0.0${suffix}) && (exponent < 0)) {`,
+        "        /* Divisors beyond the range of the type are applied in two steps, so that subnormal results are kept */",
+        `        if (exponent < -${maxExponent}) {`,
+        `            value = value / ${powerOfTen}(${maxExponent});`,
+        `            exponent = exponent + ${maxExponent};`,
+        "        }",
+        `        if (exponent < -${maxExponent}) {`,
+        `            value = 0.0${suffix};`,
+        "        } else {",
+        `            value = value / ${powerOfTen}(-exponent);`,
+        "        }",
+        `        if (value == 0.0${suffix}) {`,
+        "            status = MISRA_CONVERSION_RANGE;",
+        "        }",
+        "    } else {",
+        "        /* Zero is not scaled */",
+        "    }",
+        `    if (value > ${max}) {`,
+        `        value = ${max};`,
+        "        status = MISRA_CONVERSION_RANGE;",
+        "    }",
+        "",
+        "    misra_conversion_last_status = status;",
+        `    return (negative == 0) ? (${type}) value : -(${type}) value;`,
+        "}"
+    ];
+}
@@ -0,0 +1,316 @@
+import { Call, Expression, FileJp, Program } from "@specs-feup/clava/api/Joinpoints.js";
+import { PoolAllocatorConfig } from "../../MISRAConfig.js";
+import { addGeneratedFile } from "../../utils/FileUtils.js";
+
+/**
+ * Generator of a replacement for the memory allocation functions of <stdlib.h>: fixed-size block pools in static arrays.
+ *
+ * Each pool serves the requests up to its block size. Blocks are taken from an intrusive free list (the link is stored in the free block itself)
+ * or, until every block was used once, from the next unused block of the array, so allocation takes constant time
+ * and the pools need no initialization. Requests are served by the smallest pool that fits them, falling back to the larger pools when it is exhausted.
+ * Since pointers to different arrays cannot be ordered (Rule 18.3), a released block is found by comparing it for equality with the used blocks of each pool.
+ *
+ * The block sizes are taken from the configuration or derived from a histogram of the constant sizes requested by the calls.
+ * Only the replacements of the called functions are generated.
+ */
+export default class PoolAllocatorGenerator {
+    /**
+     * Generated replacement of each memory allocation function
+     */
+    static readonly REPLACEMENTS = new Map([
+        ["malloc", "misra_pool_malloc"],
+        ["calloc", "misra_pool_calloc"],
+        ["realloc", "misra_pool_realloc"],
+        ["free", "misra_pool_free"]
+    ]);
+
+    /**
+     * Block sizes used when the sizes of some calls are unknown
+     */
+    static readonly DEFAULT_BLOCK_SIZES = [16, 64, 256];
+
+    /**
+     * Number of blocks of each pool, if not specified in the configuration
+     */
+    static readonly DEFAULT_BLOCKS_PER_POOL = 32;
+
+    /**
+     * Maximum number of pools derived from the histogram
+     */
+    static readonly MAX_POOLS = 4;
+
+    /**
+     * Granularity of the block sizes derived from the histogram, in bytes
+     */
+    static readonly BLOCK_ALIGNMENT = 8;
+
+    #config: PoolAllocatorConfig;
+
+    /**
+     * Number of calls that request each block size, after rounding to {@link BLOCK_ALIGNMENT}
+     */
+    #sizeHistogram = new Map<number, number>();
+
+    /**
+     * Number of calls whose requested size is not constant
+     */
+    #unknownSizes = 0;
+
+    /**
+     * Names of the replaced functions that are called
+     */
+    #calledFunctions = new Set<string>();
+
+    /**
+     * @param config The pool allocator section of the configuration
+     */
+    constructor(config: PoolAllocatorConfig) {
+        this.#config = config;
+    }
+
+    /**
+     * Records a call to a memory allocation function, and the size it requests in the histogram
+     *
+     * @param callJp The call
+     * @param evaluate Returns the value of a constant expression, or undefined if it cannot be computed
+     */
+    recordCall(callJp: Call, evaluate: (exprJp: Expression) => bigint | undefined) {
+        this.#calledFunctions.add(callJp.name);
+        let size: bigint | undefined;
+        if (callJp.name === "malloc" && callJp.args.length === 1) {
+            size = evaluate(callJp.args[0]);
+        } else if (callJp.name === "calloc" && callJp.args.length === 2) {
+            const count = evaluate(callJp.args[0]);
+            const elementSize = evaluate(callJp.args[1]);
+            size = count !== undefined && elementSize !== undefined ? count * elementSize : undefined;
+        } else if (callJp.name === "realloc" && callJp.args.length === 2) {
+            size = evaluate(callJp.args[1]);
+        } else { // Releases memory
+            return;
+        }
+
+        if (size === undefined || size <= 0n) {
+            this.#unknownSizes++;
+            return;
+        }
+        const alignment = BigInt(PoolAllocatorGenerator.BLOCK_ALIGNMENT);
+        const blockSize = Number((size + alignment - 1n) / alignment * alignment);
+        this.#sizeHistogram.set(blockSize, (this.#sizeHistogram.get(blockSize) ?? 0) + 1);
+    }
+
+    /**
+     * Returns the block size of each pool, in ascending order.
+     * Without sizes in the configuration, the largest requested size and the most requested sizes are selected,
+     * along with the default sizes if the size of any call is unknown.
+     */
+    get blockSizes(): number[] {
+        if (this.#config.blockSizes !== undefined) {
+            return [...new Set(this.#config.blockSizes)].sort((size1, size2) => size1 - size2);
+        }
+
+        const counts = new Map(this.#sizeHistogram);
+        if (this.#unknownSizes > 0 || counts.size === 0) {
+            PoolAllocatorGenerator.DEFAULT_BLOCK_SIZES.forEach(size => counts.set(size, (counts.get(size) ?? 0) + this.#unknownSizes));
+        }
+
+        const largestSize = Math.max(...counts.keys());
+        const mostRequested = [...counts]
+            .filter(([size]) => size !== largestSize)
+            .sort(([size1, count1], [size2, count2]) => count2 - count1 || size1 - size2)
+            .slice(0, PoolAllocatorGenerator.MAX_POOLS - 1)
+            .map(([size]) => size);
+        return [...mostRequested, largestSize].sort((size1, size2) => size1 - size2);
+    }
+
+    /**
+     * Adds the generated source file to the program, at the location specified in the configuration
+     *
+     * @param programJp The program
+     * @returns The rebuilt file, or undefined if the generated code does not compile
+     */
+    addToProgram(programJp: Program): FileJp | undefined {
+        return addGeneratedFile(programJp, this.#config.location, this.generateCode());
+    }
+
+    /**
+     * Generates the C source of the pools and of the replacements of the called functions, compatible with C90.
+     * The pools are shared by internal functions, so that only the replacements are defined with external linkage.
+     */
+    generateCode(): string {
+        const sizes = this.blockSizes;
+        const blocksPerPool = this.#config.blocksPerPool ?? PoolAllocatorGenerator.DEFAULT_BLOCKS_PER_POOL;
+        const pools = sizes.map((_, i) => i);
+        const replaced = this.#calledFunctions;
+        const needsRelease = replaced.has("free") || replaced.has("realloc");
+
+        const lines: string[] = [
+            "/* Fixed-size block pools that replace the memory allocation functions of <stdlib.h> (MISRA C:2012 Rule 21.3).",
+            ` * Block sizes: ${sizes.join(", ")} bytes, ${blocksPerPool} blocks each. */`,
+            "#include <stddef.h>",
+            ""
+        ];
+        const prototypes = new Map([
+            ["malloc", "void *misra_pool_malloc(size_t size)"],
+            ["calloc", "void *misra_pool_calloc(size_t count, size_t size)"],
+            ["realloc", "void *misra_pool_realloc(void *ptr, size_t size)"],
+            ["free", "void misra_pool_free(void *ptr)"]
+        ]);
+        [...prototypes].filter(([name]) => replaced.has(name)).forEach(([, prototype]) => lines.push(`${prototype};`));
+        lines.push("");
+
+        for (const i of pools) {
+            lines.push(
+                `union misra_pool_block_${i} {`,
+                `    union misra_pool_block_${i} *next;`,
+                `    unsigned char data[${sizes[i]}U];`,
+                "    long double alignment;",
+                "};",
+                ""
+            );
+        }
+        lines.push("static struct {");
+        pools.forEach(i => lines.push(`    union misra_pool_block_${i} blocks_${i}[${blocksPerPool}U];`));
+        lines.push("} misra_pool_storage;", "");
+        lines.push("/* Free list of each pool and number of its blocks that were used at least once */", "static struct {");
+        pools.forEach(i => lines.push(`    union misra_pool_block_${i} *list_${i};`, `    size_t used_${i};`));
+        lines.push("} misra_pool_state;", "");
+
+        lines.push(
+            "static void *misra_pool_allocate(size_t size)",
+            "{",
+            "    void *block = NULL;",
+            ...pools.flatMap(i => [
+                `    if ((block == NULL) && (size > 0U) && (size <= ${sizes[i]}U)) {`,
+                `        if (misra_pool_state.list_${i} != NULL) {`,
+                `            block = misra_pool_state.list_${i};`,
+                `            misra_pool_state.list_${i} = misra_pool_state.list_${i}->next;`,
+                `        } else if (misra_pool_state.used_${i} < ${blocksPerPool}U) {`,
+                `            block = &misra_pool_storage.blocks_${i}[misra_pool_state.used_${i}];`,
+                `            misra_pool_state.used_${i}++;`,
+                "        } else {",
+                "            /* The pool is exhausted */",
+                "        }",
+                "    }"
+            ]),
+            "    return block;",
+            "}",
+            ""
+        );
+
+        if (needsRelease) {
+            lines.push(
+                "/* Returns the pool of a block, or the number of pools if the block does not belong to any pool */",
+                "static size_t misra_pool_of(const void *ptr)",
+                "{",
+                `    size_t pool = ${sizes.length}U;`,
+                "    size_t i;",
+                ...pools.flatMap(i => [
+                    `    for (i = 0U; i < misra_pool_state.used_${i}; i++) {`,
+                    `        if (ptr == (const void *) &misra_pool_storage.blocks_${i}[i]) {`,
+                    `            pool = ${i}U;`,
+                    "        }",
+                    "    }"
+                ]),
+                "    return pool;",
+                "}",
+                "",
+                "static void misra_pool_release(void *ptr)",
+                "{",
+                "    size_t pool = misra_pool_of(ptr);",
+                ...pools.flatMap(i => [
+                    `    ${i === 0 ? "if" : "} else if"} (pool == ${i}U) {`,
+                    `        union misra_pool_block_${i} *block = (union misra_pool_block_${i} *) ptr;`,
+                    `        block->next = misra_pool_state.list_${i};`,
+                    `        misra_pool_state.list_${i} = block;`
+                ]),
+                "    } else {",
+                "        /* Null pointers and pointers not obtained from the pools are ignored */",
+                "    }",
+                "}",
+                ""
+            );
+        }
+
+        if (replaced.has("malloc")) {
+            lines.push(
+                "void *misra_pool_malloc(size_t size)",
+                "{",
+                "    return misra_pool_allocate(size);",
+                "}",
+                ""
+            );
+        }
+        if (replaced.has("calloc")) {
+            lines.push(
+                "void *misra_pool_calloc(size_t count, size_t size)",
+                "{",
+                "    void *block = NULL;",
+                "    size_t total = count * size;",
+                "    if ((count == 0U) || ((total / count) == size)) {",
+                "        block = misra_pool_allocate(total);",
+                "    }",
+                "    if (block != NULL) {",
+                "        unsigned char *bytes = (unsigned char *) block;",
+                "        size_t i;",
+                "        for (i = 0U; i < total; i++) {",
+                "            bytes[i] = 0U;",
+                "        }",
+                "    }",
+                "    return block;",
+                "}",
+                ""
+            );
+        }
+        if (replaced.has("realloc")) {
+            lines.push(
+                "void *misra_pool_realloc(void *ptr, size_t size)",
+                "{",
+                "    void *block = NULL;",
+                "    size_t pool = misra_pool_of(ptr);",
+                "    if (ptr == NULL) {",
+                "        block = misra_pool_allocate(size);",
+                "    } else if (size == 0U) {",
+                "        misra_pool_release(ptr);",
+                `    } else if (pool < ${sizes.length}U) {`,
+                "        size_t capacity = 0U;",
+                ...pools.flatMap(i => [
+                    `        ${i === 0 ? "if" : "} else if"} (pool == ${i}U) {`,
+                    `            capacity = ${sizes[i]}U;`
+                ]),
+                "        } else {",
+                "            /* Unreachable */",
+                "        }",
+                "        if (size <= capacity) {",
+                "            block = ptr;",
+                "        } else {",
+                "            block = misra_pool_allocate(size);",
+                "            if (block != NULL) {",
+                "                const unsigned char *source = (const unsigned char *) ptr;",
+                "                unsigned char *target = (unsigned char *) block;",
+                "                size_t i;",
+                "                for (i = 0U; i < capacity; i++) {",
+                "                    target[i] = source[i];",
+                "                }",
+                "                misra_pool_release(ptr);",
+                "            }",
+                "        }",
+                "    } else {",
+                "        /* Not obtained from the pools */",
+                "    }",
+                "    return block;",
+                "}",
+                ""
+            );
+        }
+        if (replaced.has("free")) {
+            lines.push(
+                "void misra_pool_free(void *ptr)",
+                "{",
+                "    misra_pool_release(ptr);",
+                "}",
+                ""
+            );
+        }
+        return lines.join("\n");
+    }
+}
@@ -1,8 +1,14 @@
+import { Call, Program } from "@specs-feup/clava/api/Joinpoints.js";
 import { AnalysisType } from "../../MISRA.js";
+import { DisallowedFunctionFix } from "../../MISRAConfig.js";
 import DisallowedStdLibFunctionRule from "./DisallowedStdLibFunctionRule.js";
+import PoolAllocatorGenerator from "./PoolAllocatorGenerator.js";
 
 /**
  * MISRA-C Rule 21.3: The memory allocation and deallocation functions of <stdlib.h> shall not be used
+ * 
+ * If the configuration requests a pool allocator, the calls to the functions without an entry in 'disallowedFunctions' 
+ * are replaced by calls to a generated module of fixed-size block pools.
  */
 export default class Rule_21_3_NoDynamicMemory extends DisallowedStdLibFunctionRule {
     /**
@@ -21,10 +27,66 @@ export default class Rule_21_3_NoDynamicMemory extends DisallowedStdLibFunctionR
      */
     readonly analysisType = AnalysisType.SINGLE_TRANSLATION_UNIT;
 
+    /**
+     * Whether the pool allocator requested in the configuration is available in the program
+     */
+    #hasPoolAllocator = false;
+
     /**
      * @returns Rule identifier according to MISRA-C:2012
      */
     override get name(): string {
         return "21.3";
     }    
+
+    /**
+     * Checks if the call is replaced by the pool allocator, i.e., if it is requested and the function has no entry in 'disallowedFunctions'
+     * 
+     * @param functionName Name of the disallowed function
+     */
+    private usesPoolAllocator(functionName: string): boolean {
+        return this.context.config?.poolAllocator !== undefined && 
+            PoolAllocatorGenerator.REPLACEMENTS.has(functionName) && 
+            !this.hasConfiguredReplacement(functionName);
+    }
+
+    /**
+     * Generates the pool allocator requested in the configuration, unless a file already exists at its location,
+     * in which case it is used only if it defines the replacements of the calls. 
+     * The block sizes not specified in the configuration are derived from the sizes requested by the calls.
+     * 
+     * @param programJp The program
+     */
+    protected override prepareReplacements(programJp: Program) {
+        const poolConfig = this.context.config?.poolAllocator;
+        const poolCalls = Array.from(this.invalidFiles.values()).flat().filter(callJp => this.usesPoolAllocator(callJp.name));
+        if (poolConfig === undefined || poolCalls.length === 0) {
+            return;
+        }
+
+        const replacements = [...new Set(poolCalls.map(callJp => PoolAllocatorGenerator.REPLACEMENTS.get(callJp.name)!))];
+        this.#hasPoolAllocator = this.provideGeneratedFile(programJp, poolConfig.location, replacements, () => {
+            const generator = new PoolAllocatorGenerator(poolConfig);
+            poolCalls.forEach(callJp => generator.recordCall(callJp, exprJp => this.context.essentialTypes.getConstantValue(exprJp)));
+            return generator.addToProgram(programJp);
+        });
+    }
+
+    /**
+     * Retrieves the replacement of the given call from the pool allocator, if it replaces the function, or from the configuration file
+     * @param callJp - Joinpoint where the violation was detected
+     * @return The replacement for the violation, or `undefined` if no applicable fix is found.
+     */
+    protected override getFixFromConfig(callJp: Call): DisallowedFunctionFix | undefined {
+        if (!this.usesPoolAllocator(callJp.name)) {
+            return super.getFixFromConfig(callJp);
+        }
+
+        const location = this.context.config!.poolAllocator!.location;
+        if (!this.#hasPoolAllocator) {
+            this.logDisallowedCall(callJp, `${this.getErrorMsgPrefix(callJp)} The pool allocator could not be generated at \'${location}\', or the file there does not define the replacements.`);
+            return undefined;
+        }
+        return { replacement: PoolAllocatorGenerator.REPLACEMENTS.get(callJp.name)!, location };
+    }
 }
@@ -1,8 +1,14 @@
+import { Call, Program } from "@specs-feup/clava/api/Joinpoints.js";
 import { AnalysisType } from "../../MISRA.js";
+import { DisallowedFunctionFix } from "../../MISRAConfig.js";
 import DisallowedStdLibFunctionRule from "./DisallowedStdLibFunctionRule.js";
+import NumericConversionGenerator from "./NumericConversionGenerator.js";
 
 /**
  * MISRA-C Rule 21.7: The atof, atoi, atol and atoll functions of <stdlib.h> shall not be used.
+ * 
+ * If the configuration requests numeric conversions, the calls to the functions without an entry in 'disallowedFunctions' 
+ * are replaced by calls to generated conversions, specialized for the type their result is converted to.
  */
 export default class Rule_21_7_NoNumericStringConversions extends DisallowedStdLibFunctionRule {
     /**
@@ -20,10 +26,72 @@ export default class Rule_21_7_NoNumericStringConversions extends DisallowedStdL
      */
     readonly analysisType = AnalysisType.SINGLE_TRANSLATION_UNIT;
 
+    /**
+     * Whether the numeric conversions requested in the configuration are available in the program
+     */
+    #hasConversions = false;
+
     /**
      * @returns Rule identifier according to MISRA-C:2012
      */
     override get name(): string {
         return "21.7";
     }    
-}
\ No newline at end of file
+
+    /**
+     * Checks if the call is replaced by a generated conversion, i.e., if they are requested and the function has no entry in 'disallowedFunctions'
+     * 
+     * @param functionName Name of the disallowed function
+     */
+    private usesGeneratedConversions(functionName: string): boolean {
+        return this.context.config?.numericConversions !== undefined && !this.hasConfiguredReplacement(functionName);
+    }
+
+    /**
+     * Generates the conversions required by the calls, unless a file already exists at the location requested in the configuration,
+     * in which case it is used only if it defines the conversions required by the calls
+     * 
+     * @param programJp The program
+     */
+    protected override prepareReplacements(programJp: Program) {
+        const conversionsConfig = this.context.config?.numericConversions;
+        const conversionCalls = Array.from(this.invalidFiles.values()).flat().filter(callJp => this.usesGeneratedConversions(callJp.name));
+        if (conversionsConfig === undefined || conversionCalls.length === 0) {
+            return;
+        }
+
+        const conversions = [...new Set(conversionCalls.map(callJp => NumericConversionGenerator.getVariant(callJp).name))];
+        this.#hasConversions = this.provideGeneratedFile(programJp, conversionsConfig.location, conversions, () => {
+            const generator = new NumericConversionGenerator(conversionsConfig);
+            conversionCalls.forEach(callJp => generator.recordCall(callJp));
+            return generator.addToProgram(programJp);
+        });
+    }
+
+    /**
+     * Groups the calls replaced by generated conversions by variant, since calls of the same function may require different variants
+     * 
+     * @param callJp The disallowed call
+     */
+    protected override getReplacementGroup(callJp: Call): string {
+        return this.usesGeneratedConversions(callJp.name) ? NumericConversionGenerator.getVariant(callJp).name : callJp.name;
+    }
+
+    /**
+     * Retrieves the conversion that replaces the given call, if they are generated, or the replacement from the configuration file
+     * @param callJp - Joinpoint where the violation was detected
+     * @return The replacement for the violation, or `undefined` if no applicable fix is found.
+     */
+    protected override getFixFromConfig(callJp: Call): DisallowedFunctionFix | undefined {
+        if (!this.usesGeneratedConversions(callJp.name)) {
+            return super.getFixFromConfig(callJp);
+        }
+
+        const location = this.context.config!.numericConversions!.location;
+        if (!this.#hasConversions) {
+            this.logDisallowedCall(callJp, `${this.getErrorMsgPrefix(callJp)} The numeric conversions could not be generated at \'${location}\', or the file there does not define them.`);
+            return undefined;
+        }
+        return { replacement: NumericConversionGenerator.getVariant(callJp).name, location };
+    }
+}
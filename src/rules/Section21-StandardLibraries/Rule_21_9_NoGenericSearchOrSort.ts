@@ -1,21 +1,29 @@
+import { ArrayType, BuiltinType, Call, Expression, FileJp, FunctionJp, FunctionType, PointerType, Type, UnaryExprOrType, Varref } from "@specs-feup/clava/api/Joinpoints.js";
+import ClavaJoinPoints from "@specs-feup/clava/api/clava/ClavaJoinPoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
 import { AnalysisType } from "../../MISRA.js";
-import DisallowedStdLibFunctionRule from "./DisallowedStdLibFunctionRule.js";
+import DisallowedStdLibFunctionRule, { DisallowedCallFix } from "./DisallowedStdLibFunctionRule.js";
+import { generateSearch, generateSort } from "./SpecializedSortSearch.js";
+import { skipParentheses } from "../../utils/EssentialTypeUtils.js";
 
 /**
  * MISRA-C Rule 21.9: The library functions bsearch and qsort of <stdlib.h> shall not be used.
+ *
+ * Calls without an entry in 'disallowedFunctions' whose element type and comparison function are known
+ * are replaced by calls to sort and search functions generated for them, in the same file.
  */
 export default class Rule_21_9_NoGenericSearchOrSort extends DisallowedStdLibFunctionRule {
     /**
-     * The name of the standard library 
+     * The name of the standard library
      */
     protected standardLibrary = "stdlib.h";
 
     /**
-     * Names of functions from {@link standardLibrary} that are forbidden. 
+     * Names of functions from {@link standardLibrary} that are forbidden.
      * If the set is empty, all functions from {@link standardLibrary} are forbidden.
      */
     protected invalidFunctions = new Set(["bsearch", "qsort"]);
-    
+
     /**
      * Scope of analysis
      */
@@ -26,5 +34,134 @@ export default class Rule_21_9_NoGenericSearchOrSort extends DisallowedStdLibFun
      */
     override get name(): string {
         return "21.9";
-    }    
+    }
+
+    /**
+     * Builds a candidate for each pair of element type and comparison function of the calls that can be specialized.
+     * Each candidate inserts the specialized function before the function of its first call and rewrites the calls,
+     * dropping the size and comparison function arguments.
+     *
+     * @param invalidCalls The disallowed calls of the file
+     * @returns The candidate fixes, each with the edits that generate its replacement
+     */
+    protected override prepareGeneratedFixes(invalidCalls: Call[]): DisallowedCallFix[] {
+        const candidates = new Map<string, DisallowedCallFix>();
+        const generatedNames = new Set<string>();
+
+        for (const callJp of invalidCalls) {
+            const specialization = this.getSpecialization(callJp);
+            if (specialization === undefined) {
+                continue;
+            }
+
+            const key = `${callJp.name}|${specialization.comparator.name}|${specialization.elementType}`;
+            const candidate = candidates.get(key);
+            if (candidate) {
+                candidate.calls.push(callJp);
+                continue;
+            }
+
+            const fileJp = callJp.getAncestor("file") as FileJp;
+            const name = generateName(fileJp, `misra_${callJp.name}_${specialization.comparator.name}`, generatedNames);
+            const definition = callJp.name === "qsort" ?
+                generateSort(name, specialization.elementType, specialization.comparator.name) :
+                generateSearch(name, specialization.elementType, specialization.comparator.name);
+            const calls = [callJp];
+
+            candidates.set(key, {
+                rule: this,
+                calls,
+                location: name,
+                needsExtern: false,
+                generate: (transaction) => {
+                    const enclosingFunction = calls[0].getAncestor("function") as FunctionJp;
+                    transaction.insertBefore(enclosingFunction, ClavaJoinPoints.stmtLiteral(definition));
+                    for (const specializedCall of calls) {
+                        const args = specializedCall.args;
+                        const newArgs = specializedCall.name === "qsort" ? [args[0], args[1]] : [args[0], args[1], args[2]];
+                        const newCall = ClavaJoinPoints.exprLiteral(`${name}(${newArgs.map(argJp => argJp.code).join(", ")})`, specializedCall.type);
+                        transaction.replaceWith(specializedCall, newCall);
+                    }
+                }
+            });
+        }
+        return Array.from(candidates.values());
+    }
+
+    /**
+     * Returns the element type and the comparison function of a call, if it can be replaced by a specialized function:
+     * the function has no entry in 'disallowedFunctions', was not marked as unfixable, the comparison function is named directly,
+     * and the size argument is the size of the elements of the array
+     *
+     * @param callJp The call to qsort or bsearch
+     */
+    private getSpecialization(callJp: Call): { elementType: string, comparator: FunctionJp } | undefined {
+        const argsCount = callJp.name === "qsort" ? 4 : 5;
+        if (this.hasConfiguredReplacement(callJp.name) || this.unresolvedCalls.has(callJp.name) || callJp.args.length !== argsCount) {
+            return undefined;
+        }
+
+        const [baseJp, , sizeJp, comparatorJp] = callJp.args.slice(argsCount - 4);
+        const comparatorRef = skipParentheses(comparatorJp);
+        if (!(comparatorRef instanceof Varref && comparatorRef.decl instanceof FunctionJp)) {
+            return undefined;
+        }
+
+        const elementType = getElementType(baseJp.type);
+        if (elementType === undefined || !isElementSize(sizeJp, baseJp, elementType)) {
+            return undefined;
+        }
+        return { elementType: elementType.code, comparator: comparatorRef.decl };
+    }
+}
+
+/**
+ * Returns the type of the elements of an array or of the objects pointed by a pointer,
+ * or undefined if they are not complete object types that can be declared by prefixing a name
+ */
+function getElementType(type: Type): Type | undefined {
+    const baseType = type instanceof PointerType || type instanceof ArrayType ? type : type.desugarAll;
+    const elementType = baseType instanceof PointerType ? baseType.pointee : baseType instanceof ArrayType ? baseType.elementType : undefined;
+    if (elementType === undefined) {
+        return undefined;
+    }
+
+    const desugaredType = elementType.desugarAll;
+    const isVoid = desugaredType instanceof BuiltinType && desugaredType.isVoid;
+    if (isVoid || desugaredType instanceof FunctionType || desugaredType instanceof ArrayType || /[()[\]]/.test(elementType.code)) {
+        return undefined;
+    }
+    return elementType;
+}
+
+/**
+ * Checks if the size argument of a call is the size of the elements of its array: sizeof of the element type,
+ * of the first element or of the dereferenced array
+ */
+function isElementSize(sizeJp: Expression, baseJp: Expression, elementType: Type): boolean {
+    const sizeOfJp = skipParentheses(sizeJp);
+    if (!(sizeOfJp instanceof UnaryExprOrType && sizeOfJp.kind === "sizeof")) {
+        return false;
+    }
+
+    const typeKey = (type: Type) => type.desugarAll.code.replace(/\b(const|volatile)\s+/g, "");
+    if (sizeOfJp.argType !== undefined && typeKey(sizeOfJp.argType) === typeKey(elementType)) {
+        return true;
+    }
+    const operand = sizeOfJp.code.replace(/\s/g, "").replace(/^sizeof/, "");
+    const base = baseJp.code.replace(/\s/g, "");
+    return [`(${base}[0])`, `${base}[0]`, `(*${base})`, `*${base}`].includes(operand);
+}
+
+/**
+ * Returns the given name, followed by a suffix if it is already used by a function of the file or by another generated function
+ */
+function generateName(fileJp: FileJp, name: string, generatedNames: Set<string>): string {
+    const isUsed = (candidate: string) => generatedNames.has(candidate) || Query.searchFrom(fileJp, FunctionJp, {name: candidate}).get().length > 0;
+    let newName = name;
+    for (let i = 1; isUsed(newName); i++) {
+        newName = `${name}_${i}`;
+    }
+    generatedNames.add(newName);
+    return newName;
 }
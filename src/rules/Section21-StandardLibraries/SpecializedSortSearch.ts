@@ -0,0 +1,181 @@
+/**
+ * Generators of sort and search functions specialized for an element type and a comparison function,
+ * that replace the calls to qsort and bsearch. The comparison function is called directly, instead of through a pointer,
+ * and the elements are accessed as typed objects, instead of through their size in bytes.
+ */
+
+/**
+ * Maximum number of ranges waiting to be sorted. Since the smaller partition is always sorted first,
+ * the number of pending ranges never exceeds the number of bits of size_t
+ */
+const SORT_STACK_SIZE = 64;
+
+/**
+ * Maximum size of the ranges sorted by insertion
+ */
+const INSERTION_SORT_CUTOFF = 16;
+
+/**
+ * Generates a non-recursive introsort: quicksort with median-of-three partitions and an explicit stack,
+ * that sorts small ranges by insertion and switches to heapsort on ranges whose partitions were too unbalanced.
+ * The generated code is compatible with C90.
+ *
+ * @param name Name of the generated function
+ * @param elementType Type of the elements
+ * @param comparator Name of the comparison function, with the signature of the comparison functions of qsort
+ * @returns The definition of the function, with parameters `(elementType *base, size_t count)`
+ */
+export function generateSort(name: string, elementType: string, comparator: string): string {
+    const swap = (first: string, second: string, indent: string) => [
+        `${indent}item = base[${first}];`,
+        `${indent}base[${first}] = base[${second}];`,
+        `${indent}base[${second}] = item;`
+    ];
+    const push = (low: string, high: string, indent: string) => [
+        `${indent}lows[top] = ${low};`,
+        `${indent}highs[top] = ${high};`,
+        `${indent}depths[top] = depth - 1U;`,
+        `${indent}top++;`
+    ];
+
+    return [
+        `static void ${name}(${elementType} *base, size_t count)`,
+        "{",
+        `    size_t lows[${SORT_STACK_SIZE}U];`,
+        `    size_t highs[${SORT_STACK_SIZE}U];`,
+        `    size_t depths[${SORT_STACK_SIZE}U];`,
+        "    size_t top = 0U;",
+        "    size_t depthLimit = 0U;",
+        "    size_t n;",
+        `    ${elementType} item;`,
+        "",
+        "    for (n = count; n > 1U; n = n / 2U) {",
+        "        depthLimit += 2U;",
+        "    }",
+        "    if (count > 1U) {",
+        "        lows[0] = 0U;",
+        "        highs[0] = count;",
+        "        depths[0] = depthLimit;",
+        "        top = 1U;",
+        "    }",
+        "    while (top > 0U) {",
+        "        size_t low;",
+        "        size_t high;",
+        "        size_t depth;",
+        "        top--;",
+        "        low = lows[top];",
+        "        high = highs[top];",
+        "        depth = depths[top];",
+        "",
+        `        if ((high - low) <= ${INSERTION_SORT_CUTOFF}U) {`,
+        "            size_t i;",
+        "            for (i = low + 1U; i < high; i++) {",
+        "                size_t j = i;",
+        "                item = base[i];",
+        "                while (j > low) {",
+        `                    if (${comparator}(&item, &base[j - 1U]) < 0) {`,
+        "                        base[j] = base[j - 1U];",
+        "                        j--;",
+        "                    } else {",
+        "                        break;",
+        "                    }",
+        "                }",
+        "                base[j] = item;",
+        "            }",
+        "        } else if (depth == 0U) {",
+        "            size_t start = (high - low) / 2U;",
+        "            size_t end = high - low;",
+        "            while (end > 1U) {",
+        "                size_t root;",
+        "                size_t child;",
+        "                if (start > 0U) {",
+        "                    start--;",
+        "                    root = start;",
+        "                } else {",
+        "                    end--;",
+        ...swap("low", "low + end", "                    "),
+        "                    root = 0U;",
+        "                }",
+        "                child = (2U * root) + 1U;",
+        "                while (child < end) {",
+        "                    if ((child + 1U) < end) {",
+        `                        if (${comparator}(&base[low + child], &base[low + child + 1U]) < 0) {`,
+        "                            child++;",
+        "                        }",
+        "                    }",
+        `                    if (${comparator}(&base[low + root], &base[low + child]) < 0) {`,
+        ...swap("low + root", "low + child", "                        "),
+        "                        root = child;",
+        "                        child = (2U * root) + 1U;",
+        "                    } else {",
+        "                        child = end;",
+        "                    }",
+        "                }",
+        "            }",
+        "        } else {",
+        "            size_t middle = low + ((high - low) / 2U);",
+        "            size_t last = high - 1U;",
+        "            size_t store = low;",
+        "            size_t i;",
+        `            if (${comparator}(&base[middle], &base[low]) < 0) {`,
+        ...swap("middle", "low", "                "),
+        "            }",
+        `            if (${comparator}(&base[last], &base[low]) < 0) {`,
+        ...swap("last", "low", "                "),
+        "            }",
+        `            if (${comparator}(&base[middle], &base[last]) < 0) {`,
+        ...swap("middle", "last", "                "),
+        "            }",
+        "            for (i = low; i < last; i++) {",
+        `                if (${comparator}(&base[i], &base[last]) < 0) {`,
+        ...swap("i", "store", "                    "),
+        "                    store++;",
+        "                }",
+        "            }",
+        ...swap("store", "last", "            "),
+        "            if ((store - low) < (high - store - 1U)) {",
+        ...push("store + 1U", "high", "                "),
+        ...push("low", "store", "                "),
+        "            } else {",
+        ...push("low", "store", "                "),
+        ...push("store + 1U", "high", "                "),
+        "            }",
+        "        }",
+        "    }",
+        "}",
+        ""
+    ].join("\n");
+}
+
+/**
+ * Generates an iterative binary search, compatible with C90
+ *
+ * @param name Name of the generated function
+ * @param elementType Type of the elements
+ * @param comparator Name of the comparison function, with the signature of the comparison functions of bsearch
+ * @returns The definition of the function, with parameters `(const void *key, elementType *base, size_t count)`.
+ * As bsearch, it returns `void *`, so that the replaced call keeps its type (e.g., when assigned to a pointer of another type)
+ */
+export function generateSearch(name: string, elementType: string, comparator: string): string {
+    return [
+        `static void *${name}(const void *key, ${elementType} *base, size_t count)`,
+        "{",
+        `    ${elementType} *found = NULL;`,
+        "    size_t low = 0U;",
+        "    size_t high = count;",
+        "    while ((found == NULL) && (low < high)) {",
+        "        size_t middle = low + ((high - low) / 2U);",
+        `        int order = ${comparator}(key, &base[middle]);`,
+        "        if (order < 0) {",
+        "            high = middle;",
+        "        } else if (order > 0) {",
+        "            low = middle + 1U;",
+        "        } else {",
+        "            found = &base[middle];",
+        "        }",
+        "    }",
+        "    return (void *)found;",
+        "}",
+        ""
+    ].join("\n");
+}
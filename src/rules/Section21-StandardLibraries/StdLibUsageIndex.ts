@@ -0,0 +1,149 @@
+import { Call, FileJp, Program } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import path from "path";
+
+/**
+ * Functions of a standard library that are disallowed by a rule
+ */
+interface DispatchEntry {
+    /**
+     * Identifier of the rule
+     */
+    ruleID: string;
+    /**
+     * Names of the disallowed functions. If the set is empty, all functions of the library are disallowed.
+     */
+    functions: Set<string>;
+}
+
+/**
+ * Usage of the standard libraries in the program, shared by the rules that disallow library functions.
+ *
+ * Every call of the program is visited once and classified through a dispatch table that maps each header to the rules that restrict it,
+ * producing the worklists (disallowed calls per file) of all rules at once.
+ */
+export default class StdLibUsageIndex {
+    /**
+     * Rules that restrict each header
+     */
+    #dispatchTable = new Map<string, DispatchEntry[]>();
+
+    /**
+     * Disallowed calls per file, for each rule
+     */
+    #worklists: Map<string, Map<FileJp, Call[]>> | undefined = undefined;
+
+    /**
+     * Iteration in which the worklists were computed
+     */
+    #iteration: number | undefined = undefined;
+
+    /**
+     * Iteration in which the violations of the indexed rules were corrected
+     */
+    appliedIteration: number | undefined = undefined;
+
+    /**
+     * Registers the functions of a library that are disallowed by a rule
+     *
+     * @param ruleID Identifier of the rule
+     * @param header The name of the standard library header
+     * @param functions Names of the disallowed functions. If the set is empty, all functions of the library are disallowed.
+     */
+    register(ruleID: string, header: string, functions: Set<string>) {
+        const entries = this.#dispatchTable.get(header) ?? [];
+        if (!entries.some(entry => entry.ruleID === ruleID)) {
+            entries.push({ ruleID, functions });
+        }
+        this.#dispatchTable.set(header, entries);
+        this.invalidate();
+    }
+
+    /**
+     * Discards the computed worklists, e.g., after changing the files
+     */
+    invalidate() {
+        this.#worklists = undefined;
+        this.#iteration = undefined;
+    }
+
+    /**
+     * Returns the files that include the header restricted by the rule, with their disallowed calls.
+     * Files that include a fully disallowed library are listed even without calls.
+     * The worklists of all rules are computed in a single pass, once per iteration.
+     *
+     * @param ruleID Identifier of the rule
+     * @param iteration The current iteration
+     */
+    getWorklist(ruleID: string, iteration: number): Map<FileJp, Call[]> {
+        if (this.#worklists === undefined || this.#iteration !== iteration) {
+            this.#worklists = this.computeWorklists();
+            this.#iteration = iteration;
+        }
+        return this.#worklists.get(ruleID) ?? new Map<FileJp, Call[]>();
+    }
+
+    private computeWorklists(): Map<string, Map<FileJp, Call[]>> {
+        const worklists = new Map<string, Map<FileJp, Call[]>>();
+        for (const entries of this.#dispatchTable.values()) {
+            entries.forEach(entry => worklists.set(entry.ruleID, new Map()));
+        }
+
+        const files = Query.searchFrom(Query.root() as Program, FileJp).get();
+        const programHeaders = new Set(files.filter(fileJp => fileJp.isHeader).map(fileJp => path.resolve(fileJp.filepath)));
+
+        for (const fileJp of files) {
+            const includes = StdLibUsageIndex.getStandardIncludes(fileJp, programHeaders);
+            const referencedHeaders = [...this.#dispatchTable.keys()].filter(header => includes.has(header));
+            if (referencedHeaders.length === 0) {
+                continue;
+            }
+
+            // Files that include a fully disallowed library are always part of the worklist
+            for (const header of referencedHeaders) {
+                this.#dispatchTable.get(header)!
+                    .filter(entry => entry.functions.size === 0)
+                    .forEach(entry => worklists.get(entry.ruleID)!.set(fileJp, []));
+            }
+
+            for (const callJp of Query.searchFrom(fileJp, Call).get()) {
+                // Functions declared outside system headers (e.g., in a user 'stdlib.h') are not library functions
+                const functionJp = callJp.function;
+                if (!functionJp?.isInSystemHeader) {
+                    continue;
+                }
+
+                const header = path.basename(functionJp.filepath);
+                if (!referencedHeaders.includes(header)) {
+                    continue;
+                }
+
+                for (const entry of this.#dispatchTable.get(header)!) {
+                    if (entry.functions.size > 0 && !entry.functions.has(callJp.name)) {
+                        continue;
+                    }
+                    const fileWorklist = worklists.get(entry.ruleID)!;
+                    const calls = fileWorklist.get(fileJp) ?? [];
+                    calls.push(callJp);
+                    fileWorklist.set(fileJp, calls);
+                }
+            }
+        }
+        return worklists;
+    }
+
+    /**
+     * Returns the names of the standard headers included by the file.
+     * An include names a standard header if its name has no folder and it does not resolve to a header of the program,
+     * so that e.g. a user header 'utils/stdlib.h', or a 'stdlib.h' next to the file, is not taken as the standard '<stdlib.h>'.
+     *
+     * @param fileJp The including file
+     * @param programHeaders Absolute paths of the headers of the program
+     */
+    private static getStandardIncludes(fileJp: FileJp, programHeaders: Set<string>): Set<string> {
+        return new Set(fileJp.includes
+            .filter(includeJp => path.basename(includeJp.name) === includeJp.name)
+            .filter(includeJp => includeJp.isAngled || !programHeaders.has(path.resolve(path.dirname(fileJp.filepath), includeJp.name)))
+            .map(includeJp => includeJp.name));
+    }
+}
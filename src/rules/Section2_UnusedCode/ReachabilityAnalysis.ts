@@ -0,0 +1,194 @@
+import { Call, DeclStmt, EnumDecl, FunctionJp, Joinpoint, Param, QualType, RecordJp, StorageClass, TypedefDecl, Vardecl, Varref } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import MISRAContext from "../../MISRAContext.js";
+import { getReferencedTypeDecls } from "../../utils/TypeDeclUtils.js";
+import { isTagDecl } from "../../utils/JoinpointUtils.js";
+import { getParamReferences } from "../../utils/FunctionUtils.js";
+import { isExternalLinkageIdentifier } from "../../utils/IdentifierUtils.js";
+import { resetCaches } from "../../utils/ProgramUtils.js";
+
+/**
+ * Whole-program reachability of the file scope declarations, shared by the rules on unused code.
+ *
+ * Starting from the roots ('main' and the configured entry points or, if the program has none, every definition with external linkage),
+ * the closure of the live functions, objects, typedefs and tags is computed in a single sweep, once per iteration.
+ * Declarations are grouped by name, so that all declarations of a live identifier (e.g., prototypes and forward declarations) are kept.
+ * Everything else is unreachable and is removed in a single batch, so that removals that make other declarations unused
+ * (e.g., a typedef only used by an unreachable function) do not require additional correction iterations.
+ *
+ * The analysis is only performed if the configuration has a 'reachability' section.
+ */
+export default class ReachabilityAnalysis {
+    /**
+     * Whether unused parameters are removed in the same iteration, so that their types are not kept alive by them
+     */
+    #removesUnusedParams: boolean;
+
+    /**
+     * Iteration in which the unreachable declarations were computed
+     */
+    #iteration: number | undefined = undefined;
+
+    /**
+     * Unreachable declarations, in the order they appear in the program
+     */
+    #unreachableDecls: Joinpoint[] = [];
+
+    /**
+     * Identifiers of the unreachable declarations
+     */
+    #unreachableIds = new Set<string>();
+
+    /**
+     * Iteration in which the unreachable declarations were removed
+     */
+    appliedIteration: number | undefined = undefined;
+
+    /**
+     * @param removesUnusedParams Whether unused parameters are removed in the same iteration (Rule 2.7)
+     */
+    constructor(removesUnusedParams: boolean) {
+        this.#removesUnusedParams = removesUnusedParams;
+    }
+
+    /**
+     * Checks if the given declaration is not reachable from the roots of the program.
+     * Declarations created after the analysis of the current iteration are considered reachable.
+     *
+     * @param $jp The declaration
+     * @param context The shared context, with the configuration and the current iteration
+     */
+    isUnreachable($jp: Joinpoint, context: MISRAContext): boolean {
+        if (context.config?.reachability === undefined) {
+            return false;
+        }
+        this.update(context);
+        return this.#unreachableIds.has($jp.astId);
+    }
+
+    /**
+     * Removes every unreachable declaration of the program
+     *
+     * @param context The shared context, with the configuration and the current iteration
+     * @param isKept Checks if an unreachable declaration must be kept (e.g., when it is covered by an approved deviation)
+     * @returns The number of removed declarations
+     */
+    removeUnreachableDecls(context: MISRAContext, isKept: (declJp: Joinpoint) => boolean = () => false): number {
+        if (context.config?.reachability === undefined) {
+            return 0;
+        }
+        this.update(context);
+
+        const root = Query.root() as Joinpoint;
+        let removed = 0;
+        for (const declJp of this.#unreachableDecls) {
+            if (!root.contains(declJp) || isKept(declJp)) { // Already removed along with an enclosing declaration, or kept by the caller
+                continue;
+            }
+            const parentJp = declJp.parent;
+            const removedJp = parentJp instanceof DeclStmt && parentJp.decls.length === 1 ? parentJp : declJp;
+            removedJp.detach();
+            removed++;
+        }
+        if (removed > 0) {
+            resetCaches();
+        }
+        return removed;
+    }
+
+    private update(context: MISRAContext) {
+        if (this.#iteration === context.iteration) {
+            return;
+        }
+        this.#unreachableDecls = this.findUnreachableDecls(context.config!.reachability!.entryPoints);
+        this.#unreachableIds = new Set(this.#unreachableDecls.map(declJp => declJp.astId));
+        this.#iteration = context.iteration;
+    }
+
+    private findUnreachableDecls(entryPoints: string[]): Joinpoint[] {
+        const isFileScope = (jp: Joinpoint) => jp.getAncestor("function") === undefined;
+        const decls: Joinpoint[] = [
+            ...Query.search(FunctionJp, (functionJp: FunctionJp) => !functionJp.isInSystemHeader).get(),
+            ...Query.search(Vardecl, (varJp: Vardecl) => !(varJp instanceof Param) && isFileScope(varJp)).get(),
+            ...Query.search(TypedefDecl, (typedefJp: TypedefDecl) => isFileScope(typedefJp)).get(),
+            ...Query.search(RecordJp, (recordJp: RecordJp) => isFileScope(recordJp) && recordJp.getAncestor("record") === undefined).get(),
+            ...Query.search(EnumDecl, (enumJp: EnumDecl) => isFileScope(enumJp) && enumJp.getAncestor("record") === undefined).get()
+        ];
+
+        const declsByKey = new Map<string, Joinpoint[]>();
+        for (const declJp of decls) {
+            const key = getDeclKey(declJp);
+            declsByKey.set(key, [...(declsByKey.get(key) ?? []), declJp]);
+        }
+
+        const liveKeys = new Set<string>();
+        const pending: Joinpoint[] = [];
+        const markLive = (declJp: Joinpoint) => {
+            const key = getDeclKey(declJp);
+            if (!liveKeys.has(key)) {
+                liveKeys.add(key);
+                pending.push(...(declsByKey.get(key) ?? []));
+            }
+        };
+
+        // Roots
+        const entryNames = new Set(["main", ...entryPoints]);
+        const entryFunctions = decls.filter(declJp => declJp instanceof FunctionJp && declJp.isImplementation && entryNames.has(declJp.name));
+        const roots = entryFunctions.length > 0 ? entryFunctions : decls.filter(declJp => isExternalLinkageIdentifier(declJp));
+        roots.forEach(markLive);
+        // Volatile objects may be accessed outside the program
+        decls.filter(declJp => declJp instanceof Vardecl && isVolatile(declJp)).forEach(markLive);
+
+        while (pending.length > 0) {
+            for (const nodeJp of this.getReferencingNodes(pending.pop()!)) {
+                if (nodeJp instanceof Call && nodeJp.function !== undefined) {
+                    markLive(nodeJp.function);
+                } else if (nodeJp instanceof Varref) {
+                    const refDecl = nodeJp.getValue("decl");
+                    if (refDecl instanceof FunctionJp || (refDecl instanceof Vardecl && !(refDecl instanceof Param) &&
+                        (isFileScope(refDecl) || refDecl.storageClass === StorageClass.EXTERN))) {
+                        markLive(refDecl);
+                    }
+                }
+                getReferencedTypeDecls(nodeJp).forEach(markLive);
+            }
+        }
+        return decls.filter(declJp => !liveKeys.has(getDeclKey(declJp)));
+    }
+
+    /**
+     * Returns the nodes of a live declaration that may reference other declarations.
+     * Unused parameters of function definitions are skipped if they are removed in the same iteration.
+     */
+    private getReferencingNodes(declJp: Joinpoint): Joinpoint[] {
+        const nodes = [declJp, ...declJp.descendants];
+        if (!(this.#removesUnusedParams && declJp instanceof FunctionJp && declJp.isImplementation)) {
+            return nodes;
+        }
+
+        const unusedParams = new Set(declJp.params.filter(param => getParamReferences(param, declJp).length === 0).map(param => param.astId));
+        return nodes.filter(nodeJp => !unusedParams.has(nodeJp.astId) && !unusedParams.has((nodeJp.getAncestor("param") as Param | undefined)?.astId ?? ""));
+    }
+}
+
+/**
+ * Returns the key that groups the declarations of the same identifier: functions and objects by name, typedefs and named tags in their own namespaces.
+ * Identifiers with internal linkage are not distinguished by file, which only keeps more declarations alive.
+ */
+function getDeclKey(declJp: Joinpoint): string {
+    if (declJp instanceof TypedefDecl) {
+        return `typedef:${declJp.name}`;
+    }
+    if (isTagDecl(declJp)) {
+        return declJp.name ? `tag:${declJp.name}` : `tag@${declJp.astId}`;
+    }
+    return (declJp as FunctionJp | Vardecl).name;
+}
+
+function isVolatile(varJp: Vardecl): boolean {
+    try {
+        return varJp.type instanceof QualType && varJp.type.qualifiers?.includes("volatile");
+    } catch (error) {
+        return false;
+    }
+}
@@ -0,0 +1,42 @@
+import { FunctionJp, Joinpoint } from "@specs-feup/clava/api/Joinpoints.js";
+import { AnalysisType } from "../../MISRA.js";
+import UnusedCodeRule from "./UnusedCodeRule.js";
+
+/**
+ * MISRA-C Rule 2.1: A project shall not contain unreachable code.
+ *
+ * Reports the functions that cannot be reached from the entry points of the program, when the reachability analysis is configured.
+ * Their definitions and declarations are removed along with every other unreachable declaration.
+ */
+export default class Rule_2_1_UnreachableFunctions extends UnusedCodeRule {
+    /**
+     * Scope of analysis
+     */
+    readonly analysisType = AnalysisType.SYSTEM;
+
+    /**
+     * @returns Rule identifier according to MISRA-C:2012
+     */
+    override get name(): string {
+        return "2.1";
+    }
+
+    /**
+     * Checks if the given joinpoint is a declaration of a function that is not reachable from the entry points of the program.
+     * Errors are only logged on definitions.
+     *
+     * @param $jp - Joinpoint to analyze
+     * @param logErrors - [logErrors=false] - Whether to log errors if a violation is detected
+     * @returns Returns true if the joinpoint violates the rule, false otherwise
+     */
+    match($jp: Joinpoint, logErrors: boolean = false): boolean {
+        if (!($jp instanceof FunctionJp) || !this.isUnreachable($jp)) {
+            return false;
+        }
+
+        if (logErrors && $jp.isImplementation) {
+            this.logMISRAError($jp, `Function '${$jp.name}' is not reachable from the entry points of the program.`);
+        }
+        return true;
+    }
+}
@@ -1,13 +1,16 @@
-import { Joinpoint } from "@specs-feup/clava/api/Joinpoints.js";
-import MISRARule from "../../MISRARule.js";
+import { Joinpoint, Program } from "@specs-feup/clava/api/Joinpoints.js";
+import UnusedCodeRule from "./UnusedCodeRule.js";
 import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
 import { getTypeDefDecl, isTypeDeclUsed } from "../../utils/TypeDeclUtils.js";
 import { isTagDecl } from "../../utils/JoinpointUtils.js";
 
 /**
  * MISRA-C Rule 2.3: A project should not contain unused type declarations.
+ *
+ * When the reachability analysis is configured, type declarations only used by unreachable code are also reported,
+ * and removed along with every other unreachable declaration.
  */
-export default class Rule_2_3_UnusedTypeDecl extends MISRARule {
+export default class Rule_2_3_UnusedTypeDecl extends UnusedCodeRule {
     /**
      * Scope of analysis
      */
@@ -31,15 +34,19 @@ export default class Rule_2_3_UnusedTypeDecl extends MISRARule {
         if (typeDecl === undefined) return false;
 
         const isUnused = !isTypeDeclUsed(typeDecl);
+        const isUnreachable = !isUnused && this.isUnreachable(typeDecl);
         if (logErrors && isUnused) {
             this.logMISRAError($jp, `Type declaration '${typeDecl.name}' is declared but not used.`)
+        } else if (logErrors && isUnreachable) {
+            this.logMISRAError($jp, `Type declaration '${typeDecl.name}' is only used by unreachable code.`)
         }
-        return isUnused;
+        return isUnused || isUnreachable;
     }
     
     /**
      * Transforms the joinpoint if it represents an unused type declaration
      * 
+     * - If the joinpoint is the program, the unreachable declarations are removed
      * - If the joinpoint defines a tag (named struct, enum or union) that is referenced elsewhere in the code,
      *  the joinpoint is replaced by the tag
      * - Otherwise, the joinpoint is simply removed from the AST
@@ -47,7 +54,9 @@ export default class Rule_2_3_UnusedTypeDecl extends MISRARule {
      * @param $jp - Joinpoint to transform
      * @returns Report detailing the transformation result
      */
-    apply($jp: Joinpoint): MISRATransformationReport {
+    override apply($jp: Joinpoint): MISRATransformationReport {
+        if ($jp instanceof Program)
+            return super.apply($jp);
         if (!this.match($jp)) 
             return new MISRATransformationReport(MISRATransformationType.NoChange);
 
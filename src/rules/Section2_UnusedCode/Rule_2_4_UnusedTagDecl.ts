@@ -1,13 +1,16 @@
-import { Joinpoint, DeclStmt } from "@specs-feup/clava/api/Joinpoints.js";
-import MISRARule from "../../MISRARule.js";
+import { Joinpoint, DeclStmt, Program } from "@specs-feup/clava/api/Joinpoints.js";
+import UnusedCodeRule from "./UnusedCodeRule.js";
 import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
 import { hasTypeDefDecl, isTypeDeclUsed } from "../../utils/TypeDeclUtils.js";
 import { isTagDecl, TagDecl } from "../../utils/JoinpointUtils.js";
 
 /**
  * MISRA-C Rule 2.4: A project should not contain unused tag declarations.
+ *
+ * When the reachability analysis is configured, tags only used by unreachable code are also reported,
+ * and removed along with every other unreachable declaration.
  */
-export default class Rule_2_4_UnusedTagDecl extends MISRARule {
+export default class Rule_2_4_UnusedTagDecl extends UnusedCodeRule {
     /**
      * Scope of analysis
      */
@@ -45,22 +48,28 @@ export default class Rule_2_4_UnusedTagDecl extends MISRARule {
         }
 
         const isUnused = !isTypeDeclUsed(tagJp);
+        const isUnreachable = !isUnused && this.isUnreachable(tagJp);
         if (isUnused && logErrors) {
             this.logMISRAError(tagJp, 
                 containsTypeDecl ? `The tag '${tagJp.name}' is declared but only used in a typedef.` : `The tag '${tagJp.name}' is declared but not used.`);
+        } else if (isUnreachable && logErrors) {
+            this.logMISRAError(tagJp, `The tag '${tagJp.name}' is only used by unreachable code.`);
         }
-        return isUnused;
+        return isUnused || isUnreachable;
     }
     
     /**
      * Transforms the joinpoint if it is an unused tag declaration
+     * - If the joinpoint is the program, the unreachable declarations are removed. 
      * - If the joinpoint is a tag declared in a typedef, it removes the name. 
      * - Otherwise, the joinpoint is detached.
      * 
      * @param $jp - Joinpoint to transform
      * @returns Report detailing the transformation result
      */
-    apply($jp: Joinpoint): MISRATransformationReport {
+    override apply($jp: Joinpoint): MISRATransformationReport {
+        if ($jp instanceof Program)
+            return super.apply($jp);
         if (!this.match($jp)) 
             return new MISRATransformationReport(MISRATransformationType.NoChange);
         
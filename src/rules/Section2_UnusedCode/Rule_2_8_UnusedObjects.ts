@@ -0,0 +1,42 @@
+import { Joinpoint, StorageClass, Vardecl } from "@specs-feup/clava/api/Joinpoints.js";
+import { AnalysisType } from "../../MISRA.js";
+import UnusedCodeRule from "./UnusedCodeRule.js";
+
+/**
+ * MISRA-C Rule 2.8: A project should not contain unused object definitions.
+ *
+ * Reports the file scope objects that are not used by code reachable from the entry points of the program, when the reachability analysis is configured.
+ * Their definitions and 'extern' declarations are removed along with every other unreachable declaration.
+ */
+export default class Rule_2_8_UnusedObjects extends UnusedCodeRule {
+    /**
+     * Scope of analysis
+     */
+    readonly analysisType = AnalysisType.SYSTEM;
+
+    /**
+     * @returns Rule identifier according to MISRA-C:2012
+     */
+    override get name(): string {
+        return "2.8";
+    }
+
+    /**
+     * Checks if the given joinpoint is a declaration of a file scope object that is not used by reachable code.
+     * Errors are not logged on 'extern' declarations.
+     *
+     * @param $jp - Joinpoint to analyze
+     * @param logErrors - [logErrors=false] - Whether to log errors if a violation is detected
+     * @returns Returns true if the joinpoint violates the rule, false otherwise
+     */
+    match($jp: Joinpoint, logErrors: boolean = false): boolean {
+        if (!($jp instanceof Vardecl) || !this.isUnreachable($jp)) {
+            return false;
+        }
+
+        if (logErrors && $jp.storageClass !== StorageClass.EXTERN) {
+            this.logMISRAError($jp, `Object '${$jp.name}' is defined but not used by code reachable from the entry points of the program.`);
+        }
+        return true;
+    }
+}
@@ -0,0 +1,101 @@
+import { Joinpoint, Program } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRARule from "../../MISRARule.js";
+import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
+import ReachabilityAnalysis from "./ReachabilityAnalysis.js";
+
+/**
+ * Abstract base class for MISRA-C rules on unused code that share the whole-program reachability analysis.
+ * The declarations that are not reachable from the entry points are removed together, when the first linked rule is applied to the program.
+ *
+ * Need to implement:
+ *  - analysisType
+ *  - name()
+ *  - match($jp, logErrors)
+ */
+export default abstract class UnusedCodeRule extends MISRARule {
+    /**
+     * Specifies the scope of analysis: single unit or entire system.
+     */
+    abstract readonly analysisType: AnalysisType;
+
+    /**
+     * @returns Rule identifier according to MISRA-C:2012
+     */
+    abstract override get name(): string;
+
+    /**
+     * Reachability analysis shared with the linked rules
+     */
+    private reachability: ReachabilityAnalysis | undefined = undefined;
+
+    /**
+     * Rules whose unreachable declarations are removed together
+     */
+    private linkedRules: UnusedCodeRule[] = [this];
+
+    /**
+     * Checks if the joinpoint violates the rule
+     *
+     * @param $jp - Joinpoint to analyze
+     * @param logErrors - [logErrors=false] - Whether to log errors if a violation is detected
+     * @returns Returns true if the joinpoint violates the rule, false otherwise
+     */
+    abstract match($jp: Joinpoint, logErrors: boolean): boolean;
+
+    /**
+     * Links the unused code rules among the given rules, so that they share a single reachability analysis per iteration
+     *
+     * @param rules The selected rules
+     */
+    static linkRules(rules: MISRARule[]) {
+        const unusedCodeRules = rules.filter((rule): rule is UnusedCodeRule => rule instanceof UnusedCodeRule);
+        const reachability = new ReachabilityAnalysis(rules.some(rule => rule.name === "2.7"));
+
+        for (const rule of unusedCodeRules) {
+            rule.reachability = reachability;
+            rule.linkedRules = unusedCodeRules;
+        }
+    }
+
+    /**
+     * Returns the shared reachability analysis, creating one restricted to this rule if it was not linked with other rules
+     */
+    private getReachability(): ReachabilityAnalysis {
+        if (this.reachability === undefined) {
+            this.reachability = new ReachabilityAnalysis(false);
+        }
+        return this.reachability;
+    }
+
+    /**
+     * Checks if the given file scope declaration is not reachable from the entry points of the program
+     *
+     * @param $jp - The declaration
+     */
+    protected isUnreachable($jp: Joinpoint): boolean {
+        return this.getReachability().isUnreachable($jp, this.context);
+    }
+
+    /**
+     * Removes the unreachable declarations of the program, once per iteration.
+     * Declarations covered by an approved deviation of any linked rule are kept.
+     * Linked rules applied afterwards in the same iteration perform no changes.
+     *
+     * @param $jp - Joinpoint to transform
+     * @returns Report detailing the transformation result
+     */
+    apply($jp: Joinpoint): MISRATransformationReport {
+        if (!($jp instanceof Program)) {
+            return new MISRATransformationReport(MISRATransformationType.NoChange);
+        }
+
+        const reachability = this.getReachability();
+        if (reachability.appliedIteration === this.context.iteration) { // Already removed by a linked rule
+            return new MISRATransformationReport(MISRATransformationType.NoChange);
+        }
+        reachability.appliedIteration = this.context.iteration;
+
+        const removed = reachability.removeUnreachableDecls(this.context, declJp => this.linkedRules.some(rule => rule.isDeviated(declJp)));
+        return new MISRATransformationReport(removed > 0 ? MISRATransformationType.DescendantChange : MISRATransformationType.NoChange);
+    }
+}
@@ -1,16 +1,14 @@
-import { Joinpoint } from "@specs-feup/clava/api/Joinpoints.js";
-import MISRARule from "../../MISRARule.js";
-import { isInlineComment, getComments } from "../../utils/CommentUtils.js";
-import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
+import LexicalRule, { LexicalViolation } from "../LexicalRule.js";
+import { Token, TokenKind } from "../../utils/LexerUtils.js";
 
 /**
  * MISRA-C Rule 3.1: The character sequences /* an d // shall not be used within a comment.
  */
-export default class Rule_3_1_CommentSequences extends MISRARule {
+export default class Rule_3_1_CommentSequences extends LexicalRule {
     /**
-     * Scope of analysis
+     * Kinds of tokens analyzed by the rule
      */
-    readonly analysisType = AnalysisType.SINGLE_TRANSLATION_UNIT;
+    readonly tokenKinds = [TokenKind.LINE_COMMENT, TokenKind.BLOCK_COMMENT];
 
      /**
      * @returns Rule identifier according to MISRA-C:2012
@@ -20,41 +18,38 @@ export default class Rule_3_1_CommentSequences extends MISRARule {
     }
 
     /**
-     * Checks if given joinpoint contains disallowed character sequences in comments.
+     * Checks if the given comment contains disallowed character sequences. 
+     * The sequence // is allowed within a line comment.
      * 
-     * @param $jp - Joinpoint to analyze
-     * @param logErrors - [logErrors=false] - Whether to log errors if a violation is detected
-     * @returns Returns true if the joinpoint violates the rule, false otherwise
+     * @param tokens - The tokens of the file
+     * @param index - The index of the comment to analyze
+     * @returns The violation, with the edit that removes the disallowed sequences, or undefined if the comment complies with the rule
      */
-    match($jp: Joinpoint, logErrors: boolean = false): boolean {
-        const invalidComments = getComments($jp).filter(comment => 
-            (isInlineComment(comment) && /(\/\*)/g.test(comment.text)) ||
-            (!isInlineComment(comment) && /(\/\/|\/\*)/g.test(comment.text)));
+    matchToken(tokens: Token[], index: number): LexicalViolation | undefined {
+        const comment = tokens[index];
+        const isBlockComment = comment.kind === TokenKind.BLOCK_COMMENT;
+        const isTerminated = !isBlockComment || (comment.text.length >= 4 && comment.text.endsWith("*/"));
+        const text = comment.text.slice(2, isBlockComment && isTerminated ? -2 : undefined);
+        const invalidSymbols = isBlockComment ? /(\/\/|\/\*)/g : /(\/\*)/g;
 
-        if (logErrors) {
-            invalidComments.forEach(comment =>
-                this.logMISRAError(comment, `Comment \'${comment.text}\' contains invalid character sequences.`)
-            )
+        if (!text.match(invalidSymbols)) {
+            return undefined;
         }
-        return invalidComments.length > 0;
-    }
-
-    /**
-     * Transforms the given joinpoint if it represents a joinpoint containing disallowed character sequences in comments.
-     * 
-     * @param $jp - Joinpoint to transform
-     * @returns Report detailing the transformation result
-     */
-    apply($jp: Joinpoint): MISRATransformationReport {
-        if (!this.match($jp)) 
-            return new MISRATransformationReport(MISRATransformationType.NoChange);
 
-        const comments = getComments($jp);
-        for (const comment of comments) {
-            const invalidSymbols = isInlineComment(comment) ? /(\/\*)/g : /(\/\/|\/\*)/g;
-            const newText = comment.text.replace(invalidSymbols, '');
-            comment.setText(newText);
+        // Removing a sequence may form a new one (e.g., '//**' becomes '/*'), so repeat until none is left
+        let newText = text;
+        while (newText.match(invalidSymbols)) {
+            newText = newText.replace(invalidSymbols, '');
         }
-        return new MISRATransformationReport(MISRATransformationType.DescendantChange);;
+
+        return {
+            token: comment,
+            message: `Comment \'${text.trim()}\' contains invalid character sequences.`,
+            edit: isTerminated ? {
+                offset: comment.offset,
+                length: comment.text.length,
+                text: isBlockComment ? `/*${newText}*/` : `//${newText}`
+            } : undefined
+        };
     }
 }
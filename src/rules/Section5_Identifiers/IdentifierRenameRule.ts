@@ -1,8 +1,9 @@
-import {Joinpoint, Program} from "@specs-feup/clava/api/Joinpoints.js";
+import {Call, FunctionJp, Joinpoint, Program, Vardecl, Varref} from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
 import MISRARule from "../../MISRARule.js";
 import { AnalysisType, MISRATransformationReport, MISRATransformationType } from "../../MISRA.js";
-import { renameIdentifier } from "../../utils/IdentifierUtils.js";
-import Query from "@specs-feup/lara/api/weaver/Query.js";
+import RenameTransaction from "./RenameTransaction.js";
+import { getIdentifierName } from "../../utils/IdentifierUtils.js";
 
 /**
  * Abstract base class for MISRA-C rules that enforce constraints on identifier uniqueness where renaming may be required.
@@ -33,6 +34,16 @@ export default abstract class IdentifierRenameRule extends MISRARule {
      */
     protected invalidIdentifiers: any[] = []; 
 
+    /**
+     * Renames shared with the linked rules
+     */
+    private renames: RenameTransaction | undefined = undefined;
+
+    /**
+     * Rules whose invalid identifiers are renamed together
+     */
+    private linkedRules: IdentifierRenameRule[] = [this];
+
     /**
      * Checks if the joinpoint violates the rule
      * 
@@ -43,21 +54,82 @@ export default abstract class IdentifierRenameRule extends MISRARule {
     abstract match($jp: Joinpoint, logErrors: boolean): boolean;
 
     /**
-     * Renames all invalid identifiers found in the program.
-     * After renaming, the program is rebuilt to ensure proper linking of functions, variables, and their external declarations.
+     * Links the identifier rules among the given rules, so that their invalid identifiers are renamed in a single transaction
+     *
+     * @param rules The selected rules
+     */
+    static linkRules(rules: MISRARule[]) {
+        const identifierRules = rules.filter((rule): rule is IdentifierRenameRule => rule instanceof IdentifierRenameRule);
+        const renames = new RenameTransaction();
+
+        for (const rule of identifierRules) {
+            rule.renames = renames;
+            rule.linkedRules = identifierRules;
+        }
+    }
+
+    /**
+     * Returns the shared renames, creating a transaction restricted to this rule if it was not linked with other rules
+     */
+    private getRenames(): RenameTransaction {
+        if (this.renames === undefined) {
+            this.renames = new RenameTransaction();
+        }
+        return this.renames;
+    }
+
+    /**
+     * Renames the invalid identifiers found by this rule and by the rules linked with it, in a single transaction.
+     * Identifiers covered by an approved deviation of the rule that found them are not renamed.
+     * Linked rules applied afterwards in the same iteration perform no changes.
+     * Only the renamed declarations and the references to the renamed globals are reported as changed, since the structure of the program is kept.
      * 
      * @param $jp - Joinpoint to transform
      * @returns Report detailing the transformation result
      */
     apply($jp: Joinpoint): MISRATransformationReport {
-        if (!this.match($jp, false)) {
-            return new MISRATransformationReport(MISRATransformationType.NoChange);   
+        if (!($jp instanceof Program)) {
+            return new MISRATransformationReport(MISRATransformationType.NoChange);
         }
 
-        for (const identifierJp of this.invalidIdentifiers) {
-            const newName = this.context.generateIdentifierName(identifierJp)!;
-            renameIdentifier(identifierJp, newName);
+        const renames = this.getRenames();
+        if (renames.appliedIteration === this.context.iteration) { // Already renamed by a linked rule
+            return new MISRATransformationReport(MISRATransformationType.NoChange);
         }
-        return new MISRATransformationReport(MISRATransformationType.Replacement, Query.root() as Program);
+        renames.appliedIteration = this.context.iteration;
+
+        for (const rule of this.linkedRules.filter(rule => rule.match($jp, false))) {
+            rule.invalidIdentifiers
+                .filter(identifierJp => !rule.isDeviated(identifierJp))
+                .forEach(identifierJp => renames.add(identifierJp));
+        }
+        if (renames.size === 0) {
+            return new MISRATransformationReport(MISRATransformationType.NoChange);
+        }
+
+        const renamedDecls = renames.commit(identifierJp => this.context.generateIdentifierName(identifierJp)!);
+        return new MISRATransformationReport(MISRATransformationType.DescendantChange, undefined, this.addGlobalReferences(renamedDecls));
+    }
+
+    /**
+     * Adds the references to the renamed objects and functions declared outside functions, so that the functions that use them are also changed.
+     * If a type declared outside functions was renamed, returns undefined instead, since it may be used by any declaration.
+     *
+     * @param renamedDecls The renamed declarations
+     * @returns The changed nodes, or undefined if the whole program may have changed
+     */
+    private addGlobalReferences(renamedDecls: Joinpoint[]): Joinpoint[] | undefined {
+        const globalDecls = renamedDecls.filter(declJp => declJp.getAncestor("function") === undefined);
+        if (globalDecls.some(declJp => !(declJp instanceof Vardecl || declJp instanceof FunctionJp))) {
+            return undefined;
+        }
+        if (globalDecls.length === 0) {
+            return renamedDecls;
+        }
+
+        // Generated names are unique, so the references are found by their new names
+        const newNames = new Set(globalDecls.map(declJp => getIdentifierName(declJp)));
+        const references = [...Query.search(Varref).get(), ...Query.search(Call).get()].filter(refJp => newNames.has(refJp.name));
+        return [...renamedDecls, ...references];
     }
 }
@@ -0,0 +1,88 @@
+import { Joinpoint, Vardecl } from "@specs-feup/clava/api/Joinpoints.js";
+import { getIdentifierName, isExternalLinkageIdentifier, setIdentifierName } from "../../utils/IdentifierUtils.js";
+import { getExternalLinkageVars, getExternalVarRefs, getIdentifierDecls } from "../../utils/ProgramUtils.js";
+import { isSameVarDecl } from "../../utils/VarUtils.js";
+
+/**
+ * Renames of the identifiers that violate the identifier rules, shared by the linked rules and applied together once per iteration.
+ *
+ * An identifier reported by several rules is renamed once, and the declarations that denote the same object
+ * (the definitions of an external object in several files and its extern declarations) receive the same name.
+ * Generated names that collide with existing identifiers are skipped. The declarations are resolved through an index
+ * of the external declarations by name, built once per commit, instead of searching the program for each renamed identifier.
+ */
+export default class RenameTransaction {
+    /**
+     * Iteration in which the renames of the linked rules were applied
+     */
+    appliedIteration: number | undefined = undefined;
+
+    /**
+     * Identifiers to rename, indexed by node identifier to discard repeated reports
+     */
+    #pending = new Map<string, Joinpoint>();
+
+    /**
+     * Adds an identifier to rename
+     *
+     * @param identifierJp The declaration of the identifier
+     */
+    add(identifierJp: Joinpoint) {
+        this.#pending.set(identifierJp.astId, identifierJp);
+    }
+
+    /**
+     * @returns Number of identifiers to rename
+     */
+    get size(): number {
+        return this.#pending.size;
+    }
+
+    /**
+     * Renames the pending identifiers and the other declarations of the same objects
+     *
+     * @param generateName Generates a new name for the given declaration
+     * @returns The renamed declarations
+     */
+    commit(generateName: ($jp: Joinpoint) => string): Joinpoint[] {
+        const usedNames = new Set([...getIdentifierDecls(), ...getExternalVarRefs()].map(jp => getIdentifierName(jp)));
+        const externalVars = groupByName(getExternalLinkageVars());
+        const externRefs = groupByName(getExternalVarRefs());
+        const renamed = new Map<string, Joinpoint>();
+
+        for (const identifierJp of this.#pending.values()) {
+            if (renamed.has(identifierJp.astId)) { // Renamed with another declaration of the same object
+                continue;
+            }
+
+            let newName = generateName(identifierJp);
+            while (usedNames.has(newName)) {
+                newName = generateName(identifierJp);
+            }
+            usedNames.add(newName);
+
+            const declarations = [identifierJp];
+            if (identifierJp instanceof Vardecl && isExternalLinkageIdentifier(identifierJp)) {
+                declarations.push(
+                    ...(externalVars.get(identifierJp.name) ?? []).filter(varDeclJp => varDeclJp.astId !== identifierJp.astId && isSameVarDecl(varDeclJp, identifierJp)),
+                    ...(externRefs.get(identifierJp.name) ?? [])
+                );
+            }
+            for (const declJp of declarations.filter(declJp => !renamed.has(declJp.astId))) {
+                setIdentifierName(declJp, newName);
+                renamed.set(declJp.astId, declJp);
+            }
+        }
+
+        this.#pending.clear();
+        return Array.from(renamed.values());
+    }
+}
+
+function groupByName(varDecls: Vardecl[]): Map<string, Vardecl[]> {
+    const groups = new Map<string, Vardecl[]>();
+    for (const varDeclJp of varDecls) {
+        groups.set(varDeclJp.name, [...(groups.get(varDeclJp.name) ?? []), varDeclJp]);
+    }
+    return groups;
+}
@@ -0,0 +1,45 @@
+import LexicalRule, { LexicalViolation } from "../LexicalRule.js";
+import { Token, TokenKind } from "../../utils/LexerUtils.js";
+
+/**
+ * MISRA-C Rule 7.1: Octal constants shall not be used.
+ */
+export default class Rule_7_1_NoOctalConstants extends LexicalRule {
+    /**
+     * Kinds of tokens analyzed by the rule
+     */
+    readonly tokenKinds = [TokenKind.NUMBER];
+
+    /**
+     * @returns Rule identifier according to MISRA-C:2012
+     */
+    override get name(): string {
+        return "7.1";
+    }
+
+    /**
+     * Checks if the given number is an octal constant (other than zero).
+     * The constant is replaced by its hexadecimal value, since octal and hexadecimal constants share the same list of candidate types,
+     * whereas a decimal constant could have a larger signed type depending on the width of `int` of the target.
+     * 
+     * @param tokens - The tokens of the file
+     * @param index - The index of the number to analyze
+     * @returns The violation, with the edit that converts the constant to hexadecimal, or undefined if the number complies with the rule
+     */
+    matchToken(tokens: Token[], index: number): LexicalViolation | undefined {
+        const literal = tokens[index];
+        const octalMatch = literal.text.match(/^0([0-7]+)([uUlL]*)$/);
+        if (!octalMatch) {
+            return undefined;
+        }
+
+        const [, digits, suffix] = octalMatch;
+        const hexText = `0x${BigInt("0o" + digits).toString(16).toUpperCase()}${suffix}`;
+
+        return {
+            token: literal,
+            message: `The octal constant ${literal.text} was used. Its hexadecimal value is ${hexText}.`,
+            edit: { offset: literal.offset, length: literal.text.length, text: hexText }
+        };
+    }
+}
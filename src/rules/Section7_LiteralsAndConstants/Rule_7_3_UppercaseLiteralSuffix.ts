@@ -0,0 +1,45 @@
+import LexicalRule, { LexicalViolation } from "../LexicalRule.js";
+import { Token, TokenKind } from "../../utils/LexerUtils.js";
+
+/**
+ * MISRA-C Rule 7.3: The lowercase character 'l' shall not be used in a literal suffix.
+ */
+export default class Rule_7_3_UppercaseLiteralSuffix extends LexicalRule {
+    /**
+     * Kinds of tokens analyzed by the rule
+     */
+    readonly tokenKinds = [TokenKind.NUMBER];
+
+    /**
+     * @returns Rule identifier according to MISRA-C:2012
+     */
+    override get name(): string {
+        return "7.3";
+    }
+
+    /**
+     * Checks if the suffix of the given number contains a lowercase 'l'.
+     * Hexadecimal digits are not part of the suffix, so only floating constants may have an 'f' suffix.
+     * 
+     * @param tokens - The tokens of the file
+     * @param index - The index of the number to analyze
+     * @returns The violation, with the edit that uses the uppercase suffix, or undefined if the number complies with the rule
+     */
+    matchToken(tokens: Token[], index: number): LexicalViolation | undefined {
+        const literal = tokens[index];
+        const isHex = /^0[xX]/.test(literal.text);
+        const isFloat = isHex ? /[pP]/.test(literal.text) : /[.eE]/.test(literal.text);
+        const suffix = literal.text.match(isFloat ? /[fFlL]*$/ : /[uUlL]*$/)![0];
+
+        if (!suffix.includes('l')) {
+            return undefined;
+        }
+
+        const newText = literal.text.slice(0, literal.text.length - suffix.length) + suffix.replace(/l/g, 'L');
+        return {
+            token: literal,
+            message: `A lowercase 'l' was used as a suffix in ${literal.text}.`,
+            edit: { offset: literal.offset, length: literal.text.length, text: newText }
+        };
+    }
+}
@@ -76,6 +76,10 @@ export default class Rule_8_6_SingleExternalDefinition extends MISRARule {
             if (this.context.getRuleResult(this.ruleID, decl) === MISRATransformationType.NoChange) {
                 continue;
             }
+            // The definitions are kept if any of them is covered by an approved deviation
+            if (this.#invalidDecls.some(identifier => isSameVarDecl(identifier, decl) && this.isDeviated(identifier))) {
+                continue;
+            }
 
             const filesWithInitialization = Query.search(FileJp, (fileJp) => {
               return fileJp.descendants.some((jp) => 
@@ -1,6 +1,16 @@
 import MISRAContext from "../MISRAContext.js";
 import MISRARule from "../MISRARule.js";
+import Rule_10_1_AppropriateOperandTypes from "./Section10_EssentialTypeModel/Rule_10_1_AppropriateOperandTypes.js";
+import Rule_10_2_CharacterArithmetic from "./Section10_EssentialTypeModel/Rule_10_2_CharacterArithmetic.js";
+import Rule_10_3_AssignmentTypeCategory from "./Section10_EssentialTypeModel/Rule_10_3_AssignmentTypeCategory.js";
+import Rule_10_5_AppropriateCastTypes from "./Section10_EssentialTypeModel/Rule_10_5_AppropriateCastTypes.js";
+import Rule_10_6_CompositeAssignmentWidth from "./Section10_EssentialTypeModel/Rule_10_6_CompositeAssignmentWidth.js";
+import Rule_10_8_CompositeCastWidth from "./Section10_EssentialTypeModel/Rule_10_8_CompositeCastWidth.js";
+import Rule_13_1_InitListSideEffects from "./Section13_SideEffects/Rule_13_1_InitListSideEffects.js";
+import Rule_13_5_ShortCircuitSideEffects from "./Section13_SideEffects/Rule_13_5_ShortCircuitSideEffects.js";
 import Rule_13_6_SafeSizeOfOperand from "./Section13_SideEffects/Rule_13_6_SafeSizeOfOperand.js";
+import Rule_15_3_GotoBlockEnclosed from "./Section15_ControlFlow/Rule_15_3_GotoBlockEnclosed.js";
+import Rule_15_4_LoopSingleExit from "./Section15_ControlFlow/Rule_15_4_LoopSingleExit.js";
 import Rule_16_2_TopLevelSwitch from "./Section16_SwitchStatements/Rule_16_2_TopLevelSwitch.js";
 import Rule_16_3_UnconditionalBreak from "./Section16_SwitchStatements/Rule_16_3_UnconditionalBreak.js";
 import Rule_16_4_SwitchHasDefault from "./Section16_SwitchStatements/Rule_16_4_SwitchHasDefault.js";
@@ -11,6 +21,8 @@ import Rule_17_3_ImplicitFunction from "./Section17_Functions/Rule_17_3_Implicit
 import Rule_17_4_NonVoidReturn from "./Section17_Functions/Rule_17_4_NonVoidReturn.js";
 import Rule_17_6_StaticArraySizeParam from "./Section17_Functions/Rule_17_6_StaticArraySizeParam.js";
 import Rule_17_7_UnusedReturnValue from "./Section17_Functions/Rule_17_7_UnusedReturnValue.js";
+import Rule_20_2_InvalidHeaderNameChars from "./Section20_PreprocessingDirectives/Rule_20_2_InvalidHeaderNameChars.js";
+import DisallowedStdLibFunctionRule from "./Section21-StandardLibraries/DisallowedStdLibFunctionRule.js";
 import Rule_21_10_NoTimeDateFunctions from "./Section21-StandardLibraries/Rule_21_10_NoTimeDateFunctions.js";
 import Rule_21_11_NoTgmathFunctions from "./Section21-StandardLibraries/Rule_21_11_NoTgmathFunctions.js";
 import Rule_21_3_NoDynamicMemory from "./Section21-StandardLibraries/Rule_21_3_NoDynamicMemory.js";
@@ -18,19 +30,26 @@ import Rule_21_6_NoStdIOFunctions from "./Section21-StandardLibraries/Rule_21_6_
 import Rule_21_7_NoNumericStringConversions from "./Section21-StandardLibraries/Rule_21_7_NoNumericStringConversions.js";
 import Rule_21_8_NoProcessControlFunctions from "./Section21-StandardLibraries/Rule_21_8_NoProcessControlFunctions.js";
 import Rule_21_9_NoGenericSearchOrSort from "./Section21-StandardLibraries/Rule_21_9_NoGenericSearchOrSort.js";
+import Rule_2_1_UnreachableFunctions from "./Section2_UnusedCode/Rule_2_1_UnreachableFunctions.js";
 import Rule_2_3_UnusedTypeDecl from "./Section2_UnusedCode/Rule_2_3_UnusedTypeDecl.js";
 import Rule_2_4_UnusedTagDecl from "./Section2_UnusedCode/Rule_2_4_UnusedTagDecl.js";
 import Rule_2_6_UnusedLabels from "./Section2_UnusedCode/Rule_2_6_UnusedLabels.js";
 import Rule_2_7_UnusedParameters from "./Section2_UnusedCode/Rule_2_7_UnusedParameters.js";
+import Rule_2_8_UnusedObjects from "./Section2_UnusedCode/Rule_2_8_UnusedObjects.js";
+import UnusedCodeRule from "./Section2_UnusedCode/UnusedCodeRule.js";
 import Rule_3_1_CommentSequences from "./Section3_Comments/Rule_3_1_CommentSequences.js";
 import Rule_5_1_DistinctExternalIdentifiers from "./Section5_Identifiers/Rule_5_1_DistinctExternalIdentifiers.js";
 import Rule_5_6_UniqueTypedefNames from "./Section5_Identifiers/Rule_5_6_UniqueTypedefNames.js";
 import Rule_5_7_UniqueTagNames from "./Section5_Identifiers/Rule_5_7_UniqueTagNames.js";
 import Rule_5_8_UniqueExternalLinkIdentifiers from "./Section5_Identifiers/Rule_5_8_UniqueExternalLinkIdentifiers.js";
 import Rule_5_9_UniqueInternalLinkIdentifiers from "./Section5_Identifiers/Rule_5_9_UniqueInternalLinkIdentifiers.js";
+import Rule_7_1_NoOctalConstants from "./Section7_LiteralsAndConstants/Rule_7_1_NoOctalConstants.js";
+import Rule_7_3_UppercaseLiteralSuffix from "./Section7_LiteralsAndConstants/Rule_7_3_UppercaseLiteralSuffix.js";
 import Rule_8_6_SingleExternalDefinition from "./Section8_DeclarationsAndDefinitions/Rule_8_6_SingleExternalDefinition.js";
 import Rule_8_7_RestrictExternalLinkage from "./Section8_DeclarationsAndDefinitions/Rule_8_7_RestrictExternalLinkage.js";
 import Rule_8_9_BlockScopeDefinition from "./Section8_DeclarationsAndDefinitions/Rule_8_9_BlockScopeDefinition.js";
+import LexicalRule from "./LexicalRule.js";
+import IdentifierRenameRule from "./Section5_Identifiers/IdentifierRenameRule.js";
 
 /**
  * Selects MISRA-C rules based on the provided analysis type.
@@ -43,20 +62,34 @@ import Rule_8_9_BlockScopeDefinition from "./Section8_DeclarationsAndDefinitions
 export function selectRules(context: MISRAContext, analysisType: string) {
      
     let rules: MISRARule[] = [
+        new Rule_2_1_UnreachableFunctions(context),
         new Rule_2_3_UnusedTypeDecl(context),
         new Rule_2_4_UnusedTagDecl(context),
         new Rule_2_6_UnusedLabels(context),
         new Rule_2_7_UnusedParameters(context),
+        new Rule_2_8_UnusedObjects(context),
         new Rule_3_1_CommentSequences(context),
         new Rule_5_1_DistinctExternalIdentifiers(context),
         new Rule_5_6_UniqueTypedefNames(context),
         new Rule_5_7_UniqueTagNames(context),
         new Rule_5_8_UniqueExternalLinkIdentifiers(context),
         new Rule_5_9_UniqueInternalLinkIdentifiers(context),
+        new Rule_7_1_NoOctalConstants(context),
+        new Rule_7_3_UppercaseLiteralSuffix(context),
         new Rule_8_6_SingleExternalDefinition(context),
         new Rule_8_7_RestrictExternalLinkage(context),
         new Rule_8_9_BlockScopeDefinition(context),
+        new Rule_10_1_AppropriateOperandTypes(context),
+        new Rule_10_2_CharacterArithmetic(context),
+        new Rule_10_3_AssignmentTypeCategory(context),
+        new Rule_10_5_AppropriateCastTypes(context),
+        new Rule_10_6_CompositeAssignmentWidth(context),
+        new Rule_10_8_CompositeCastWidth(context),
+        new Rule_13_1_InitListSideEffects(context),
+        new Rule_13_5_ShortCircuitSideEffects(context),
         new Rule_13_6_SafeSizeOfOperand(context),
+        new Rule_15_3_GotoBlockEnclosed(context),
+        new Rule_15_4_LoopSingleExit(context),
         new Rule_16_2_TopLevelSwitch(context),
         new Rule_16_3_UnconditionalBreak(context),
         new Rule_16_4_SwitchHasDefault(context),
@@ -67,6 +100,7 @@ export function selectRules(context: MISRAContext, analysisType: string) {
         new Rule_17_4_NonVoidReturn(context),
         new Rule_17_6_StaticArraySizeParam(context),
         new Rule_17_7_UnusedReturnValue(context),
+        new Rule_20_2_InvalidHeaderNameChars(context),
         new Rule_21_3_NoDynamicMemory(context),
         new Rule_21_6_NoStdIOFunctions(context),
         new Rule_21_7_NoNumericStringConversions(context),
@@ -76,7 +110,17 @@ export function selectRules(context: MISRAContext, analysisType: string) {
         new Rule_21_11_NoTgmathFunctions(context)
     ];
     rules.sort((ruleA, ruleB) => ruleA.priority - ruleB.priority); 
-    return analysisType === "all" ? rules : rules.filter(rule => rule.analysisType === analysisType);
+    const selectedRules = analysisType === "all" ? rules : rules.filter(rule => rule.analysisType === analysisType);
+
+    // Rules that disallow library functions share a single pass over the calls of the program
+    DisallowedStdLibFunctionRule.linkRules(selectedRules);
+    // Rules checked on the text of the files share a single scan of the tokens of each file
+    LexicalRule.linkRules(selectedRules);
+    // Rules that require renaming identifiers apply their renames in a single transaction per iteration
+    IdentifierRenameRule.linkRules(selectedRules);
+    // Rules on unused code share a single reachability analysis and remove the unreachable declarations together
+    UnusedCodeRule.linkRules(selectedRules);
+    return selectedRules;
 }
 
 export default selectRules;
\ No newline at end of file
@@ -0,0 +1,180 @@
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import Clava from "@specs-feup/clava/api/clava/Clava.js";
+import MISRATool from "../MISRATool.js";
+import { getChangedPaths, getChangeImpact } from "../utils/ChangeImpactUtils.js";
+import { countMISRAErrors, registerSourceCode, TestFile } from "./utils.js";
+import { execFileSync } from "child_process";
+import * as fs from 'fs';
+import * as os from 'os';
+import path from "path";
+
+const header = `
+int shared(int x);
+`;
+
+const includer = `
+#include "shared.h"
+
+int use_shared(void) {
+    return shared(1);
+}
+`;
+
+const definer = `
+int shared(int x) {
+    return x;
+}
+`;
+
+const unrelated = `
+static int unrelated(void) {
+    return 0;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "shared.h", code: header },
+    { name: "includer.c", code: includer },
+    { name: "definer.c", code: definer },
+    { name: "unrelated.c", code: unrelated }
+];
+
+describe("Change impact", () => {
+    registerSourceCode(files);
+
+    it("should include the files that include a changed header and the declarations that share its names", () => {
+        const headerJp = Query.search(FileJp, {name: "shared.h"}).first()!;
+        const impact = getChangeImpact(new Set([path.resolve(headerJp.filepath)]));
+
+        expect(impact.files.map(fileJp => fileJp.name).sort()).toEqual(["includer.c", "shared.h"]);
+        expect(impact.sharedDecls.map(declJp => (declJp.getAncestor("file") as FileJp).name)).toEqual(["definer.c"]);
+    });
+
+    it("should not impact other files when an unrelated file changes", () => {
+        const fileJp = Query.search(FileJp, {name: "unrelated.c"}).first()!;
+        const impact = getChangeImpact(new Set([path.resolve(fileJp.filepath)]));
+
+        expect(impact.files.map(fileJp => fileJp.name)).toEqual(["unrelated.c"]);
+        expect(impact.sharedDecls.length).toBe(0);
+    });
+});
+
+const firstConfig = `
+int config_a(void);
+`;
+
+const secondConfig = `
+int config_b(void);
+`;
+
+const firstIncluder = `
+#include "a/config.h"
+
+int use_a(void) {
+    return config_a();
+}
+`;
+
+const secondIncluder = `
+#include "b/config.h"
+
+int use_b(void) {
+    return config_b();
+}
+`;
+
+const sameNameFiles: TestFile[] = [
+    { name: "config.h", code: firstConfig, path: "a" },
+    { name: "config.h", code: secondConfig, path: "b" },
+    { name: "first.c", code: firstIncluder },
+    { name: "second.c", code: secondIncluder }
+];
+
+describe("Change impact of headers with the same name", () => {
+    registerSourceCode(sameNameFiles);
+
+    it("should only include the files that include the changed header", () => {
+        const headerJp = Query.search(FileJp, {name: "config.h"}).get().find(fileJp => fileJp.code.includes("config_a"))!;
+        const impact = getChangeImpact(new Set([path.resolve(headerJp.filepath)]));
+
+        expect(impact.files.map(fileJp => fileJp.name).sort()).toEqual(["config.h", "first.c"]);
+        expect(impact.files.find(fileJp => fileJp.isHeader)!.astId).toBe(headerJp.astId);
+    });
+});
+
+const changedCode = `
+#include <stdlib.h>
+
+void *make_changed(void) {
+    return malloc(4); // Violation of rule 21.3
+}
+`;
+
+const unrelatedCode = `
+#include <stdlib.h>
+
+void *make_unrelated(void) {
+    return malloc(8); // Violation of rule 21.3
+}
+`;
+
+const diffAwareFiles: TestFile[] = [
+    { name: "changed.c", code: changedCode },
+    { name: "unrelated.c", code: unrelatedCode }
+];
+
+describe("Diff-aware analysis", () => {
+    registerSourceCode(diffAwareFiles);
+
+    it("should only report the violations of whole-program rules in the impacted files", () => {
+        countMISRAErrors();
+        const allErrors = MISRATool.context.errors.filter(error => error.ruleID === "21.3");
+        expect(allErrors.some(error => error.filepath.endsWith("unrelated.c"))).toBe(true);
+
+        const changedJp = Query.search(FileJp, {name: "changed.c"}).first()!;
+        const listPath = path.join(os.tmpdir(), "misra_changed_files_test.txt");
+        fs.writeFileSync(listPath, path.resolve(changedJp.filepath) + "\n", 'utf-8');
+        Clava.getData().put("argv", `changed-since=${listPath}`);
+
+        expect(countMISRAErrors("21.3")).toBeGreaterThan(0);
+        for (const error of MISRATool.context.errors) {
+            expect(error.filepath.endsWith("changed.c")).toBe(true);
+        }
+    });
+});
+
+describe("Changed paths", () => {
+    it("should resolve the files of a list against the given folder", () => {
+        const folder = fs.mkdtempSync(path.join(os.tmpdir(), "misra_changes_"));
+        const listPath = path.join(folder, "changes.txt");
+        fs.writeFileSync(listPath, "src/first.c\n\n  include/second.h  \n" + path.join(folder, "third.c") + "\n", 'utf-8');
+
+        expect(getChangedPaths(listPath, folder)).toEqual(new Set([
+            path.join(folder, "src", "first.c"),
+            path.join(folder, "include", "second.h"),
+            path.join(folder, "third.c")
+        ]));
+        fs.rmSync(folder, { recursive: true });
+    });
+
+    it("should return the files changed since a git revision, including uncommitted and untracked files", () => {
+        const folder = fs.realpathSync(fs.mkdtempSync(path.join(os.tmpdir(), "misra_git_")));
+        const git = (...args: string[]) => execFileSync("git", ["-C", folder, "-c", "user.name=test", "-c", "user.email=test@example.com", ...args]);
+        git("init", "-q");
+        fs.writeFileSync(path.join(folder, "committed.c"), "int committed;\n");
+        fs.writeFileSync(path.join(folder, "modified.c"), "int modified;\n");
+        git("add", ".");
+        git("commit", "-q", "-m", "base");
+        git("tag", "base");
+
+        fs.writeFileSync(path.join(folder, "later.c"), "int later;\n");
+        git("add", "later.c");
+        git("commit", "-q", "-m", "later");
+        fs.writeFileSync(path.join(folder, "modified.c"), "int modified = 1;\n");
+        fs.writeFileSync(path.join(folder, "untracked.c"), "int untracked;\n");
+
+        expect(getChangedPaths("base", folder)).toEqual(new Set(["later.c", "modified.c", "untracked.c"].map(file => path.join(folder, file))));
+        fs.rmSync(folder, { recursive: true });
+    });
+});
@@ -0,0 +1,57 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import ClavaJoinPoints from "@specs-feup/clava/api/clava/ClavaJoinPoints.js";
+import { FileJp, FunctionJp, ReturnStmt } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRATransaction from "../MISRATransaction.js";
+import { isValidFile, validateFixesInBatch } from "../utils/FileUtils.js";
+import { registerSourceCode, TestFile } from "./utils.js";
+
+const code = `
+int counter = 0;
+
+int update(void) {
+    return counter;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "batch.c", code }
+];
+
+describe("Batch validation", () => {
+    registerSourceCode(files);
+
+    it("should roll back only the candidate that fails to compile", () => {
+        const fileJp = Query.search(FileJp, { name: "batch.c" }).first()!;
+        const returnJp = Query.searchFrom(Query.search(FunctionJp, { name: "update" }).first()!, ReturnStmt).first()!;
+        const candidates = ["counter = 1;", "counter = undeclared_counter;", "counter = 3;", "counter = 4;"];
+        const validatedGroups: string[][] = [];
+
+        const accepted = validateFixesInBatch(
+            candidates,
+            (candidate) => {
+                const transaction = new MISRATransaction();
+                transaction.insertBefore(returnJp, ClavaJoinPoints.stmtLiteral(candidate));
+                return transaction;
+            },
+            (group) => {
+                validatedGroups.push(group);
+                return isValidFile(fileJp) === true;
+            }
+        );
+
+        expect(accepted).toEqual(["counter = 1;", "counter = 3;", "counter = 4;"]);
+        expect(fileJp.code).toContain("counter = 1;");
+        expect(fileJp.code).toContain("counter = 3;");
+        expect(fileJp.code).toContain("counter = 4;");
+        expect(fileJp.code).not.toContain("undeclared_counter");
+
+        // All candidates, then each half, until the failing candidate is isolated
+        expect(validatedGroups).toEqual([
+            candidates,
+            candidates.slice(0, 2),
+            candidates.slice(0, 1),
+            candidates.slice(1, 2),
+            candidates.slice(2)
+        ]);
+    });
+});
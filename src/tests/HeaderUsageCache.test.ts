@@ -0,0 +1,98 @@
+import { EnumDecl, FileJp, RecordJp, TypedefDecl } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { getHeaderIncluders, getUsageScopeReferences, invalidateFileReferences, resetHeaderUsageCache } from "../utils/HeaderUsageCache.js";
+import { registerSourceCode, TestFile } from "./utils.js";
+
+const header = `
+typedef int count_t;
+typedef struct point { int x; int y; } point_t;
+struct unused_tag { int value; };
+enum mode { MODE_ON, MODE_OFF };
+int scale(int value);
+`;
+
+const includer = `
+#include "types.h"
+
+static count_t total;
+
+int use_types(void) {
+    point_t origin = { 0, 0 };
+    total = scale(origin.x);
+    return MODE_ON;
+}
+`;
+
+const other = `
+static int other(void) {
+    return 0;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "types.h", code: header },
+    { name: "includer.c", code: includer },
+    { name: "other.c", code: other }
+];
+
+describe("Header usage cache", () => {
+    registerSourceCode(files);
+
+    function getFile(name: string): FileJp {
+        return Query.search(FileJp, {name}).first()!;
+    }
+
+    it("should list the files that include a header", () => {
+        resetHeaderUsageCache();
+
+        expect(getHeaderIncluders("types.h").map(fileJp => fileJp.name)).toEqual(["includer.c"]);
+        expect(getHeaderIncluders("missing.h")).toEqual([]);
+    });
+
+    it("should merge the references of a header with the references of its includers", () => {
+        resetHeaderUsageCache();
+        const headerJp = getFile("types.h");
+        const references = getUsageScopeReferences(headerJp);
+
+        const countType = Query.searchFrom(headerJp, TypedefDecl, {name: "count_t"}).first()!;
+        const pointType = Query.searchFrom(headerJp, TypedefDecl, {name: "point_t"}).first()!;
+        const pointTag = Query.searchFrom(headerJp, RecordJp, {name: "point"}).first()!;
+        const unusedTag = Query.searchFrom(headerJp, RecordJp, {name: "unused_tag"}).first()!;
+        const modeEnum = Query.searchFrom(headerJp, EnumDecl, {name: "mode"}).first()!;
+
+        expect(references.typedefs.has(countType.astId)).toBe(true);
+        expect(references.typedefs.has(pointType.astId)).toBe(true);
+        // The typedef declared along with a tag does not use the tag
+        expect(references.tags.has(pointTag.astId)).toBe(false);
+        expect(references.tags.has(unusedTag.astId)).toBe(false);
+        expect(modeEnum.enumerators.some(enumeratorJp => references.enumerators.has(enumeratorJp.astId))).toBe(true);
+        // The only call, to the function declared in the header
+        expect(references.functions.size).toBe(1);
+    });
+
+    it("should only include the references of a source file itself", () => {
+        resetHeaderUsageCache();
+        const references = getUsageScopeReferences(getFile("other.c"));
+
+        expect(references.typedefs.size).toBe(0);
+        expect(references.enumerators.size).toBe(0);
+        expect(references.functions.size).toBe(0);
+    });
+
+    it("should reuse the references until a file is invalidated", () => {
+        resetHeaderUsageCache();
+        const headerJp = getFile("types.h");
+        const references = getUsageScopeReferences(headerJp);
+        const otherReferences = getUsageScopeReferences(getFile("other.c"));
+
+        expect(getUsageScopeReferences(headerJp)).toBe(references);
+        expect(getUsageScopeReferences(getFile("other.c"))).toBe(otherReferences);
+
+        invalidateFileReferences(getFile("includer.c"));
+        expect(getUsageScopeReferences(headerJp)).not.toBe(references);
+        expect(getUsageScopeReferences(getFile("other.c"))).toBe(otherReferences);
+
+        resetHeaderUsageCache();
+        expect(getUsageScopeReferences(getFile("other.c"))).not.toBe(otherReferences);
+    });
+});
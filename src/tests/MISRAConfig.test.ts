@@ -0,0 +1,71 @@
+import { FileJp, FunctionJp } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import MISRAConfig from "../MISRAConfig.js";
+import { registerSourceCode, TestFile } from "./utils.js";
+
+const replacements = `
+void *my_malloc(unsigned long size) {
+    return 0;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "custom_stdlib.c", code: replacements }
+];
+
+describe("Configuration", () => {
+    registerSourceCode(files);
+
+    it("should report each invalid entry once and keep it as undefined", () => {
+        const config = new MISRAConfig({
+            implicitCalls: { toupper: "ctype.h", sin: "math" },
+            disallowedFunctions: {
+                "stdlib.h": { malloc: { replacement: "my_malloc", location: "custom_stdlib.c" }, free: {} },
+                "stdio.h": "printf"
+            },
+            switchConversion: { decisionTreeThreshold: 1 },
+            reachability: []
+        });
+
+        expect(config.issues).toEqual([
+            "Entry 'implicitCalls.sin' is not a .h or .c reference.",
+            "Entry 'disallowedFunctions.stdlib.h.free' must define 'replacement' and 'location'.",
+            "Entry 'disallowedFunctions.stdio.h' must be an object.",
+            "Entry 'switchConversion.decisionTreeThreshold' must be an integer greater than or equal to 2.",
+            "Section 'reachability' must be an object."
+        ]);
+        expect(config.implicitCalls!.get("toupper")).toBe("ctype.h");
+        expect(config.implicitCalls!.has("sin")).toBe(true);
+        expect(config.implicitCalls!.get("sin")).toBeUndefined();
+        expect(config.disallowedFunctions!.get("stdlib.h")!.get("free")).toBeUndefined();
+        expect(config.disallowedFunctions!.get("stdio.h")!.size).toBe(0);
+        expect(config.switchConversion!.decisionTreeThreshold).toBeUndefined();
+        expect(config.reachability).toBeUndefined();
+        expect(config.poolAllocator).toBeUndefined();
+    });
+
+    it("should report no issues for a valid configuration", () => {
+        const config = new MISRAConfig({
+            defaultValues: { int: 0 },
+            disallowedFunctions: { "stdlib.h": { malloc: { replacement: "my_malloc", location: "custom_stdlib.c" } } }
+        });
+
+        expect(config.issues).toEqual([]);
+        expect(config.defaultValues!.get("int")).toBe("0");
+    });
+
+    it("should resolve fix targets through the index of definitions until it is invalidated", () => {
+        const config = new MISRAConfig({});
+        const fileJp = Query.search(FileJp, {name: "custom_stdlib.c"}).first()!;
+        const definitionJp = Query.searchFrom(fileJp, FunctionJp, {name: "my_malloc"}).first()!;
+
+        expect(config.findFunctionDef("my_malloc", "custom_stdlib.c")?.astId).toBe(definitionJp.astId);
+        expect(config.findFunctionDef("my_malloc", "other.c")).toBeUndefined();
+
+        definitionJp.setName("pool_malloc");
+        config.invalidateDefinitions();
+
+        expect(config.findFunctionDef("my_malloc", "custom_stdlib.c")).toBeUndefined();
+        expect(config.findFunctionDef("pool_malloc", "custom_stdlib.c")?.astId).toBe(definitionJp.astId);
+    });
+});
@@ -0,0 +1,198 @@
+import { FileJp, FunctionJp, Vardecl } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import MISRATool from "../MISRATool.js";
+import MISRADeviations from "../MISRADeviations.js";
+import { JsonLinesFormatter, SarifFormatter } from "../MISRAReport.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "./utils.js";
+import * as fs from 'fs';
+import * as os from 'os';
+import path from "path";
+import { fileURLToPath } from "url";
+
+const failingCode = `
+int generated_handler(void) {
+unused_label1: // Covered by deviation DEV-001
+    return 0;
+}
+
+/* misra-deviation-begin 2.6: vendored code */
+int vendored(void) {
+unused_label2:
+    return 1;
+}
+/* misra-deviation-end */
+
+int user_code(void) {
+unused_label3: // Violation of rule 2.6
+    return 2;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode }
+];
+
+describe("Deviations", () => {
+    const __filename = fileURLToPath(import.meta.url);
+    const __dirname = path.dirname(__filename);
+    const configFilePath = path.join(__dirname, "deviation_misra_config.json");
+
+    registerSourceCode(files, configFilePath);
+
+    it("should not report violations covered by deviations", () => {
+        expect(countMISRAErrors("2.6")).toBe(1);
+        expect(MISRATool.context.deviations.appliedDeviations.map(deviation => deviation.id)).toContain("DEV-001");
+    });
+
+    it("should not correct code covered by deviations", () => {
+        expect(countErrorsAfterCorrection("2.6")).toBe(0);
+        expect(MISRATool.context.deviations.appliedDeviations.length).toBe(2);
+
+        expect(Query.search(FunctionJp, {name: "generated_handler"}).first()!.code).toContain("unused_label1");
+        expect(Query.search(FunctionJp, {name: "vendored"}).first()!.code).toContain("unused_label2");
+        expect(Query.search(FunctionJp, {name: "user_code"}).first()!.code).not.toContain("unused_label3");
+    });
+
+    it("should list the suppressed violations as SARIF suppressions", () => {
+        countMISRAErrors();
+        const reportFile = path.join(os.tmpdir(), "misra_deviations_test.sarif");
+        MISRATool.context.outputAllErrors(new SarifFormatter(reportFile));
+
+        const results = JSON.parse(fs.readFileSync(reportFile, "utf-8")).runs[0].results;
+        const suppressed = results.filter((result: any) => result.suppressions !== undefined);
+        expect(results.length).toBe(MISRATool.getErrorCount() + suppressed.length);
+        expect(suppressed.map((result: any) => result.ruleId)).toEqual(["2.6", "2.6"]);
+
+        const external = suppressed.find((result: any) => result.properties.deviation === "DEV-001");
+        expect(external.suppressions[0]).toEqual({ kind: "external", status: "accepted", justification: "Labels are kept in generated code" });
+        const inSource = suppressed.find((result: any) => result.properties.deviation !== "DEV-001");
+        expect(inSource.suppressions[0]).toEqual({ kind: "inSource", status: "accepted", justification: "vendored code" });
+    });
+});
+
+const firstFile = `
+static int level_dev;
+
+int first_dev(void) {
+    return level_dev;
+}
+`;
+
+const secondFile = `
+/* misra-deviation 5.9: name shared with the first module */
+static int level_dev;
+
+static int get_level_dev(void) {
+    return level_dev;
+}
+
+int second_dev(void) {
+    return get_level_dev();
+}
+`;
+
+const thirdFile = `
+static int get_level_dev(void) { // Violation of rule 5.9
+    return 0;
+}
+
+int third_dev(void) {
+    return get_level_dev();
+}
+`;
+
+const programFiles: TestFile[] = [
+    { name: "first.c", code: firstFile },
+    { name: "second.c", code: secondFile },
+    { name: "third.c", code: thirdFile }
+];
+
+describe("Deviations of whole-program rules", () => {
+    registerSourceCode(programFiles);
+
+    it("should neither report nor rename the identifiers covered by deviations", () => {
+        expect(countMISRAErrors("5.9")).toBe(1);
+        expect(MISRATool.context.getSuppressedErrors().map(({ error }) => error.ruleID)).toEqual(["5.9"]);
+
+        countErrorsAfterCorrection();
+        const secondJp = Query.search(FileJp, {name: "second.c"}).first()!;
+        const thirdJp = Query.search(FileJp, {name: "third.c"}).first()!;
+        expect(Query.searchFrom(secondJp, Vardecl, {name: "level_dev"}).get().length).toBe(1);
+        expect(Query.searchFrom(secondJp, FunctionJp, {name: "get_level_dev"}).get().length).toBe(1);
+        expect(Query.searchFrom(thirdJp, FunctionJp, {name: "get_level_dev"}).get().length).toBe(0);
+    });
+});
+
+const rangeCode = `
+/* misra-deviation-begin 2.6, 2.7: legacy interface */
+int legacy(int unused_param1) {
+legacy_label:
+    return 0;
+}
+/* misra-deviation-end */
+
+int modern(int unused_param2) { // Violation of rule 2.7
+modern_label: // Violation of rule 2.6
+    return 1;
+}
+`;
+
+const rangeFiles: TestFile[] = [
+    { name: "range.c", code: rangeCode }
+];
+
+describe("Deviation ranges", () => {
+    registerSourceCode(rangeFiles);
+
+    it("should only suppress the lines between the begin and end annotations", () => {
+        expect(countMISRAErrors("2.6")).toBe(1);
+        expect(countMISRAErrors("2.7")).toBe(1);
+        expect(MISRATool.context.errors.filter(error => error.ruleID === "2.6" || error.ruleID === "2.7").every(error => error.line > 8)).toBe(true);
+
+        const reportFile = path.join(os.tmpdir(), "misra_deviation_ranges_test.jsonl");
+        MISRATool.context.outputAllErrors(new JsonLinesFormatter(reportFile));
+        const records = fs.readFileSync(reportFile, "utf-8").trim().split("\n").map(line => JSON.parse(line));
+        const suppressed = records.filter(record => record.deviation !== undefined);
+        expect(suppressed.map(record => record.rule).sort()).toEqual(["2.6", "2.7"]);
+        expect(suppressed.every(record => record.reason === "legacy interface" && record.line < 7)).toBe(true);
+    });
+
+    it("should keep the code between the begin and end annotations", () => {
+        countErrorsAfterCorrection();
+
+        expect(Query.search(FunctionJp, {name: "legacy"}).first()!.code).toContain("legacy_label");
+        expect(Query.search(FunctionJp, {name: "modern"}).first()!.code).not.toContain("modern_label");
+    });
+});
+
+const labelCode = `
+int entry(void) {
+entry_label:
+    return 0;
+}
+`;
+
+const globFiles: TestFile[] = [
+    { name: "main.c", code: labelCode, path: "src" },
+    { name: "main.c", code: labelCode, path: "src/app" },
+    { name: "notmain.c", code: labelCode, path: "src" },
+    { name: "xmain.c", code: labelCode, path: "src" }
+];
+
+describe("Deviation file globs", () => {
+    registerSourceCode(globFiles);
+
+    it("should only match whole folder names with '**/'", () => {
+        const deviations = new MISRADeviations([
+            { id: "DEV-GLOB", rules: ["2.6"], file: "src/**/main.c", function: undefined, lines: undefined, reason: "Entry points" }
+        ]);
+        const isDeviated = (fileJp: FileJp) => deviations.find("2.6", Query.searchFrom(fileJp, FunctionJp).first()!) !== undefined;
+        const globFilesJps = Query.search(FileJp).get();
+        const getFile = (name: string, folder: string) => globFilesJps.find(fileJp => fileJp.name === name && path.dirname(fileJp.filepath).endsWith(folder))!;
+
+        expect(isDeviated(getFile("main.c", path.join("src", "app")))).toBe(true);
+        expect(isDeviated(getFile("main.c", "src"))).toBe(true);
+        expect(isDeviated(getFile("notmain.c", "src"))).toBe(false);
+        expect(isDeviated(getFile("xmain.c", "src"))).toBe(false);
+    });
+});
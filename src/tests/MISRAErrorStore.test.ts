@@ -0,0 +1,87 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { FunctionJp } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRAErrorStore from "../MISRAErrorStore.js";
+import { registerSourceCode, TestFile } from "./utils.js";
+
+const code = `
+int first(void) {
+    return 0;
+}
+
+int second(void) {
+    return 1;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "store.c", code }
+];
+
+describe("Error store", () => {
+    registerSourceCode(files);
+
+    it("should store each violation once", () => {
+        const store = new MISRAErrorStore();
+        const functionJp = Query.search(FunctionJp, { name: "first" }).first()!;
+        store.add("2.7", functionJp, "First message");
+        store.add("2.7", functionJp, "First message");
+        store.add("2.7", functionJp, "First message", { line: 3, column: 5 });
+
+        expect(store.size).toBe(2);
+        expect(store.getErrors().filter(error => error.location !== undefined).length).toBe(1);
+    });
+
+    it("should release the strings of discarded errors", () => {
+        const store = new MISRAErrorStore();
+        const first = Query.search(FunctionJp, { name: "first" }).first()!;
+        const second = Query.search(FunctionJp, { name: "second" }).first()!;
+        store.add("2.7", first, "First message");
+        store.add("8.7", second, "Second message");
+        const stringCount = store.stringCount;
+
+        store.removeNodes(new Set([first.astId]));
+        expect(store.size).toBe(1);
+        expect(store.stringCount).toBe(stringCount - 3);
+        expect(store.getErrors()[0].ruleID).toBe("8.7");
+        expect(store.getErrors()[0].message).toBe("Second message");
+        expect(store.getErrors()[0].nodeId).toBe(second.astId);
+
+        // A removed error can be stored again
+        store.add("2.7", first, "First message");
+        expect(store.size).toBe(2);
+
+        store.clear();
+        expect(store.size).toBe(0);
+        expect(store.stringCount).toBe(0);
+    });
+
+    it("should find the joinpoints of the errors in the current AST", () => {
+        let version = 0;
+        const store = new MISRAErrorStore(() => version);
+        const first = Query.search(FunctionJp, { name: "first" }).first()!;
+        const second = Query.search(FunctionJp, { name: "second" }).first()!;
+        store.add("2.7", first, "First message");
+        store.add("8.7", second, "Second message");
+
+        const [firstError, secondError] = store.getErrors();
+        expect(firstError.joinpoint?.astId).toBe(first.astId);
+        expect(firstError.isActiveError()).toBe(true);
+
+        second.detach();
+        version++;
+        expect(secondError.joinpoint).toBeUndefined();
+        expect(secondError.isActiveError()).toBe(false);
+        expect(store.getActiveErrors().map(error => error.ruleID)).toEqual(["2.7"]);
+    });
+
+    it("should report the errors of edited files without position", () => {
+        const store = new MISRAErrorStore();
+        const first = Query.search(FunctionJp, { name: "first" }).first()!;
+        store.add("2.7", first, "First message");
+
+        expect(store.getActiveErrors()[0].line).toBeGreaterThan(0);
+        const [error] = store.getActiveErrors(() => true);
+        expect(error.line).toBe(0);
+        expect(error.fileLocation).toBe(error.filepath);
+    });
+});
@@ -0,0 +1,68 @@
+import MISRAPatch from "../MISRAPatch.js";
+import { countErrorsAfterCorrection, registerSourceCode, TestFile } from "./utils.js";
+import * as fs from 'fs';
+import * as os from 'os';
+import path from "path";
+
+const failingCode = `
+int f(void) {
+unused_label: // Violation of rule 2.6
+    return 0;
+}
+`;
+
+const passingCode = `
+int g(void) {
+    return 1;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode },
+    { name: "good.c", code: passingCode }
+];
+
+describe("Patch output", () => {
+    registerSourceCode(files);
+
+    it("should only report and diff the files changed by the correction", () => {
+        const patch = new MISRAPatch();
+        patch.captureBaseline();
+        countErrorsAfterCorrection();
+
+        const modifiedFiles = patch.getModifiedFiles();
+        expect(modifiedFiles.map(file => file.relativePath)).toEqual(["bad.c"]);
+
+        const patchPath = path.join(os.tmpdir(), "misra_patch_test.diff");
+        patch.writeDiff(modifiedFiles, patchPath);
+        const diff = fs.readFileSync(patchPath, "utf-8");
+        expect(diff).toContain("+++ b/bad.c");
+        expect(diff).not.toContain("good.c");
+        expect(diff).not.toMatch(/^\+.*unused_label/m);
+    });
+
+    it("should diff the original text of the files overwritten in place", () => {
+        const patch = new MISRAPatch();
+        patch.captureBaseline();
+        countErrorsAfterCorrection();
+
+        const modifiedFiles = patch.getModifiedFiles();
+        const originalPath = modifiedFiles[0].fileJp.filepath;
+        const existed = fs.existsSync(originalPath);
+        if (!existed) {
+            fs.mkdirSync(path.dirname(originalPath), { recursive: true });
+            fs.writeFileSync(originalPath, failingCode, 'utf-8');
+        }
+
+        try {
+            patch.writeFiles(modifiedFiles);
+            const patchPath = path.join(os.tmpdir(), "misra_patch_inplace_test.diff");
+            patch.writeDiff(modifiedFiles, patchPath);
+            expect(fs.readFileSync(patchPath, "utf-8")).toMatch(/^-.*unused_label/m);
+        } finally {
+            if (!existed) {
+                fs.rmSync(originalPath);
+            }
+        }
+    });
+});
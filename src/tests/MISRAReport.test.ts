@@ -0,0 +1,77 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRATool from "../MISRATool.js";
+import { getRuleCategory, JsonLinesFormatter, RuleCategory, SarifFormatter } from "../MISRAReport.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "./utils.js";
+import * as fs from 'fs';
+import * as os from 'os';
+import path from "path";
+
+const failingCode = `
+int f(int unused_param) { // Violation of rule 2.7
+unused_label: // Violation of rule 2.6
+    return 0;
+}
+
+int main(void) {
+    return f(1);
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode }
+];
+
+describe("Report formats", () => {
+    registerSourceCode(files);
+
+    it("should write one ordered JSON object per violation", () => {
+        const errorCount = countMISRAErrors();
+        const reportFile = path.join(os.tmpdir(), "misra_report_test.jsonl");
+        MISRATool.context.outputAllErrors(new JsonLinesFormatter(reportFile));
+
+        const records = fs.readFileSync(reportFile, "utf-8").trim().split("\n").map(line => JSON.parse(line));
+        expect(errorCount).toBeGreaterThan(0);
+        expect(records.length).toBe(errorCount);
+        for (let i = 1; i < records.length; i++) {
+            expect(records[i - 1].line <= records[i].line).toBe(true);
+        }
+    });
+
+    it("should write a SARIF log with a result per violation", () => {
+        const errorCount = countMISRAErrors();
+        const reportFile = path.join(os.tmpdir(), "misra_report_test.sarif");
+        MISRATool.context.outputAllErrors(new SarifFormatter(reportFile));
+
+        const log = JSON.parse(fs.readFileSync(reportFile, "utf-8"));
+        expect(log.version).toBe("2.1.0");
+        expect(log.runs[0].results.length).toBe(errorCount);
+        expect(log.runs[0].tool.driver.rules.map((rule: any) => rule.id)).toEqual(expect.arrayContaining(["2.6", "2.7"]));
+    });
+
+    it("should reference files by URI and report advisory rules as warnings", () => {
+        countMISRAErrors();
+        const reportFile = path.join(os.tmpdir(), "misra_report_levels_test.sarif");
+        MISRATool.context.outputAllErrors(new SarifFormatter(reportFile));
+
+        const results = JSON.parse(fs.readFileSync(reportFile, "utf-8")).runs[0].results;
+        for (const result of results) {
+            expect(result.locations[0].physicalLocation.artifactLocation.uri.startsWith("file:///")).toBe(true);
+            expect(result.level).toBe(getRuleCategory(result.ruleId) === RuleCategory.ADVISORY ? "warning" : "error");
+        }
+        expect(results.filter((result: any) => result.ruleId === "2.7").every((result: any) => result.level === "warning")).toBe(true);
+        expect(getRuleCategory("17.3")).toBe(RuleCategory.MANDATORY);
+        expect(getRuleCategory("21.3")).toBe(RuleCategory.REQUIRED);
+    });
+
+    it("should keep the positions of the violations of files not changed by the correction", () => {
+        countMISRAErrors();
+        expect(MISRATool.context.activeErrors.every(error => error.line > 0)).toBe(true);
+
+        countErrorsAfterCorrection();
+        expect(MISRATool.context.isFileEdited(Query.search(FileJp, { name: "bad.c" }).first()!.filepath)).toBe(true);
+        for (const error of MISRATool.context.activeErrors) {
+            expect(error.line === 0).toBe(MISRATool.context.isFileEdited(error.filepath));
+        }
+    });
+});
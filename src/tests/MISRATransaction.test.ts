@@ -0,0 +1,98 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import ClavaJoinPoints from "@specs-feup/clava/api/clava/ClavaJoinPoints.js";
+import { ExprStmt, FileJp, FunctionJp, Include, ReturnStmt, StorageClass, Vardecl } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRATransaction from "../MISRATransaction.js";
+import { registerSourceCode, TestFile } from "./utils.js";
+
+const code = `
+int counter = 0;
+
+int update(int value) {
+    counter = value;
+    counter++;
+    counter--;
+    return counter;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "transaction.c", code }
+];
+
+describe("Transactions", () => {
+    registerSourceCode(files);
+
+    const getFile = () => Query.search(FileJp, { name: "transaction.c" }).first()!;
+    const getFunction = () => Query.search(FunctionJp, { name: "update" }).first()!;
+
+    it("should restore a detached node between its original siblings", () => {
+        const originalCode = getFile().code;
+        const statements = Query.searchFrom(getFunction(), ExprStmt).get();
+        const transaction = new MISRATransaction();
+
+        transaction.detach(statements[1]);
+        expect(Query.searchFrom(getFunction(), ExprStmt).get().length).toBe(2);
+
+        transaction.rollback();
+        expect(transaction.isClosed).toBe(true);
+        expect(getFile().code).toBe(originalCode);
+        expect(Query.searchFrom(getFunction(), ExprStmt).get().map(stmtJp => stmtJp.code)).toEqual(statements.map(stmtJp => stmtJp.code));
+    });
+
+    it("should restore a replaced node", () => {
+        const originalCode = getFile().code;
+        const returnJp = Query.searchFrom(getFunction(), ReturnStmt).first()!;
+        const transaction = new MISRATransaction();
+
+        transaction.replaceWith(returnJp, ClavaJoinPoints.stmtLiteral("return 0;"));
+        expect(getFile().code).not.toBe(originalCode);
+
+        transaction.rollback();
+        expect(getFile().code).toBe(originalCode);
+    });
+
+    it("should remove an added include", () => {
+        const transaction = new MISRATransaction();
+
+        transaction.addInclude(getFile(), "stdlib.h", true);
+        expect(Query.searchFrom(getFile(), Include, { name: "stdlib.h" }).get().length).toBe(1);
+
+        transaction.rollback();
+        expect(Query.searchFrom(getFile(), Include, { name: "stdlib.h" }).get().length).toBe(0);
+    });
+
+    it("should restore names and storage classes", () => {
+        const originalCode = getFile().code;
+        const varJp = Query.search(Vardecl, { name: "counter" }).first()!;
+        const storageClass = varJp.storageClass;
+        const transaction = new MISRATransaction();
+
+        transaction.setName(getFunction(), "update_counter");
+        transaction.setStorageClass(varJp, StorageClass.STATIC);
+        expect(Query.search(FunctionJp, { name: "update_counter" }).get().length).toBe(1);
+        expect(varJp.storageClass).toBe(StorageClass.STATIC);
+        expect(transaction.size).toBe(2);
+
+        transaction.rollback();
+        expect(Query.search(FunctionJp, { name: "update" }).get().length).toBe(1);
+        expect(varJp.storageClass).toBe(storageClass);
+        expect(getFile().code).toBe(originalCode);
+    });
+
+    it("should keep the edits of a committed transaction", () => {
+        const statements = Query.searchFrom(getFunction(), ExprStmt).get();
+        const transaction = new MISRATransaction();
+
+        transaction.detach(statements[1]);
+        transaction.setName(getFunction(), "update_counter");
+        transaction.commit();
+        const committedCode = getFile().code;
+
+        transaction.rollback();
+        expect(transaction.size).toBe(0);
+        expect(getFile().code).toBe(committedCode);
+        const functionJp = Query.search(FunctionJp, { name: "update_counter" }).first()!;
+        expect(Query.searchFrom(functionJp, ExprStmt).get().length).toBe(2);
+        expect(() => transaction.record(() => {})).toThrow();
+    });
+});
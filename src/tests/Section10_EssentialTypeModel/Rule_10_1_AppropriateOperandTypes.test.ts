@@ -0,0 +1,72 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+
+const passingCode = `
+#include <stdint.h>
+#include <stdbool.h>
+
+enum Gear_10_1 { PARK_10_1, DRIVE_10_1 };
+
+static void test_10_1_2(int32_t s32a, uint32_t u32a, bool flag, enum Gear_10_1 gear) {
+    int32_t s32b;
+    uint32_t u32b;
+    bool b;
+
+    u32b = u32a & 0x0FU;            /* Compliant */
+    u32b = u32a << 2;               /* Compliant - non-negative constant shift amount */
+    s32b = -s32a;                   /* Compliant */
+    b = flag && (s32a > 0);         /* Compliant */
+    b = gear == PARK_10_1;          /* Compliant */
+    s32b = (s32a != 0) ? 1 : 0;     /* Compliant */
+    u32b |= 0x10U;                  /* Compliant */
+}
+`;
+
+const failingCode = `
+#include <stdint.h>
+#include <stdbool.h>
+
+enum Colour_10_1 { RED_10_1, GREEN_10_1 };
+
+static void test_10_1_1(int32_t s32a, uint32_t u32a, bool flag, float f32a, enum Colour_10_1 colour, char ch) {
+    int32_t s32b;
+    uint32_t u32b;
+    bool b;
+
+    u32b = u32a & 0x0F;             /* Non-compliant - signed operand of & */
+    u32b = u32a << s32a;            /* Non-compliant - signed shift amount */
+    s32b = -u32a;                   /* Non-compliant - unsigned operand of unary - */
+    s32b = s32a + flag;             /* Non-compliant - Boolean operand of + */
+    b = flag && s32a;               /* Non-compliant - signed operand of && */
+    s32b = colour * 2;              /* Non-compliant - enum operand of * */
+    s32b = ch * 2;                  /* Non-compliant - character operand of * */
+    b = !f32a;                      /* Non-compliant - floating operand of ! */
+    s32b = s32a ? 1 : 0;            /* Non-compliant - signed condition */
+    u32b |= 0x10;                   /* Non-compliant - signed operand of |= */
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode },
+    { name: "good.c", code: passingCode }
+];
+
+describe("Rule 10.1", () => {
+    registerSourceCode(files);
+
+    it("should detect errors in bad.c", () => {
+        expect(countMISRAErrors()).toBe(12);
+        expect(countMISRAErrors("10.1")).toBe(10);
+
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!)).toBe(12);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!)).toBe(0);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!, "10.1")).toBe(10);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!, "10.1")).toBe(0);
+    });
+
+    it("should not correct errors in bad.c", () => {
+        expect(countErrorsAfterCorrection()).toBe(12);
+        expect(countErrorsAfterCorrection("10.1")).toBe(10);
+    });
+});
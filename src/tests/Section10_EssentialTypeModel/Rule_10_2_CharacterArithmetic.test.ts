@@ -0,0 +1,52 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+
+const passingCode = `
+#include <stdint.h>
+
+static void test_10_2_2(char ch, int32_t s32a) {
+    char res;
+    int32_t s32b;
+
+    res = ch + 1;                   /* Compliant */
+    res = '0' + s32a;               /* Compliant */
+    s32b = ch - '0';                /* Compliant */
+}
+`;
+
+const failingCode = `
+#include <stdint.h>
+
+static void test_10_2_1(char ch, int32_t s32a, float f32a) {
+    char res;
+
+    res = ch + ch;                  /* Non-compliant - both operands are characters */
+    res = ch + f32a;                /* Non-compliant - floating operand */
+    res = s32a - ch;                /* Non-compliant - character subtracted from a signed value */
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode },
+    { name: "good.c", code: passingCode }
+];
+
+describe("Rule 10.2", () => {
+    registerSourceCode(files);
+
+    it("should detect errors in bad.c", () => {
+        expect(countMISRAErrors()).toBe(6);
+        expect(countMISRAErrors("10.2")).toBe(3);
+
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!)).toBe(6);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!)).toBe(0);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!, "10.2")).toBe(3);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!, "10.2")).toBe(0);
+    });
+
+    it("should not correct errors in bad.c", () => {
+        expect(countErrorsAfterCorrection()).toBe(6);
+        expect(countErrorsAfterCorrection("10.2")).toBe(3);
+    });
+});
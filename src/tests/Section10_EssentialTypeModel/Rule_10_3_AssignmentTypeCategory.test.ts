@@ -0,0 +1,83 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+
+const passingCode = `
+#include <stdint.h>
+#include <stdbool.h>
+
+enum Level_10_3 { LOW_10_3, HIGH_10_3 };
+
+static uint16_t widen_10_3(uint8_t value) {
+    return value;                   /* Compliant - wider type */
+}
+
+static void test_10_3_2(int32_t s32a, uint8_t u8a, char ch, enum Level_10_3 level) {
+    uint32_t u32b = 5;              /* Compliant - non-negative constant that fits */
+    int32_t s32b;
+    bool b = true;                  /* Compliant */
+    char ch2;
+    float f32b;
+    enum Level_10_3 other = LOW_10_3;  /* Compliant - same enumeration */
+
+    s32b = s32a + 1;                /* Compliant */
+    u32b = u8a;                     /* Compliant - wider type */
+    ch2 = ch;                       /* Compliant */
+    f32b = 1.5f;                    /* Compliant */
+    b = s32a > 0;                   /* Compliant */
+    other = level;                  /* Compliant */
+    u32b = widen_10_3(u8a);         /* Compliant */
+}
+`;
+
+const failingCode = `
+#include <stdint.h>
+#include <stdbool.h>
+
+enum Colour_10_3 { RED_10_3, GREEN_10_3 };
+
+static void take_10_3(uint8_t value) {
+    (void) value;
+}
+
+static int16_t narrow_10_3(int32_t value) {
+    return value;                   /* Non-compliant - narrower type */
+}
+
+static void test_10_3_1(int32_t s32a, uint32_t u32a) {
+    uint8_t u8a = 300;              /* Non-compliant - constant does not fit */
+    int32_t s32b;
+    uint32_t u32b;
+    enum Colour_10_3 colour;
+    bool b;
+    float f32b;
+
+    s32b = u32a;                    /* Non-compliant - unsigned to signed */
+    u32b = s32a;                    /* Non-compliant - signed to unsigned */
+    colour = 1;                     /* Non-compliant - signed to enum */
+    b = s32a;                       /* Non-compliant - signed to Boolean */
+    f32b = s32a;                    /* Non-compliant - signed to floating */
+    f32b = 1.5;                     /* Non-compliant - double to float */
+    take_10_3(u32a);                /* Non-compliant - narrower argument */
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode },
+    { name: "good.c", code: passingCode }
+];
+
+describe("Rule 10.3", () => {
+    registerSourceCode(files);
+
+    it("should detect errors in bad.c", () => {
+        expect(countMISRAErrors("10.3")).toBe(9);
+
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!, "10.3")).toBe(9);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!, "10.3")).toBe(0);
+    });
+
+    it("should not correct errors in bad.c", () => {
+        expect(countErrorsAfterCorrection("10.3")).toBe(9);
+    });
+});
@@ -0,0 +1,68 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+
+const passingCode = `
+#include <stdint.h>
+#include <stdbool.h>
+
+enum Level_10_5 { LOW_10_5, HIGH_10_5 };
+
+static void test_10_5_2(int32_t s32a, float f32a, enum Level_10_5 level) {
+    bool b;
+    int32_t s32b;
+    float f32b;
+    char ch;
+    enum Level_10_5 other;
+
+    b = (bool) 0;                   /* Compliant - constant 0 */
+    s32b = (int32_t) f32a;          /* Compliant */
+    f32b = (float) s32a;            /* Compliant */
+    ch = (char) s32a;               /* Compliant */
+    other = (enum Level_10_5) level;  /* Compliant - same enumeration */
+}
+`;
+
+const failingCode = `
+#include <stdint.h>
+#include <stdbool.h>
+
+enum Mode_10_5 { OFF_10_5, ON_10_5 };
+
+static void test_10_5_1(int32_t s32a, bool flag, float f32a, char ch) {
+    bool b;
+    int32_t s32b;
+    enum Mode_10_5 mode;
+    float f32b;
+
+    b = (bool) s32a;                /* Non-compliant */
+    s32b = (int32_t) flag;          /* Non-compliant */
+    mode = (enum Mode_10_5) s32a;   /* Non-compliant */
+    f32b = (float) ch;              /* Non-compliant */
+    ch = (char) f32a;               /* Non-compliant */
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode },
+    { name: "good.c", code: passingCode }
+];
+
+describe("Rule 10.5", () => {
+    registerSourceCode(files);
+
+    it("should detect errors in bad.c", () => {
+        expect(countMISRAErrors()).toBe(5);
+        expect(countMISRAErrors("10.5")).toBe(5);
+
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!)).toBe(5);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!)).toBe(0);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!, "10.5")).toBe(5);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!, "10.5")).toBe(0);
+    });
+
+    it("should not correct errors in bad.c", () => {
+        expect(countErrorsAfterCorrection()).toBe(5);
+        expect(countErrorsAfterCorrection("10.5")).toBe(5);
+    });
+});
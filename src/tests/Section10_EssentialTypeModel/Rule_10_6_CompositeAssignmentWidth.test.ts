@@ -0,0 +1,62 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+
+const passingCode = `
+#include <stdint.h>
+
+static void test_10_6_2(uint16_t u16a, uint16_t u16b) {
+    uint32_t u32a;
+    uint16_t u16c;
+
+    u32a = (uint32_t) u16a + u16b;  /* Compliant */
+    u16c = u16a + u16b;             /* Compliant - same width */
+    u32a = 1U + 2U;                 /* Compliant - constant expression */
+}
+`;
+
+const failingCode = `
+#include <stdint.h>
+
+static void store_10_6(uint32_t value) {
+    (void) value;
+}
+
+static uint32_t sum_10_6(uint16_t a, uint16_t b) {
+    return a + b;                   /* Non-compliant */
+}
+
+static void test_10_6_1(uint16_t u16a, uint16_t u16b, int16_t s16a, int16_t s16b) {
+    uint32_t u32b = u16a - u16b;    /* Non-compliant */
+    uint32_t u32a;
+    int32_t s32a;
+
+    u32a = u16a + u16b;             /* Non-compliant */
+    s32a = s16a * s16b;             /* Non-compliant */
+    store_10_6(u16a * u16b);        /* Non-compliant */
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode },
+    { name: "good.c", code: passingCode }
+];
+
+describe("Rule 10.6", () => {
+    registerSourceCode(files);
+
+    it("should detect errors in bad.c", () => {
+        expect(countMISRAErrors()).toBe(5);
+        expect(countMISRAErrors("10.6")).toBe(5);
+
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!)).toBe(5);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!)).toBe(0);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!, "10.6")).toBe(5);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!, "10.6")).toBe(0);
+    });
+
+    it("should correct errors in bad.c", () => {
+        expect(countErrorsAfterCorrection()).toBe(0);
+        expect(countErrorsAfterCorrection("10.6")).toBe(0);
+    });
+});
@@ -0,0 +1,54 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+
+const passingCode = `
+#include <stdint.h>
+
+static void test_10_8_2(uint16_t u16a, uint16_t u16b, int32_t s32a, int32_t s32b) {
+    uint32_t u32a;
+    uint16_t u16c;
+    int32_t s32c;
+
+    u32a = (uint32_t) u16a + u16b;      /* Compliant */
+    u16c = (uint16_t) (u16a + u16b);    /* Compliant - narrower type */
+    s32c = (int32_t) (s32a * s32b);     /* Compliant - same type */
+}
+`;
+
+const failingCode = `
+#include <stdint.h>
+
+static void test_10_8_1(uint16_t u16a, uint16_t u16b, int32_t s32a, int32_t s32b) {
+    uint32_t u32a;
+    float f32a;
+
+    u32a = (uint32_t) (u16a + u16b);    /* Non-compliant - wider type */
+    u32a = (uint32_t) (s32a + s32b);    /* Non-compliant - different category (not corrected) */
+    f32a = (float) (s32a / s32b);       /* Non-compliant - different category (not corrected) */
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode },
+    { name: "good.c", code: passingCode }
+];
+
+describe("Rule 10.8", () => {
+    registerSourceCode(files);
+
+    it("should detect errors in bad.c", () => {
+        expect(countMISRAErrors()).toBe(3);
+        expect(countMISRAErrors("10.8")).toBe(3);
+
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!)).toBe(3);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!)).toBe(0);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!, "10.8")).toBe(3);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!, "10.8")).toBe(0);
+    });
+
+    it("should correct errors in bad.c", () => {
+        expect(countErrorsAfterCorrection()).toBe(2);
+        expect(countErrorsAfterCorrection("10.8")).toBe(2);
+    });
+});
@@ -0,0 +1,86 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+import Clava from "@specs-feup/clava/api/clava/Clava.js";
+
+const passingCode = `
+#include <stdint.h>
+
+static int32_t square_13_1(int32_t n) {
+    return n * n;
+}
+
+static int32_t odd_13_1(int32_t n);
+
+static int32_t even_13_1(int32_t n) {
+    if (n == 0) {
+        return 1;
+    }
+    return odd_13_1(n - 1);
+}
+
+static int32_t odd_13_1(int32_t n) {
+    if (n == 0) {
+        return 0;
+    }
+    return even_13_1(n - 1);
+}
+
+static void test_13_1_2(int32_t x) {
+    int32_t a[3] = { square_13_1(x), x + 1, 0 };    /* Compliant - call without side effects */
+    int32_t b[2] = { odd_13_1(x), even_13_1(x) };   /* Compliant - recursive calls without side effects */
+}
+`;
+
+const failingCode = `
+#include <stdint.h>
+
+static int32_t counter_13_1 = 0;
+
+static int32_t next_13_1(void) {
+    counter_13_1++;
+    return counter_13_1;
+}
+
+static int32_t get_13_1(void) {
+    return counter_13_1;
+}
+
+static int32_t wrapper_13_1(void) {
+    return next_13_1();
+}
+
+static void test_13_1_1(int32_t x) {
+    volatile int32_t v = 1;
+    int32_t a[3] = { next_13_1(), get_13_1(), x };  /* Non-compliant - the call modifies a global */
+    int32_t b[3] = { wrapper_13_1(), v, x++ };      /* Non-compliant - indirect modification, volatile access and increment */
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode },
+    { name: "good.c", code: passingCode }
+];
+
+describe("Rule 13.1", () => {
+    if (Clava.getStandard() === "c90")  {
+        it("should skip tests for c90", () => {});
+    } else {
+        registerSourceCode(files);
+
+        it("should detect errors in bad.c", () => {
+            expect(countMISRAErrors()).toBe(4);
+            expect(countMISRAErrors("13.1")).toBe(4);
+
+            expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!)).toBe(4);
+            expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!)).toBe(0);
+            expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!, "13.1")).toBe(4);
+            expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!, "13.1")).toBe(0);
+        });
+
+        it("should not correct errors in bad.c", () => {
+            expect(countErrorsAfterCorrection()).toBe(4);
+            expect(countErrorsAfterCorrection("13.1")).toBe(4);
+        });
+    }
+});
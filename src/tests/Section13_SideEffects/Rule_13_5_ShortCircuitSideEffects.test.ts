@@ -0,0 +1,79 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+
+const passingCode = `
+#include <stdint.h>
+
+static int32_t is_valid_13_5(int32_t n) {
+    return (n > 0) && (n < 100);
+}
+
+static void test_13_5_2(int32_t x, int32_t y) {
+    int32_t r = 0;
+
+    if ((x > 0) && (is_valid_13_5(y) != 0)) {   /* Compliant - call without side effects */
+        r = 1;
+    }
+    if ((x > 0) || (y > 0)) {                   /* Compliant */
+        r = 2;
+    }
+}
+`;
+
+const failingCode = `
+#include <stdint.h>
+
+static int32_t total_13_5 = 0;
+
+static int32_t add_13_5(int32_t n) {
+    total_13_5 += n;
+    return total_13_5;
+}
+
+static int32_t read_13_5(void) {
+    return total_13_5;
+}
+
+static void test_13_5_1(int32_t x, int32_t y) {
+    volatile int32_t v = 0;
+    int32_t r = 0;
+
+    if ((x > 0) && (add_13_5(x) > 10)) {        /* Non-compliant - the call modifies a global */
+        r = 1;
+    }
+    if ((x > 0) || (y++ > 0)) {                 /* Non-compliant */
+        r = 2;
+    }
+    if ((x > 0) && (v > 0)) {                   /* Non-compliant - volatile access */
+        r = 3;
+    }
+    if ((x > 0) && (read_13_5() > y)) {         /* Compliant - the call only reads a global */
+        r = 4;
+    }
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode },
+    { name: "good.c", code: passingCode }
+];
+
+describe("Rule 13.5", () => {
+    registerSourceCode(files);
+
+    it("should detect errors in bad.c", () => {
+        expect(countMISRAErrors()).toBe(4);
+        expect(countMISRAErrors("13.5")).toBe(3);
+
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!)).toBe(3);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!)).toBe(1);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!, "13.5")).toBe(3);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!, "13.5")).toBe(0);
+    });
+
+    it("should not correct errors in bad.c", () => {
+        expect(countErrorsAfterCorrection()).toBe(4);
+        expect(countErrorsAfterCorrection("13.5")).toBe(3);
+    });
+});
@@ -100,15 +100,19 @@ describe("Rule 13.6", () => {
     registerSourceCode(files);
 
     it("should detect errors in bad.c", () => {
-        expect(countMISRAErrors()).toBe(21);
+        expect(countMISRAErrors()).toBe(25);
         expect(countMISRAErrors("13.6")).toBe(21); 
 
         expect(countMISRAErrors(Query.search(FileJp, {name: "misraExample.c"}).first()!)).toBe(2);
-        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!)).toBe(19);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!)).toBe(23);
         expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!)).toBe(0);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "misraExample.c"}).first()!, "13.6")).toBe(2);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!, "13.6")).toBe(19);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!, "13.6")).toBe(0);
     });
 
     it("should correct errors in bad.c", () => {
-        expect(countErrorsAfterCorrection()).toBe(2);
+        expect(countErrorsAfterCorrection()).toBe(3);
+        expect(countErrorsAfterCorrection("13.6")).toBe(2);
     });
 });
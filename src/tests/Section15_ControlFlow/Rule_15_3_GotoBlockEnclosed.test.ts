@@ -0,0 +1,55 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+
+const passingCode = `
+static int test_15_3_1(int a) {
+    if (a > 0) {
+        goto label_15_3_1;
+    }
+    a = 1;
+
+    label_15_3_1:
+        a++;
+    return a;
+}
+`;
+
+const failingCode = `
+static void test_15_3_2(int a) {
+    if (a <= 0) {
+        goto L2;  // Violation of rule 15.3
+    }
+    goto L1;
+    if (a == 0) {
+        goto L1;
+    }
+    goto L2;  // Violation of rule 15.3
+
+L1:
+    if (a > 0) {
+    L2:
+        ;
+    }
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode },
+    { name: "good.c", code: passingCode }
+];
+
+describe("Rule 15.3", () => {
+    registerSourceCode(files);
+
+    it("should detect errors in bad.c", () => {
+        expect(countMISRAErrors()).toBe(2);
+
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!)).toBe(2);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!)).toBe(0);
+    });
+
+    it("should not correct errors in bad.c", () => {
+        expect(countErrorsAfterCorrection()).toBe(2);
+    });
+});
@@ -0,0 +1,74 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+
+const passingCode = `
+static int test_15_4_1(int n) {
+    int i;
+    int j;
+    int found = 0;
+
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < n; j++) {
+            if (j == i) {
+                break;
+            }
+        }
+        if (i == 3) {
+            found = 1;
+            break;
+        }
+    }
+    return found;
+}
+`;
+
+const failingCode = `
+static int test_15_4_2(int n) {
+    int i;
+    int found = 0;
+
+    for (i = 0; i < n; i++) { // Violation of rule 15.4
+        if (i == 3) {
+            break;
+        }
+        if (i == 5) {
+            found = 1;
+            break;
+        }
+    }
+
+    while (n > 0) { // Violation of rule 15.4
+        n--;
+        if (n == 2) {
+            goto end_15_4;
+        }
+        if (n == 4) {
+            break;
+        }
+    }
+
+end_15_4:
+    return found;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode },
+    { name: "good.c", code: passingCode }
+];
+
+describe("Rule 15.4", () => {
+    registerSourceCode(files);
+
+    it("should detect errors in bad.c", () => {
+        expect(countMISRAErrors()).toBe(2);
+
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!)).toBe(2);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!)).toBe(0);
+    });
+
+    it("should not correct errors in bad.c", () => {
+        expect(countErrorsAfterCorrection()).toBe(2);
+    });
+});
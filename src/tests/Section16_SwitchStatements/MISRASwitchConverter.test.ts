@@ -0,0 +1,150 @@
+import { BinaryOp, Call, Cast, Expression, FunctionJp, If, IntLiteral, Joinpoint, Scope, Statement, Switch, UnaryOp, Vardecl, Varref } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import MISRATool from "../../MISRATool.js";
+import { MISRASwitchConverter } from "../../MISRA.js";
+import { EssentialTypeCategory, getEssentialTypeOfType } from "../../utils/EssentialTypeUtils.js";
+import { countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+
+const switchCode = `
+extern unsigned int next_16(void);
+
+static int select_unsigned_16(unsigned int u) {
+    int result = 0;
+    switch (u) {
+        case -1: result = 1; break;
+        case 0: result = 2; break;
+        case 1: result = 3; break;
+        case 2: result = 4; break;
+        default: break;
+    }
+    return result;
+}
+
+static int select_signed_16(int s) {
+    int result = 0;
+    switch (s) {
+        case -2: result = 1; break;
+        case -1: result = 2; break;
+        case 0: result = 3; break;
+        case 1: result = 4; break;
+        default: result = 5; break;
+    }
+    return result;
+}
+
+static int select_hoisted_16(void) {
+    int result = 0;
+    switch (next_16()) {
+        case 1: result = 1; break;
+        case 2: result = 2; break;
+        case 3: result = 3; break;
+        case 5: result = 4; break;
+        default: result = 5; break;
+    }
+    return result;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "switches.c", code: switchCode }
+];
+
+/**
+ * Converts a value to the 32-bit type of the given expression
+ */
+function convert(exprJp: Expression, value: bigint): bigint {
+    return getEssentialTypeOfType(exprJp.type).category === EssentialTypeCategory.UNSIGNED ? BigInt.asUintN(32, value) : BigInt.asIntN(32, value);
+}
+
+/**
+ * Evaluates an expression of the converted code, given the value of the switch condition
+ */
+function evaluate(exprJp: Joinpoint, variable: string, value: bigint): bigint {
+    if (exprJp instanceof Varref && exprJp.name === variable) {
+        return value;
+    } else if (exprJp instanceof IntLiteral) {
+        return BigInt(exprJp.value);
+    } else if (exprJp instanceof UnaryOp && exprJp.operator === "-") {
+        return -evaluate(exprJp.operand, variable, value);
+    } else if (exprJp instanceof Cast) {
+        return convert(exprJp, evaluate(exprJp.children[0], variable, value));
+    } else if (exprJp instanceof BinaryOp) {
+        const left = evaluate(exprJp.left, variable, value);
+        const right = evaluate(exprJp.right, variable, value);
+        if (exprJp.operator === "&&" || exprJp.operator === "||") {
+            const result = exprJp.operator === "&&" ? left !== 0n && right !== 0n : left !== 0n || right !== 0n;
+            return result ? 1n : 0n;
+        }
+
+        // Usual arithmetic conversions of 32-bit operands: unsigned if any operand is unsigned
+        const isUnsigned = [exprJp.left, exprJp.right].some(operandJp => getEssentialTypeOfType(operandJp.type).category === EssentialTypeCategory.UNSIGNED);
+        const [a, b] = isUnsigned ? [BigInt.asUintN(32, left), BigInt.asUintN(32, right)] : [BigInt.asIntN(32, left), BigInt.asIntN(32, right)];
+        const results: Record<string, boolean> = { "==": a === b, "<": a < b, ">": a > b, "<=": a <= b, ">=": a >= b };
+        return results[exprJp.operator] ? 1n : 0n;
+    } else if (exprJp.children.length === 1) { // Parentheses and implicit conversions of the case values
+        return evaluate(exprJp.children[0], variable, value);
+    }
+    throw new Error(`Unexpected expression '${exprJp.code}'`);
+}
+
+/**
+ * Executes the converted statements and returns the value assigned to 'result', or undefined if no clause is selected
+ */
+function run(stmtJp: Joinpoint, variable: string, value: bigint): number | undefined {
+    if (stmtJp instanceof If) {
+        const branchJp = evaluate(stmtJp.cond, variable, value) !== 0n ? stmtJp.then : stmtJp.else;
+        return branchJp !== undefined ? run(branchJp, variable, value) : undefined;
+    } else if (stmtJp instanceof Scope) {
+        for (const childJp of stmtJp.children) {
+            const result = run(childJp, variable, value);
+            if (result !== undefined) {
+                return result;
+            }
+        }
+        return undefined;
+    }
+    const assignment = stmtJp.code.trim().match(/^result\s*=\s*(\d+)\s*;/);
+    return assignment ? Number(assignment[1]) : undefined;
+}
+
+describe("Switch conversion", () => {
+    registerSourceCode(files);
+
+    function convertSwitch(functionName: string): Statement {
+        countMISRAErrors("16.6");
+        const functionJp = Query.search(FunctionJp, {name: functionName}).first()!;
+        const switchJp = Query.searchFrom(functionJp, Switch).first()!;
+        return MISRASwitchConverter.convertToIfStatements(switchJp, { ...MISRATool.context.switchConversionOptions, decisionTreeThreshold: 4 });
+    }
+
+    it("should sort the case values of an unsigned condition after converting them", () => {
+        const ifStmt = convertSwitch("select_unsigned_16");
+
+        expect(ifStmt).toBeInstanceOf(If);
+        expect(Query.searchFromInclusive(ifStmt, If).get().length).toBeGreaterThan(4);
+        expect(run(ifStmt, "u", 0xFFFFFFFFn)).toBe(1);
+        expect(run(ifStmt, "u", 0n)).toBe(2);
+        expect(run(ifStmt, "u", 1n)).toBe(3);
+        expect(run(ifStmt, "u", 2n)).toBe(4);
+        expect(run(ifStmt, "u", 3n)).toBeUndefined();
+        expect(run(ifStmt, "u", 0xFFFFFFFEn)).toBeUndefined();
+    });
+
+    it("should select the clauses of a signed condition with a decision tree", () => {
+        const ifStmt = convertSwitch("select_signed_16");
+
+        expect(ifStmt).toBeInstanceOf(If);
+        expect([-3n, -2n, -1n, 0n, 1n, 2n].map(value => run(ifStmt, "s", value))).toEqual([5, 1, 2, 3, 4, 5]);
+    });
+
+    it("should evaluate a condition with calls once, in a declared variable", () => {
+        const blockJp = convertSwitch("select_hoisted_16");
+
+        expect(blockJp).toBeInstanceOf(Scope);
+        const tempDecl = Query.searchFrom(blockJp, Vardecl).first()!;
+        expect(tempDecl.type.code).toBe("unsigned int");
+        expect(tempDecl.init?.code).toBe("next_16()");
+        expect(Query.searchFrom(blockJp, Call, {name: "next_16"}).get().length).toBe(1);
+        expect([0n, 1n, 2n, 3n, 4n, 5n].map(value => run(blockJp, tempDecl.name, value))).toEqual([5, 1, 2, 3, 5, 4]);
+    });
+});
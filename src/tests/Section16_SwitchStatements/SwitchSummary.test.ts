@@ -0,0 +1,80 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { FunctionJp, Switch } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRATool from "../../MISRATool.js";
+import { MISRATransformationType } from "../../MISRA.js";
+import Rule_16_4_SwitchHasDefault from "../../rules/Section16_SwitchStatements/Rule_16_4_SwitchHasDefault.js";
+import Rule_16_5_DefaultFirstOrLast from "../../rules/Section16_SwitchStatements/Rule_16_5_DefaultFirstOrLast.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+
+const failingCode = 
+`static void foo16_summary_1( void )
+{
+    int x;
+    switch ( x ) { /* Violation of rule 16.4 */
+        case 0:
+            ++x;
+            break;
+        case 1:
+            break;
+    }
+}
+
+static void foo16_summary_2( void )
+{
+    int x;
+    switch ( x ) {
+        case 0:
+            ++x;
+            break;
+        default: /* Violation of rule 16.5 */
+            break;
+        case 1:
+            break;
+    }
+}`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode }
+];
+
+describe("Switch summary", () => {
+    registerSourceCode(files);
+
+    function getSwitch(functionName: string): Switch {
+        return Query.searchFrom(Query.search(FunctionJp, {name: functionName}).first()!, Switch).first()!;
+    }
+
+    it("should summarize the switch again after a rule rewrites it in the same iteration", () => {
+        countMISRAErrors();
+        const context = MISRATool.context;
+        const rule_16_4 = new Rule_16_4_SwitchHasDefault(context);
+        const rule_16_5 = new Rule_16_5_DefaultFirstOrLast(context);
+
+        // 16.4 adds a default case, which 16.5 must see as the last label
+        const missingDefault = getSwitch("foo16_summary_1");
+        expect(context.getSwitchSummary(missingDefault).hasDefault).toBe(false);
+        expect(rule_16_4.apply(missingDefault).type).toBe(MISRATransformationType.DescendantChange);
+
+        const addedSummary = context.getSwitchSummary(missingDefault);
+        expect(addedSummary.hasDefault).toBe(true);
+        expect(addedSummary.cases.length).toBe(3);
+        expect(addedSummary.defaultIndex).toBe(2);
+        expect(rule_16_5.match(missingDefault)).toBe(false);
+
+        // 16.5 moves the default case to the end
+        const misplacedDefault = getSwitch("foo16_summary_2");
+        expect(context.getSwitchSummary(misplacedDefault).defaultIndex).toBe(1);
+        expect(rule_16_5.apply(misplacedDefault).type).toBe(MISRATransformationType.DescendantChange);
+
+        const movedSummary = context.getSwitchSummary(misplacedDefault);
+        expect(movedSummary.defaultIndex).toBe(movedSummary.cases.length - 1);
+        expect(rule_16_5.match(misplacedDefault)).toBe(false);
+        expect(rule_16_4.match(misplacedDefault)).toBe(false);
+    });
+
+    it("should correct both violations", () => {
+        expect(countMISRAErrors("16.4") + countMISRAErrors("16.5")).toBe(2);
+        countErrorsAfterCorrection();
+        expect(MISRATool.context.activeErrors.filter(error => error.ruleID === "16.4" || error.ruleID === "16.5").length).toBe(0);
+    });
+});
@@ -1,4 +1,7 @@
 import Clava from "@specs-feup/clava/api/clava/Clava.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRATool from "../../MISRATool.js";
 import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
 import path from "path";
 import { fileURLToPath } from "url";
@@ -21,9 +24,11 @@ double test_17_3_1() {
 const passingCode2 = `
 extern int foo_17_3();
 extern double test_17_3_1();
+extern double scale_17_3(double value, double factor);
+extern int sum_17_3(int count, ...);
 
 double test_17_3_4() {
-    return foo_17_3() + test_17_3_1();
+    return foo_17_3() + test_17_3_1() + scale_17_3(1.0, 2.0) + sum_17_3(1, 2);
 }
 `;
 
@@ -75,12 +80,32 @@ static unsigned int test_17_3_3() {
 }
 `;
 
+const passingCode3 = `
+double scale_17_3(double value, double factor) {
+    return value * factor;
+}
+
+int sum_17_3(int count, ...) {
+    return count;
+}
+`;
+
+// Externs that do not match the calls
+const failingCode4 = `
+static double test_17_3_5() {
+    double scaled = scale_17_3(2.0); // Violation of rule 17.3 (the definition in good3.c has two parameters)
+    return scaled + sum_17_3(2, 1, 2); // Violation of rule 17.3 (the definition in good3.c is variadic)
+}
+`;
+
 const files: TestFile[] = [
     { name: "bad1.c", code: failingCode },
     { name: "bad2.c", code: failingCode2 },
     { name: "bad3.c", code: failingCode3 },
     { name: "good.c", code: passingCode },
-    { name: "good2.c", code:passingCode2 }
+    { name: "good2.c", code:passingCode2 },
+    { name: "bad4.c", code: failingCode4 },
+    { name: "good3.c", code: passingCode3 }
 ];
 
 describe("Rule 17.3", () => {
@@ -96,12 +121,26 @@ describe("Rule 17.3", () => {
         registerSourceCode(files, configFilePath);
 
         it("should detect errors", () => {
-            expect(countMISRAErrors()).toBe(8);  
-            expect(countMISRAErrors("17.3")).toBe(8); 
+            expect(countMISRAErrors()).toBe(17);
+            expect(countMISRAErrors("17.3")).toBe(10); 
         });
 
         it("should correct errors", () => {
-            expect(countErrorsAfterCorrection()).toBe(0);
+            expect(countErrorsAfterCorrection()).toBe(9);
+            expect(countErrorsAfterCorrection("17.3")).toBe(1);
+        });
+
+        it("should not add externs whose signature is incompatible with the call", () => {
+            countMISRAErrors();
+            countErrorsAfterCorrection();
+
+            const errors = MISRATool.context.activeErrors.filter(error => error.ruleID === "17.3");
+            expect(errors.length).toBe(1);
+            expect(errors[0].message).toContain("is incompatible with the call");
+
+            const fileJp = Query.search(FileJp, { name: "bad4.c" }).first()!;
+            expect(fileJp.code).not.toContain("extern double scale_17_3");
+            expect(fileJp.code).toContain("extern int sum_17_3");
         });
     }
 });
\ No newline at end of file
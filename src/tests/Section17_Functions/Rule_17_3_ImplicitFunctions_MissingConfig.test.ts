@@ -86,13 +86,14 @@ describe("Rule 17.3 (without config)", () => {
         registerSourceCode(files);
 
         it("should detect errors", () => {
-            expect(countMISRAErrors()).toBe(11);  
+            expect(countMISRAErrors()).toBe(17);
             expect(countMISRAErrors("17.3")).toBe(11); 
 
         });
 
         it("should correct errors", () => {
-            expect(countErrorsAfterCorrection()).toBe(11);
+            expect(countErrorsAfterCorrection()).toBe(17);
+            expect(countErrorsAfterCorrection("17.3")).toBe(11);
         });
     }
 });
\ No newline at end of file
@@ -59,13 +59,14 @@ describe("Rule 17.3 (without config)", () => {
         registerSourceCode(files);
 
         it("should detect errors", () => {
-            expect(countMISRAErrors()).toBe(6);  
+            expect(countMISRAErrors()).toBe(8);
             expect(countMISRAErrors("17.3")).toBe(5); 
 
         });
 
         it("should correct errors", () => {
-            expect(countErrorsAfterCorrection()).toBe(5);
+            expect(countErrorsAfterCorrection()).toBe(7);
+            expect(countErrorsAfterCorrection("17.3")).toBe(5);
         });
     }
 });
\ No newline at end of file
@@ -0,0 +1,101 @@
+import Clava from "@specs-feup/clava/api/clava/Clava.js";
+import { FileJp, FunctionJp, Program } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import MISRATool from "../../MISRATool.js";
+import { MISRATransformationType } from "../../MISRA.js";
+import Rule_17_3_ImplicitFunction from "../../rules/Section17_Functions/Rule_17_3_ImplicitFunction.js";
+import { countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import path from "path";
+import { fileURLToPath } from "url";
+
+const helpersCode = `
+int helper_17_3(int value) {
+    return value;
+}
+
+int header_helper_17_3(int value) {
+    return value + 1;
+}
+`;
+
+const callerCode = `
+static int test_17_3_7(void) {
+    return helper_17_3(1); // Violation of rule 17.3
+}
+`;
+
+const untouchedCode = `
+static int untouched_17_3(void) {
+    return 0;
+}
+`;
+
+const headerCode = `
+static int test_17_3_8(void) {
+    return header_helper_17_3(2); // Violation of rule 17.3
+}
+`;
+
+const headerUserCode = `
+#include "header_caller.h"
+
+static int use_header_17_3(void) {
+    return test_17_3_8();
+}
+`;
+
+const sourceFiles: TestFile[] = [
+    { name: "helpers.c", code: helpersCode },
+    { name: "caller.c", code: callerCode },
+    { name: "untouched.c", code: untouchedCode }
+];
+
+const headerFiles: TestFile[] = [
+    { name: "helpers.c", code: helpersCode },
+    { name: "header_caller.h", code: headerCode },
+    { name: "header_user.c", code: headerUserCode },
+    { name: "untouched.c", code: untouchedCode }
+];
+
+const __filename = fileURLToPath(import.meta.url);
+const __dirname = path.dirname(__filename);
+const configFilePath = path.join(__dirname, "rebuild_misra_config.json");
+
+function applyRule(): MISRATransformationType {
+    const rule = new Rule_17_3_ImplicitFunction(MISRATool.context);
+    return rule.apply(Query.root() as Program).type;
+}
+
+describe("Rule 17.3 rebuild of modified files", () => {
+    if (Clava.getStandard() !== "c90")  {
+        it("should skip tests for c99 and c11", () => {});
+    } else {
+        describe("with fixes in source files", () => {
+            registerSourceCode(sourceFiles, configFilePath);
+
+            it("should rebuild only the modified source file", () => {
+                expect(countMISRAErrors("17.3")).toBe(1);
+                const untouchedId = Query.search(FunctionJp, {name: "untouched_17_3"}).first()!.astId;
+                const callerId = Query.search(FunctionJp, {name: "test_17_3_7"}).first()!.astId;
+
+                expect(applyRule()).toBe(MISRATransformationType.DescendantChange);
+                expect(Query.search(FunctionJp, {name: "untouched_17_3"}).first()!.astId).toBe(untouchedId);
+                expect(Query.search(FunctionJp, {name: "test_17_3_7"}).first()!.astId).not.toBe(callerId);
+                expect(Query.search(FileJp, {name: "caller.c"}).first()!.code).toContain("extern int helper_17_3");
+            });
+        });
+
+        describe("with fixes in headers", () => {
+            registerSourceCode(headerFiles, configFilePath);
+
+            it("should rebuild the whole program when a header is modified", () => {
+                expect(countMISRAErrors("17.3")).toBe(1);
+                const untouchedId = Query.search(FunctionJp, {name: "untouched_17_3"}).first()!.astId;
+
+                expect(applyRule()).toBe(MISRATransformationType.Replacement);
+                expect(Query.search(FunctionJp, {name: "untouched_17_3"}).first()!.astId).not.toBe(untouchedId);
+                expect(Query.search(FileJp, {name: "header_caller.h"}).first()!.code).toContain("extern int header_helper_17_3");
+            });
+        });
+    }
+});
@@ -0,0 +1,88 @@
+import Clava from "@specs-feup/clava/api/clava/Clava.js";
+import { Call, FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import MISRATool from "../../MISRATool.js";
+import Rule_17_3_ImplicitFunction from "../../rules/Section17_Functions/Rule_17_3_ImplicitFunction.js";
+import { ImplicitCallResolver } from "../../utils/CallUtils.js";
+import { countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+
+const implicitCode = `
+static int apply_17_3(int (*callback)(int), int value) {
+    return callback(value);
+}
+
+static int twice_17_3(int value) {
+    return value * 2;
+}
+
+static void test_17_3_5() {
+    int a = helper_17_3(1); // Violation of rule 17.3
+    int b = helper_17_3(2); // Violation of rule 17.3
+    int c = apply_17_3(twice_17_3, 3);
+}
+`;
+
+const explicitCode = `
+static int square_17_3(int value) {
+    return value * value;
+}
+
+static void test_17_3_6() {
+    int a = square_17_3(2);
+}
+`;
+
+const files: TestFile[] = [
+    { name: "implicit.c", code: implicitCode },
+    { name: "explicit.c", code: explicitCode }
+];
+
+describe("Rule 17.3 implicit call resolver", () => {
+    if (Clava.getStandard() !== "c90")  {
+        it("should skip tests for c99 and c11", () => {});
+    } else {
+        registerSourceCode(files);
+
+        function getFile(name: string): FileJp {
+            return Query.search(FileJp, {name}).first()!;
+        }
+
+        it("should index the implicit calls, their ordinals and the calls through pointers", () => {
+            const resolver = new ImplicitCallResolver(getFile("implicit.c"));
+            const helperCalls = Query.searchFrom(getFile("implicit.c"), Call, {name: "helper_17_3"}).get();
+            const pointerCall = Query.searchFrom(getFile("implicit.c"), Call, {name: "callback"}).first()!;
+
+            expect(resolver.implicitCalls.map(callJp => callJp.astId)).toEqual(helperCalls.map(callJp => callJp.astId));
+            expect(resolver.getOrdinal(helperCalls[1])).toBe(1);
+            expect(resolver.getCall("helper_17_3", 1)?.astId).toBe(helperCalls[1].astId);
+            expect(resolver.isImplicitCall(pointerCall)).toBe(false);
+        });
+
+        it("should reuse the resolver of a file only within an iteration", () => {
+            expect(countMISRAErrors("17.3")).toBe(2);
+
+            const rule = new Rule_17_3_ImplicitFunction(MISRATool.context);
+            const fileJp = getFile("implicit.c");
+            const resolver = rule["getResolver"](fileJp);
+
+            expect(rule["getResolver"](fileJp)).toBe(resolver);
+            expect(rule["getResolver"](getFile("explicit.c"))).not.toBe(resolver);
+
+            MISRATool.context.nextIteration();
+            expect(rule["getResolver"](fileJp)).not.toBe(resolver);
+        });
+
+        it("should build a new resolver for a rebuilt file", () => {
+            countMISRAErrors("17.3");
+
+            const rule = new Rule_17_3_ImplicitFunction(MISRATool.context);
+            const resolver = rule["getResolver"](getFile("implicit.c"));
+            const rebuiltFile = getFile("implicit.c").rebuild();
+            const rebuiltResolver = rule["getResolver"](rebuiltFile);
+
+            expect(rebuiltResolver).not.toBe(resolver);
+            expect(rebuiltResolver.fileJp.astId).toBe(rebuiltFile.astId);
+            expect(rebuiltResolver.implicitCalls.length).toBe(2);
+        });
+    }
+});
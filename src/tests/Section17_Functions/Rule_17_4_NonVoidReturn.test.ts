@@ -1,6 +1,7 @@
 import Query from "@specs-feup/lara/api/weaver/Query.js";
 import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
 import { FileJp } from "@specs-feup/clava/api/Joinpoints.js"; 
+import MISRATool from "../../MISRATool.js";
 import path from "path";
 import { fileURLToPath } from "url";
 
@@ -120,12 +121,46 @@ static int absolute (int32_t v) {  // Violation of rule 17.4
 }
 `;
 
+const gotoCode = `
+static int test_17_4_14(int x) { // Violation of rule 17.4
+    if (x) {
+        goto L;
+    }
+    return 1;
+L:
+    ;
+}
+
+static int test_17_4_15(int x) {
+    if (x) {
+        goto L;
+    }
+    return 1;
+L:
+    return 2;
+}
+`;
+
+/*
+    Non-compliant after correction:
+    Config file specifies a non-null integer as the default value for 'char *' type
+*/
+const pointerCode = `
+static char *test_17_4_16(int x) { // Violation of rule 17.4
+    if (x) {
+        return "value";
+    }
+}
+`;
+
 const files: TestFile[] = [
     { name: "bad1.c", code: failingCode },
     { name: "bad2.c", code: failingCode2 },
     { name: "bad3.c", code: failingCode3 },
     { name: "good.c", code: passingCode },
     { name: "misraExample.c", code: misraExample },
+    { name: "goto.c", code: gotoCode },
+    { name: "pointer.c", code: pointerCode },
 ];
 
 describe("Rule 17.4", () => {
@@ -138,15 +173,37 @@ describe("Rule 17.4", () => {
     registerSourceCode(files, configFilePath);
 
     it("should detect errors", () => {
-        expect(countMISRAErrors()).toBe(9);
+        expect(countMISRAErrors()).toBe(11);
         expect(countMISRAErrors(Query.search(FileJp, { name: "bad1.c" }).first()!)).toBe(1);
         expect(countMISRAErrors(Query.search(FileJp, { name: "bad2.c" }).first()!)).toBe(1);
         expect(countMISRAErrors(Query.search(FileJp, { name: "bad3.c" }).first()!)).toBe(6);
         expect(countMISRAErrors(Query.search(FileJp, { name: "good.c" }).first()!)).toBe(0);
         expect(countMISRAErrors(Query.search(FileJp, { name: "misraExample.c" }).first()!)).toBe(1);
+        expect(countMISRAErrors(Query.search(FileJp, { name: "goto.c" }).first()!)).toBe(1);
+        expect(countMISRAErrors(Query.search(FileJp, { name: "pointer.c" }).first()!)).toBe(1);
+
+        expect(countMISRAErrors("17.4")).toBe(11);
+        expect(countMISRAErrors(Query.search(FileJp, { name: "bad1.c" }).first()!, "17.4")).toBe(1);
+        expect(countMISRAErrors(Query.search(FileJp, { name: "bad2.c" }).first()!, "17.4")).toBe(1);
+        expect(countMISRAErrors(Query.search(FileJp, { name: "bad3.c" }).first()!, "17.4")).toBe(6);
+        expect(countMISRAErrors(Query.search(FileJp, { name: "good.c" }).first()!, "17.4")).toBe(0);
+        expect(countMISRAErrors(Query.search(FileJp, { name: "misraExample.c" }).first()!, "17.4")).toBe(1);
+        expect(countMISRAErrors(Query.search(FileJp, { name: "goto.c" }).first()!, "17.4")).toBe(1);
+        expect(countMISRAErrors(Query.search(FileJp, { name: "pointer.c" }).first()!, "17.4")).toBe(1);
     });
 
     it("should correct errors", () => {
-        expect(countErrorsAfterCorrection()).toBe(2);
+        expect(countErrorsAfterCorrection()).toBe(3);
+        expect(countErrorsAfterCorrection("17.4")).toBe(3);
+    });
+
+    it("should not insert default values that cannot convert to the return type", () => {
+        countMISRAErrors();
+        countErrorsAfterCorrection();
+
+        const pointerErrors = MISRATool.context.activeErrors.filter(error => error.ruleID === "17.4" && error.message.includes("'char *'"));
+        expect(pointerErrors.length).toBe(1);
+        expect(pointerErrors[0].message).toContain("is invalid and was therefore not inserted");
+        expect(Query.search(FileJp, { name: "pointer.c" }).first()!.code).not.toContain("return 1;");
     });
 });
@@ -0,0 +1,47 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+
+const headerCode = `
+#ifndef UTIL_H
+#define UTIL_H
+#define UTIL_VALUE 1
+#endif
+`;
+
+const passingCode = `
+#include "lib/util.h"
+
+static int test_20_2_1(void) {
+    return UTIL_VALUE;
+}
+`;
+
+const failingCode = `
+#include "lib//util.h" // Violation of rule 20.2
+
+static int test_20_2_2(void) {
+    return UTIL_VALUE;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode },
+    { name: "good.c", code: passingCode },
+    { name: "util.h", code: headerCode, path: "lib" }
+];
+
+describe("Rule 20.2", () => {
+    registerSourceCode(files);
+
+    it("should detect errors in bad.c", () => {
+        expect(countMISRAErrors()).toBe(1);
+
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!)).toBe(1);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!)).toBe(0);
+    });
+
+    it("should not correct errors in bad.c", () => {
+        expect(countErrorsAfterCorrection()).toBe(1);
+    });
+});
@@ -52,11 +52,12 @@ describe("Rule 21.10", () => {
     registerSourceCode(files, configFilePath);
 
     it("should detect errors", () => {
-        expect(countMISRAErrors()).toBe(3);
+        expect(countMISRAErrors()).toBe(5);
         expect(countMISRAErrors("21.10")).toBe(3);
     });
 
     it("should correct errors", () => {
         expect(countErrorsAfterCorrection()).toBe(0);
+        expect(countErrorsAfterCorrection("21.10")).toBe(0);
     });
 });
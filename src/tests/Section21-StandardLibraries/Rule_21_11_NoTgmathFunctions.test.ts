@@ -56,12 +56,13 @@ describe("Rule 21.11", () => {
         registerSourceCode(files, configFilePath);
 
         it("should detect errors", () => {
-            expect(countMISRAErrors()).toBe(2);
+            expect(countMISRAErrors()).toBe(4);
             expect(countMISRAErrors("21.11")).toBe(2);
         });
 
         it("should correct errors", () => {
-            expect(countErrorsAfterCorrection()).toBeLessThan(2);
+            expect(countErrorsAfterCorrection()).toBeLessThan(4);
+            expect(countErrorsAfterCorrection("21.11")).toBeLessThan(2);
         });
     }
 });
@@ -0,0 +1,95 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { BinaryOp, Call, FileJp, FunctionJp } from "@specs-feup/clava/api/Joinpoints.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import path from "path";
+import { fileURLToPath } from "url";
+
+const failingCode = `
+#include <stdlib.h>
+
+int main() {
+    int *a = calloc(1, sizeof(int));
+    int *b = malloc(sizeof(int));
+    a = realloc(a, 2 * sizeof(int));
+    free(a);
+    free(b);
+    return 0;
+}
+`;
+
+const providedPool = `
+#include <stddef.h>
+
+void *misra_pool_malloc(size_t size) {
+    (void) size;
+    return NULL;
+}
+`;
+
+const failingCode2 = `
+#include <stdlib.h>
+
+int main() {
+    int *b = malloc(sizeof(int));
+    free(b);
+    return 0;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad1.c", code: failingCode }
+];
+
+const providedFiles: TestFile[] = [
+    { name: "misra_pool.c", code: providedPool },
+    { name: "bad2.c", code: failingCode2 }
+];
+
+describe("Rule 21.3", () => {
+    const __filename = fileURLToPath(import.meta.url);
+    const __dirname = path.dirname(__filename);
+    const configFilename = "pool_misra_config.json";
+    const configFilePath = path.join(__dirname, configFilename);
+
+    registerSourceCode(files, configFilePath);
+
+    it("should detect errors", () => {
+        expect(countMISRAErrors()).toBe(5);
+    });
+
+    it("should correct errors with the generated pool allocator", () => {
+        expect(countErrorsAfterCorrection()).toBe(0);
+
+        const poolFile = Query.search(FileJp, {name: "misra_pool.c"}).first();
+        expect(poolFile).toBeDefined();
+
+        const badFile = Query.search(FileJp, {name: "bad1.c"}).first()!;
+        const callNames = Query.searchFrom(badFile, Call).get().map(callJp => callJp.name);
+        expect(callNames.sort()).toEqual(["misra_pool_calloc", "misra_pool_free", "misra_pool_free", "misra_pool_malloc", "misra_pool_realloc"]);
+    });
+
+    it("should find the pool of a released block without ordering pointers to different arrays", () => {
+        countErrorsAfterCorrection();
+
+        const poolOf = Query.search(FunctionJp, {name: "misra_pool_of"}).first()!;
+        const pointerComparisons = Query.searchFrom(poolOf, BinaryOp).get().filter(opJp => opJp.left.type.isPointer);
+        expect(pointerComparisons.length).toBeGreaterThan(0);
+        expect(pointerComparisons.every(opJp => opJp.operator === "==")).toBe(true);
+    });
+});
+
+describe("Rule 21.3 with a provided pool allocator", () => {
+    const __filename = fileURLToPath(import.meta.url);
+    const __dirname = path.dirname(__filename);
+    const configFilePath = path.join(__dirname, "pool_misra_config.json");
+
+    registerSourceCode(providedFiles, configFilePath);
+
+    it("should not use a file that does not define the replacements of the calls", () => {
+        expect(countMISRAErrors("21.3")).toBe(2);
+        expect(countErrorsAfterCorrection("21.3")).toBe(2);
+
+        const poolFile = Query.search(FileJp, {name: "misra_pool.c"}).first()!;
+        expect(Query.searchFrom(poolFile, FunctionJp).get().map(functionJp => functionJp.name)).toEqual(["misra_pool_malloc"]);
+    });
+});
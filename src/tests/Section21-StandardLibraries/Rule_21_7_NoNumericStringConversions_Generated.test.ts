@@ -0,0 +1,58 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { Call, FileJp, FunctionJp, Loop } from "@specs-feup/clava/api/Joinpoints.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import path from "path";
+import { fileURLToPath } from "url";
+
+const failingCode = `
+#include <stdlib.h>
+
+static long test_21_7_3(const char *text) {
+    double d = atof(text);
+    int i = atoi(text);
+    short s = (short) atoi(text);
+    long l;
+    l = atol(text);
+    return (long) d + (long) i + (long) s + l;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad1.c", code: failingCode }
+];
+
+describe("Rule 21.7", () => {
+    const __filename = fileURLToPath(import.meta.url);
+    const __dirname = path.dirname(__filename);
+    const configFilename = "conversion_misra_config.json";
+    const configFilePath = path.join(__dirname, configFilename);
+
+    registerSourceCode(files, configFilePath);
+
+    it("should detect errors", () => {
+        expect(countMISRAErrors("21.7")).toBe(4);
+    });
+
+    it("should correct errors with the generated conversions", () => {
+        expect(countErrorsAfterCorrection("21.7")).toBe(0);
+
+        const conversionsFile = Query.search(FileJp, {name: "misra_conversions.c"}).first()!;
+        const conversions = Query.searchFrom(conversionsFile, FunctionJp, {isImplementation: true}).get().map(functionJp => functionJp.name);
+        expect(conversions).toEqual(expect.arrayContaining(["misra_to_double", "misra_to_int", "misra_to_short", "misra_to_long", "misra_conversion_status"]));
+
+        const badFile = Query.search(FileJp, {name: "bad1.c"}).first()!;
+        const callNames = Query.searchFrom(badFile, Call).get().map(callJp => callJp.name);
+        expect(callNames.sort()).toEqual(["misra_to_double", "misra_to_int", "misra_to_long", "misra_to_short"]);
+    });
+
+    it("should scale floating values by a single power of ten", () => {
+        countErrorsAfterCorrection("21.7");
+
+        const toDouble = Query.search(FunctionJp, {name: "misra_to_double", isImplementation: true}).first()!;
+        const powerCalls = Query.searchFrom(toDouble, Call, {name: "misra_conversion_power_of_ten"}).get();
+        expect(powerCalls.length).toBe(3);
+
+        // Only the digits and the exponent are parsed in loops
+        expect(Query.searchFrom(toDouble, Loop).get().length).toBe(3);
+    });
+});
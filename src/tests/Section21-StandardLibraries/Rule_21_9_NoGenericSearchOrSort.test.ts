@@ -79,11 +79,12 @@ describe("Rule 21.9", () => {
     registerSourceCode(files, configFilePath);
 
     it("should detect errors", () => {
-        expect(countMISRAErrors()).toBe(2);  
+        expect(countMISRAErrors()).toBe(8);
         expect(countMISRAErrors("21.9")).toBe(2); 
     });
 
     it("should correct errors", () => {
-        expect(countErrorsAfterCorrection()).toBe(0);
+        expect(countErrorsAfterCorrection()).toBe(6);
+        expect(countErrorsAfterCorrection("21.9")).toBe(0);
     });
 });
@@ -0,0 +1,81 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { Call, FileJp, FunctionJp } from "@specs-feup/clava/api/Joinpoints.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+
+const bad = `
+#include <stdlib.h>
+
+struct sample_21_9 {
+    int id;
+    double value;
+};
+
+static int compare_ints(const void* a, const void* b) {
+    int arg1 = *(const int*)a;
+    int arg2 = *(const int*)b;
+    return (arg1 > arg2) ? 1 : ((arg1 < arg2) ? -1 : 0);
+}
+
+static int compare_samples(const void* a, const void* b) {
+    const struct sample_21_9 *s1 = (const struct sample_21_9*)a;
+    const struct sample_21_9 *s2 = (const struct sample_21_9*)b;
+    return (s1->id > s2->id) ? 1 : ((s1->id < s2->id) ? -1 : 0);
+}
+
+static int test_21_9_2(void) {
+    int arr[] = { 5, 3, 1, 4, 2 };
+    struct sample_21_9 samples[3] = { {3, 0.5}, {1, 1.5}, {2, 2.5} };
+    int key = 3;
+    int* item;
+
+    qsort(arr, 5, sizeof(int), compare_ints); /* Non-compliant */
+    qsort(samples, 3, sizeof(samples[0]), compare_samples); /* Non-compliant */
+    item = (int*)bsearch(&key, arr, 5, sizeof(int), compare_ints); /* Non-compliant */
+    return (item != NULL) ? *item : 0;
+}
+
+static void test_21_9_3(void* buffer, size_t n) {
+    qsort(buffer, n, 4, compare_ints); /* Non-compliant: the element type is unknown */
+}
+
+static const int sorted_21_9[3] = { 1, 2, 3 };
+
+static int test_21_9_4(void) {
+    int key = 2;
+    const char* raw = bsearch(&key, sorted_21_9, 3, sizeof(int), compare_ints); /* Non-compliant: the result is not an int pointer */
+    return (raw != NULL) ? 1 : 0;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: bad }
+];
+
+describe("Rule 21.9", () => {
+    registerSourceCode(files);
+
+    it("should detect errors", () => {
+        expect(countMISRAErrors("21.9")).toBe(5);
+    });
+
+    it("should replace the calls with known element types by specialized functions", () => {
+        expect(countErrorsAfterCorrection("21.9")).toBe(1);
+
+        const badFile = Query.search(FileJp, {name: "bad.c"}).first()!;
+        const functionNames = Query.searchFrom(badFile, FunctionJp).get().map(functionJp => functionJp.name);
+        expect(functionNames).toContain("misra_qsort_compare_ints");
+        expect(functionNames).toContain("misra_qsort_compare_samples");
+        expect(functionNames).toContain("misra_bsearch_compare_ints");
+        expect(Query.searchFrom(badFile, Call, {name: "qsort"}).get().length).toBe(1);
+        expect(Query.searchFrom(badFile, Call, {name: "bsearch"}).get().length).toBe(0);
+    });
+
+    it("should keep the type of the replaced bsearch calls", () => {
+        countMISRAErrors("21.9");
+        countErrorsAfterCorrection("21.9");
+
+        const searchFunctions = Query.search(FunctionJp, (functionJp: FunctionJp) => functionJp.name.startsWith("misra_bsearch")).get();
+        expect(searchFunctions.length).toBe(2);
+        expect(searchFunctions.every(functionJp => functionJp.returnType.code.replace(/\s/g, "") === "void*")).toBe(true);
+    });
+});
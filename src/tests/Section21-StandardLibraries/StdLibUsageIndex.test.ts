@@ -0,0 +1,86 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+import MISRATool from "../../MISRATool.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import path from "path";
+import { fileURLToPath } from "url";
+
+const failingCode = `
+#include <stdlib.h>
+#include "utils/time.h"
+
+static int test_linked_21(void) {
+    int *buffer = malloc(sizeof(int)); /* Violation of rule 21.3 */
+    int value = atoi("42"); /* Violation of rule 21.7 (the replacement does not compile) */
+    free(buffer); /* Violation of rule 21.3 */
+    return value + elapsed_ticks();
+}
+`;
+
+// User header with the name of a standard header
+const userTimeHeader = `
+int elapsed_ticks(void);
+`;
+
+const customStdLib = `
+#include <stddef.h>
+
+struct parsed_value {
+    int value;
+};
+
+void *my_malloc(size_t size) {
+    (void)size;
+    return NULL;
+}
+
+void my_free(void *ptr) {
+    (void)ptr;
+}
+
+struct parsed_value my_atoi(const char *str) {
+    struct parsed_value result = { 0 };
+    (void)str;
+    return result;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad_linked.c", code: failingCode },
+    { name: "time.h", code: userTimeHeader, path: "utils" },
+    { name: "custom_stdlib.c", code: customStdLib }
+];
+
+describe("Standard library usage index", () => {
+    const __filename = fileURLToPath(import.meta.url);
+    const __dirname = path.dirname(__filename);
+
+    const configFilename = "linked_misra_config.json";
+    const configFilePath = path.join(__dirname, configFilename);
+
+    registerSourceCode(files, configFilePath);
+
+    it("should detect the violations of the linked rules in the same file", () => {
+        expect(countMISRAErrors("21.3")).toBe(2);
+        expect(countMISRAErrors("21.7")).toBe(1);
+    });
+
+    it("should not take a user header as a standard header", () => {
+        expect(countMISRAErrors("21.10")).toBe(0);
+    });
+
+    it("should keep the replacements that compile when another one fails", () => {
+        countMISRAErrors();
+        expect(countErrorsAfterCorrection("21.7")).toBe(1);
+        expect(MISRATool.context.activeErrors.filter(error => error.ruleID === "21.3").length).toBe(0);
+
+        const errors = MISRATool.context.activeErrors.filter(error => error.ruleID === "21.7");
+        expect(errors[0].message).toContain("does not fix the violation");
+
+        const code = Query.search(FileJp, { name: "bad_linked.c" }).first()!.code;
+        expect(code).toContain("my_malloc(");
+        expect(code).toContain("my_free(");
+        expect(code).toContain("atoi(\"42\")");
+        expect(code).not.toContain("my_atoi");
+    });
+});
@@ -0,0 +1,67 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { FunctionJp, RecordJp, TypedefDecl } from "@specs-feup/clava/api/Joinpoints.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import path from "path";
+import { fileURLToPath } from "url";
+
+const failingCode = `
+typedef int Counter;
+
+struct Sample {
+    int value;
+};
+typedef struct Sample Sample_t;
+
+static int isr_count = 0;
+
+static int used_helper(void) {
+    return 1;
+}
+
+static int unused_helper(Counter count) { // Violation of rule 2.1
+    Sample_t sample;
+    sample.value = (int) count;
+    return sample.value;
+}
+
+static int unreachable_caller(void) { // Violation of rule 2.1
+    return unused_helper(1);
+}
+
+void timer_isr(void) {
+    isr_count++;
+}
+
+int main(void) {
+    return used_helper();
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode }
+];
+
+describe("Rule 2.1", () => {
+    const __filename = fileURLToPath(import.meta.url);
+    const __dirname = path.dirname(__filename);
+    const configFilePath = path.join(__dirname, "reachability_misra_config.json");
+
+    registerSourceCode(files, configFilePath);
+
+    it("should detect errors in bad.c", () => {
+        expect(countMISRAErrors("2.1")).toBe(2);
+    });
+
+    it("should correct errors in bad.c", () => {
+        expect(countErrorsAfterCorrection("2.1")).toBe(0);
+
+        const functionNames = Query.search(FunctionJp).get().map(functionJp => functionJp.name);
+        expect(functionNames).toEqual(expect.arrayContaining(["used_helper", "timer_isr", "main"]));
+        expect(functionNames).not.toContain("unused_helper");
+        expect(functionNames).not.toContain("unreachable_caller");
+
+        // Declarations only used by the removed functions are removed in the same pass
+        expect(Query.search(TypedefDecl).get().length).toBe(0);
+        expect(Query.search(RecordJp, {name: "Sample"}).get().length).toBe(0);
+    });
+});
@@ -284,16 +284,23 @@ describe("Rule 2.4", () => {
     registerSourceCode(files);
 
     it("should detect errors in bad.c", () => {
-        expect(countMISRAErrors()).toBe(7);
+        expect(countMISRAErrors()).toBe(8);
+        expect(countMISRAErrors("2.4")).toBe(7);
 
-        expect(countMISRAErrors(Query.search(FileJp, {name: "testEnum1.c"}).first()!)).toBe(1);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "testEnum1.c"}).first()!)).toBe(2);
         expect(countMISRAErrors(Query.search(FileJp, {name: "testEnum2.c"}).first()!)).toBe(1);
         expect(countMISRAErrors(Query.search(FileJp, {name: "testStruct1.c"}).first()!)).toBe(1);
         expect(countMISRAErrors(Query.search(FileJp, {name: "testStruct2.c"}).first()!)).toBe(1);
         expect(countMISRAErrors(Query.search(FileJp, {name: "testUnion1.c"}).first()!)).toBe(1);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "testEnum1.c"}).first()!, "2.4")).toBe(1);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "testEnum2.c"}).first()!, "2.4")).toBe(1);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "testStruct1.c"}).first()!, "2.4")).toBe(1);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "testStruct2.c"}).first()!, "2.4")).toBe(1);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "testUnion1.c"}).first()!, "2.4")).toBe(1);
     });
 
     it("should correct errors in bad.c", () => {
-        expect(countErrorsAfterCorrection()).toBe(0);
+        expect(countErrorsAfterCorrection()).toBe(1);
+        expect(countErrorsAfterCorrection("2.4")).toBe(0);
     });
 });
@@ -0,0 +1,50 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { Vardecl } from "@specs-feup/clava/api/Joinpoints.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import path from "path";
+import { fileURLToPath } from "url";
+
+const failingCode = `
+static int unused_object; // Violation of rule 2.8
+static int dead_only_object = 2; // Violation of rule 2.8
+static volatile int status_register;
+static int isr_count = 0;
+static int used_object = 1;
+
+static int dead_reader(void) {
+    return dead_only_object;
+}
+
+void timer_isr(void) {
+    isr_count++;
+}
+
+int main(void) {
+    return used_object;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode }
+];
+
+describe("Rule 2.8", () => {
+    const __filename = fileURLToPath(import.meta.url);
+    const __dirname = path.dirname(__filename);
+    const configFilePath = path.join(__dirname, "reachability_misra_config.json");
+
+    registerSourceCode(files, configFilePath);
+
+    it("should detect errors in bad.c", () => {
+        expect(countMISRAErrors("2.8")).toBe(2);
+    });
+
+    it("should correct errors in bad.c", () => {
+        expect(countErrorsAfterCorrection("2.8")).toBe(0);
+
+        const objectNames = Query.search(Vardecl).get().map(varJp => varJp.name);
+        expect(objectNames).toEqual(expect.arrayContaining(["status_register", "isr_count", "used_object"]));
+        expect(objectNames).not.toContain("unused_object");
+        expect(objectNames).not.toContain("dead_only_object");
+    });
+});
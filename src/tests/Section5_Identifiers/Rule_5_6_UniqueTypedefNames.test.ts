@@ -110,8 +110,9 @@ describe("Rule 5.6", () => {
     registerSourceCode(files);
 
     it("should detect errors in bad.c", () => {
-        expect(countMISRAErrors()).toBe(8);
+        expect(countMISRAErrors()).toBe(12);
         expect(countMISRAErrors("5.6")).toBe(6);
+        expect(countMISRAErrors("5.7")).toBe(2);
     });
 
     it("should correct errors in bad.c", () => {
@@ -0,0 +1,89 @@
+import { FileJp, FunctionJp, Program } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import MISRATool from "../../MISRATool.js";
+import Rule_5_9_UniqueInternalLinkIdentifiers from "../../rules/Section5_Identifiers/Rule_5_9_UniqueInternalLinkIdentifiers.js";
+import { countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import path from "path";
+import { fileURLToPath } from "url";
+
+const firstFile = `
+#include <stdint.h>
+
+static int32_t level_5_9;
+
+static int32_t get_level_5_9(void) {
+    return level_5_9;
+}
+
+int32_t first_5_9(void) {
+    return get_level_5_9();
+}
+`;
+
+const secondFile = `
+#include <stdint.h>
+
+static int32_t level_5_9; // Violation of rule 5.9
+
+static int32_t get_level_5_9(void) { // Violation of rule 5.9
+    return level_5_9;
+}
+
+int32_t second_5_9(void) {
+    return get_level_5_9() + level_5_9;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "first.c", code: firstFile },
+    { name: "second.c", code: secondFile }
+];
+
+describe("Rule 5.9 renames", () => {
+    const __filename = fileURLToPath(import.meta.url);
+    const __dirname = path.dirname(__filename);
+
+    registerSourceCode(files, path.join(__dirname, "rename_misra_config.json"));
+
+    function getFunction(fileName: string, functionName: string): FunctionJp {
+        const fileJp = Query.search(FileJp, {name: fileName}).first()!;
+        return Query.searchFrom(fileJp, FunctionJp, {name: functionName}).first()!;
+    }
+
+    function renameGlobals(): void {
+        const context = MISRATool.context;
+        const report = new Rule_5_9_UniqueInternalLinkIdentifiers(context).apply(Query.root() as Program);
+        report.changedNodes!.forEach(nodeJp => context.notifyNodeChange(nodeJp));
+    }
+
+    it("should change the functions that reference the renamed globals", () => {
+        expect(countMISRAErrors("5.9")).toBe(2);
+
+        const context = MISRATool.context;
+        const userJp = getFunction("second.c", "second_5_9");
+        const getterJp = getFunction("second.c", "get_level_5_9");
+        const unrelatedJp = getFunction("first.c", "first_5_9");
+        const userEpoch = context.getFunctionEpoch(userJp.astId);
+        const getterEpoch = context.getFunctionEpoch(getterJp.astId);
+        const unrelatedEpoch = context.getFunctionEpoch(unrelatedJp.astId);
+
+        renameGlobals();
+
+        expect(context.getFunctionEpoch(userJp.astId)).not.toBe(userEpoch);
+        expect(context.getFunctionEpoch(getterJp.astId)).not.toBe(getterEpoch);
+        expect(context.getFunctionEpoch(unrelatedJp.astId)).toBe(unrelatedEpoch);
+    });
+
+    it("should resolve renamed functions by their new names", () => {
+        countMISRAErrors("5.9");
+
+        const config = MISRATool.context.config!;
+        const getterJp = getFunction("second.c", "get_level_5_9");
+        expect(config.findFunctionDef("get_level_5_9", "second.c")?.astId).toBe(getterJp.astId);
+
+        renameGlobals();
+
+        expect(config.findFunctionDef("get_level_5_9", "second.c")).toBeUndefined();
+        expect(config.findFunctionDef(getterJp.name, "second.c")?.astId).toBe(getterJp.astId);
+    });
+});
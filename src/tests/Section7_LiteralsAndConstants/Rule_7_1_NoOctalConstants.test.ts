@@ -0,0 +1,58 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+
+const passingCode = `
+static int test_7_1_1(void) {
+    int a = 0;
+    int b = 10;
+    int c = 0x10;
+    char *s = "010"; /* 010 in a comment */
+    return a + b + c;
+}
+`;
+
+const failingCode = `
+static int test_7_1_2(void) {
+    int a = 010;             // Violation of rule 7.1
+    unsigned int b = 0777u;  // Violation of rule 7.1
+    long c = 037777777777;   // Violation of rule 7.1
+    unsigned int d = 0100000; // Violation of rule 7.1 (unsigned int on 16-bit targets, like 0x8000)
+    return a + (int) b + (int) d;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode },
+    { name: "good.c", code: passingCode }
+];
+
+describe("Rule 7.1", () => {
+    registerSourceCode(files);
+
+    it("should detect errors in bad.c", () => {
+        expect(countMISRAErrors()).toBe(5);
+        expect(countMISRAErrors("7.1")).toBe(4);
+
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!)).toBe(5);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!)).toBe(0);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!, "7.1")).toBe(4);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!, "7.1")).toBe(0);
+    });
+
+    it("should correct errors in bad.c", () => {
+        expect(countErrorsAfterCorrection()).toBe(1);
+        expect(countErrorsAfterCorrection("7.1")).toBe(0);
+    });
+
+    it("should replace octal constants by hexadecimal constants", () => {
+        countMISRAErrors("7.1");
+        countErrorsAfterCorrection("7.1");
+
+        const code = Query.search(FileJp, {name: "bad.c"}).first()!.code;
+        expect(code).toContain("0x8");
+        expect(code).toContain("0x1FFu");
+        expect(code).toContain("0xFFFFFFFF");
+        expect(code).toContain("0x8000");
+    });
+});
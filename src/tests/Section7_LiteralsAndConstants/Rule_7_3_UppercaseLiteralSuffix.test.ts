@@ -0,0 +1,43 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { countErrorsAfterCorrection, countMISRAErrors, registerSourceCode, TestFile } from "../utils.js";
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+
+const passingCode = `
+static long test_7_3_1(void) {
+    long a = 10L;
+    unsigned long b = 10UL;
+    float c = 1.0f;
+    long d = 0xff;
+    return a + (long) b + (long) c + d;
+}
+`;
+
+const failingCode = `
+static long test_7_3_2(void) {
+    long a = 10l;              // Violation of rule 7.3
+    unsigned long b = 10ul;    // Violation of rule 7.3
+    long double c = 1.0l;      // Violation of rule 7.3
+    long d = 0x1fl;            // Violation of rule 7.3
+    return a + (long) b + (long) c + d;
+}
+`;
+
+const files: TestFile[] = [
+    { name: "bad.c", code: failingCode },
+    { name: "good.c", code: passingCode }
+];
+
+describe("Rule 7.3", () => {
+    registerSourceCode(files);
+
+    it("should detect errors in bad.c", () => {
+        expect(countMISRAErrors()).toBe(4);
+
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!)).toBe(4);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!)).toBe(0);
+    });
+
+    it("should correct errors in bad.c", () => {
+        expect(countErrorsAfterCorrection()).toBe(0);
+    });
+});
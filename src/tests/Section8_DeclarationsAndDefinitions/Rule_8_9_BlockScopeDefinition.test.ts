@@ -56,14 +56,19 @@ describe("Rule 8.9", () => {
     registerSourceCode(files);
 
     it("should detect errors in bad.c", () => {
-        expect(countMISRAErrors()).toBe(1);
+        expect(countMISRAErrors()).toBe(2);
+        expect(countMISRAErrors("8.9")).toBe(1);
 
-        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!)).toBe(1);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!)).toBe(2);
         expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!)).toBe(0);
         expect(countMISRAErrors(Query.search(FileJp, {name: "misraExample.c"}).first()!)).toBe(0);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "bad.c"}).first()!, "8.9")).toBe(1);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "good.c"}).first()!, "8.9")).toBe(0);
+        expect(countMISRAErrors(Query.search(FileJp, {name: "misraExample.c"}).first()!, "8.9")).toBe(0);
     });
 
     it("should correct errors in bad.c", () => {
-        expect(countErrorsAfterCorrection()).toBe(0);
+        expect(countErrorsAfterCorrection()).toBe(1);
+        expect(countErrorsAfterCorrection("8.9")).toBe(0);
     });
 });
@@ -0,0 +1,98 @@
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import Clava from "@specs-feup/clava/api/clava/Clava.js";
+import ClavaJoinPoints from "@specs-feup/clava/api/clava/ClavaJoinPoints.js";
+import { FileJp } from "@specs-feup/clava/api/Joinpoints.js";
+import * as fs from "fs";
+import * as os from "os";
+import path from "path";
+import {
+    getCachedExplicitCall, getCachedVerdict, getValidationKey, invalidateValidationContext, loadValidationCache,
+    resetValidationCache, saveValidationCache, setCachedExplicitCall, setCachedVerdict
+} from "../utils/ValidationCache.js";
+import { registerSourceCode, TestFile } from "./utils.js";
+
+const headerCode = `
+int limit_value(void);
+`;
+
+const sourceCode = `
+#include "limits_config.h"
+
+int check(int value) {
+    return value < limit_value();
+}
+`;
+
+const files: TestFile[] = [
+    { name: "limits_config.h", code: headerCode },
+    { name: "check.c", code: sourceCode }
+];
+
+describe("Validation cache", () => {
+    registerSourceCode(files);
+
+    beforeEach(() => {
+        resetValidationCache();
+        invalidateValidationContext();
+    });
+
+    const getSource = () => Query.search(FileJp, { name: "check.c" }).first()!;
+    const getHeader = () => Query.search(FileJp, { name: "limits_config.h" }).first()!;
+
+    it("should reuse the results of the same content", () => {
+        const key = getValidationKey(getSource());
+        setCachedVerdict(key, true);
+
+        expect(getValidationKey(getSource())).toBe(key);
+        expect(getCachedVerdict(getValidationKey(getSource()))).toBe(true);
+        expect(getCachedVerdict(getValidationKey(getSource(), getSource().code + "\nint extra;"))).toBeUndefined();
+    });
+
+    it("should miss the cache after a header changes", () => {
+        const key = getValidationKey(getSource());
+        setCachedVerdict(key, true);
+
+        const headerJp = getHeader();
+        headerJp.lastChild.insertAfter(ClavaJoinPoints.stmtLiteral("int other_limit_value(void);"));
+        invalidateValidationContext(headerJp);
+
+        const newKey = getValidationKey(getSource());
+        expect(newKey).not.toBe(key);
+        expect(getCachedVerdict(newKey)).toBeUndefined();
+    });
+
+    it("should miss the cache after the flags change", () => {
+        const key = getValidationKey(getSource());
+        setCachedVerdict(key, true);
+
+        const data = Clava.getData();
+        const flags = data.getFlags();
+        try {
+            data.setFlags(`${flags} -DLIMIT_CHECK`);
+            const newKey = getValidationKey(getSource());
+            expect(newKey).not.toBe(key);
+            expect(getCachedVerdict(newKey)).toBeUndefined();
+        } finally {
+            data.setFlags(flags);
+        }
+        expect(getValidationKey(getSource())).toBe(key);
+    });
+
+    it("should store the results in a file and load them again", () => {
+        const cachePath = path.join(fs.mkdtempSync(path.join(os.tmpdir(), "misra-cache-")), "validation_cache.json");
+        const key = getValidationKey(getSource());
+        setCachedVerdict(key, true);
+        setCachedExplicitCall(key, "limit_value", 0, false, true);
+        saveValidationCache(cachePath);
+
+        resetValidationCache();
+        expect(getCachedVerdict(key)).toBeUndefined();
+
+        loadValidationCache(cachePath);
+        expect(getCachedVerdict(key)).toBe(true);
+        expect(getCachedExplicitCall(key, "limit_value", 0, false)).toBe(true);
+        expect(getCachedExplicitCall(key, "limit_value", 0, true)).toBeUndefined();
+
+        fs.rmSync(path.dirname(cachePath), { recursive: true, force: true });
+    });
+});
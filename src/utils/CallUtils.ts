@@ -1,37 +1,145 @@
-import { Call, FileJp, FunctionJp, Varref } from "@specs-feup/clava/api/Joinpoints.js";
+import { Call, ExprStmt, FileJp, FunctionJp, Varref } from "@specs-feup/clava/api/Joinpoints.js";
 import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { getTypeCategory, isCompatibleType, TypeCategory } from "./TypeUtils.js";
 
 /**
- * Checks if the given joinpoint represents a call to an implicit function.
+ * Calls of a file, indexed in a single pass to resolve which of them are calls to implicit functions.
  *
- * @param callJp The call join point to analyze
+ * The index records the names of the functions declared or defined in the file, the ordinal of each call
+ * among the calls with the same name, and whether each call goes through a function pointer.
+ * The names declared in other files are only collected when a call resolves to a function declared there.
  */
-export function isCallToImplicitFunction(callJp: Call): boolean {
-    if ( callJp.function?.isInSystemHeader) { // Call to system header function
-        return false;
-    } 
+export class ImplicitCallResolver {
+    /**
+     * The indexed file
+     */
+    readonly fileJp: FileJp;
 
-    const varrefs = Query.searchFrom(callJp, Varref, {isFunctionCall: false}).get().map(varRef => varRef.astId);
-    const args = new Set(callJp.argList.flatMap(arg => Query.searchFromInclusive(arg, Varref).get().map(varRef => varRef.astId)));
-    if (varrefs.length > 0 && !args.has(varrefs[0])) { // Call using function pointer
-        return false;
+    /**
+     * Calls of the file, in order of occurrence
+     */
+    readonly calls: Call[];
+
+    #callsByName = new Map<string, Call[]>();
+    #ordinals = new Map<string, number>();
+    #pointerCalls = new Set<string>();
+    #declaredFunctions = new Map<string, Set<string>>();
+    #implicitCalls: Call[] | undefined = undefined;
+
+    /**
+     * @param fileJp The file to index
+     */
+    constructor(fileJp: FileJp) {
+        this.fileJp = fileJp;
+        this.calls = Query.searchFrom(fileJp, Call).get();
+
+        for (const callJp of this.calls) {
+            const sameNameCalls = this.#callsByName.get(callJp.name) ?? [];
+            this.#ordinals.set(callJp.astId, sameNameCalls.length);
+            sameNameCalls.push(callJp);
+            this.#callsByName.set(callJp.name, sameNameCalls);
+
+            if (isFunctionPointerCall(callJp)) {
+                this.#pointerCalls.add(callJp.astId);
+            }
+        }
+    }
+
+    /**
+     * @returns The calls of the file to implicit functions, in order of occurrence
+     */
+    get implicitCalls(): Call[] {
+        if (this.#implicitCalls === undefined) {
+            this.#implicitCalls = this.calls.filter(callJp => this.isImplicitCall(callJp));
+        }
+        return this.#implicitCalls;
     }
-    
-    const directCallee = callJp.directCallee;
-    if (directCallee === undefined) return true;
-    
-    const fileJp = directCallee.getAncestor("file");
-    if (fileJp === undefined) return true;
 
-    return Query.searchFrom(fileJp, FunctionJp, {name: callJp.name}).get().length === 0;
+    /**
+     * Checks if the given call of the file is a call to an implicit function
+     *
+     * @param callJp A call of the file
+     */
+    isImplicitCall(callJp: Call): boolean {
+        if (callJp.function?.isInSystemHeader) { // Call to system header function
+            return false;
+        }
+        if (this.#pointerCalls.has(callJp.astId)) {
+            return false;
+        }
+
+        const directCallee = callJp.directCallee;
+        if (directCallee === undefined) return true;
+
+        const calleeFileJp = directCallee.getAncestor("file") as FileJp | undefined;
+        if (calleeFileJp === undefined) return true;
+
+        return !this.getDeclaredFunctions(calleeFileJp).has(callJp.name);
+    }
+
+    /**
+     * Returns the index of a call of the file among the calls with the same name
+     *
+     * @param callJp A call of the file
+     * @returns The index of the call or -1 if not found
+     */
+    getOrdinal(callJp: Call): number {
+        return this.#ordinals.get(callJp.astId) ?? -1;
+    }
+
+    /**
+     * Returns the call with the given name and index among the calls with the same name
+     *
+     * @param name The name of the called function
+     * @param ordinal The index of the call
+     */
+    getCall(name: string, ordinal: number): Call | undefined {
+        return this.#callsByName.get(name)?.at(ordinal);
+    }
+
+    private getDeclaredFunctions(fileJp: FileJp): Set<string> {
+        let names = this.#declaredFunctions.get(fileJp.astId);
+        if (names === undefined) {
+            names = new Set(Query.searchFrom(fileJp, FunctionJp).get().map(functionJp => functionJp.name));
+            this.#declaredFunctions.set(fileJp.astId, names);
+        }
+        return names;
+    }
+}
+
+/**
+ * Checks if the callee of the given call is a function pointer, i.e., the first variable referenced in the call is not part of an argument
+ */
+function isFunctionPointerCall(callJp: Call): boolean {
+    const varref = Query.searchFrom(callJp, Varref, {isFunctionCall: false}).first();
+    if (varref === undefined) {
+        return false;
+    }
+    return !callJp.argList.some(argJp => argJp.astId === varref.astId || argJp.contains(varref));
 }
 
 /**
- * Computes the index of a call in a file
- * @param fileJp The file to search in
- * @param callJp The call to find
- * @returns The index of the call or -1 if not found 
+ * Checks if the given function can replace the callee of a call, by comparing the number and types of the arguments 
+ * with the parameters of the function, and whether the value returned by the call is still available.
+ * Only the joinpoints already in memory are used, so this check is meant to discard obviously incompatible fixes before compiling.
+ * 
+ * @param callJp The call to redirect
+ * @param functionJp The candidate callee
+ * @returns Returns false if the function is certainly incompatible with the call, otherwise returns true
  */
-export function getCallIndex(fileJp: FileJp, callJp: Call): number {
-    return Query.searchFrom(fileJp, Call, { name: callJp.name }).get().findIndex(c => c.equals(callJp));
-}
\ No newline at end of file
+export function isCompatibleCallee(callJp: Call, functionJp: FunctionJp): boolean {
+    const params = functionJp.params.filter(paramJp => getTypeCategory(paramJp.type) !== TypeCategory.VOID);
+    const args = callJp.args;
+    const isVariadic = functionJp.functionType.isVariadic;
+
+    if (args.length < params.length || (!isVariadic && args.length > params.length)) {
+        return false;
+    }
+    if (params.some((paramJp, i) => !isCompatibleType(args[i].type, paramJp.type))) {
+        return false;
+    }
+
+    // The returned value must remain available if the call is used as an expression
+    const isValueUsed = !(callJp.parent instanceof ExprStmt) && getTypeCategory(callJp.type) !== TypeCategory.VOID;
+    return !(isValueUsed && getTypeCategory(functionJp.returnType) === TypeCategory.VOID);
+}
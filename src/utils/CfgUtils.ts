@@ -0,0 +1,164 @@
+import { Body, Break, FunctionJp, GotoStmt, Joinpoint, LabelStmt, Loop, ReturnStmt, Switch } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import ClavaNode from "@specs-feup/clava-flow/ClavaNode";
+import ReturnNode from "@specs-feup/clava-flow/cfg/node/ReturnNode";
+import ClavaCfgGenerator from "@specs-feup/clava-flow/transformation/ClavaCfgGenerator";
+import BaseNode from "@specs-feup/flow/graph/BaseNode";
+import Graph from "@specs-feup/flow/graph/Graph";
+import ControlFlowEdge from "@specs-feup/flow/flow/ControlFlowEdge";
+import { isCommentStmt } from "./CommentUtils.js";
+
+/**
+ * Checks, without building the control flow graph, if the last statement of the body of the function is a return statement,
+ * in which case control cannot reach the end of the function.
+ * A return statement elsewhere at the top level is not enough, since a goto statement may jump past it.
+ *
+ * @param functionJp The function to analyze
+ */
+export function hasFinalReturn(functionJp: FunctionJp): boolean {
+    const statements = functionJp.body.children.filter(childJp => !isCommentStmt(childJp));
+    return statements[statements.length - 1] instanceof ReturnStmt;
+}
+
+/**
+ * Control flow information of a function, shared by the rules that analyze it.
+ *
+ * The control flow graph is only built when a query requires it, and structural queries (labels and loop exits)
+ * are answered from the AST. Results are computed once and kept until the function changes.
+ */
+export class FunctionCfg {
+    /**
+     * The analyzed function
+     */
+    readonly functionJp: FunctionJp;
+
+    #graph: { startNode: BaseNode.Class } | undefined = undefined;
+    #allExitPathsReturn: boolean | undefined = undefined;
+    #reachableStatements: Set<string> | undefined = undefined;
+    #labels: Map<string, LabelStmt> | undefined = undefined;
+    #loopExits = new Map<string, (Break | GotoStmt)[]>();
+
+    /**
+     * @param functionJp The function to analyze
+     */
+    constructor(functionJp: FunctionJp) {
+        this.functionJp = functionJp;
+    }
+
+    /**
+     * Builds the control flow graph of the function, without the fake edges, and returns its start node (the function body)
+     */
+    private get startNode(): BaseNode.Class {
+        if (this.#graph === undefined) {
+            const cfg = Graph.create().apply(new ClavaCfgGenerator(this.functionJp));
+            cfg.edges.filter(edge => edge.is(ControlFlowEdge) && edge.as(ControlFlowEdge).isFake).forEach((edge) => {
+                edge.remove();
+            });
+            this.#graph = { startNode: cfg.nodes.filterIs(ClavaNode).filter(node => node.jp instanceof Body)[0] };
+        }
+        return this.#graph.startNode;
+    }
+
+    /**
+     * Checks if all exit paths of the function have an explicit return statement.
+     * Functions whose body ends with a return statement are accepted without building the graph.
+     * Otherwise, a depth-first search on the control flow graph looks for a path that reaches the end without a return statement.
+     */
+    get allExitPathsReturn(): boolean {
+        if (this.#allExitPathsReturn === undefined) {
+            this.#allExitPathsReturn = hasFinalReturn(this.functionJp) || this.searchExitPathsReturn();
+        }
+        return this.#allExitPathsReturn;
+    }
+
+    private searchExitPathsReturn(): boolean {
+        const stack = [this.startNode];
+        const visited = new Set();
+
+        while (stack.length > 0) {
+            const node = stack.pop()!;
+
+            if (visited.has(node) || node?.is(ReturnNode))
+                continue;
+
+            visited.add(node);
+            let children = Array.from(node.outgoers).map(edge => edge.target);
+            if (!children || children.length === 0)
+                return false; // Reached the end of the graph without finding a single return statement
+
+            children = children.filter(child => !visited.has(child));
+            children.forEach(child => stack.push(child.as(BaseNode)));
+        }
+        return true;
+    }
+
+    /**
+     * Checks if the given statement can be reached from the start of the function
+     *
+     * @param stmtJp A statement of the function
+     */
+    isReachable(stmtJp: Joinpoint): boolean {
+        if (this.#reachableStatements === undefined) {
+            this.#reachableStatements = new Set<string>();
+            const stack = [this.startNode];
+            const visited = new Set();
+
+            while (stack.length > 0) {
+                const node = stack.pop()!;
+                if (visited.has(node))
+                    continue;
+
+                visited.add(node);
+                if (node.is(ClavaNode)) {
+                    this.#reachableStatements.add(node.as(ClavaNode).jp.astId);
+                }
+                Array.from(node.outgoers).forEach(edge => stack.push(edge.target.as(BaseNode)));
+            }
+        }
+        return this.#reachableStatements.has(stmtJp.astId);
+    }
+
+    /**
+     * Returns the label statement targeted by the given goto statement of the function
+     *
+     * @param gotoJp A goto statement of the function
+     */
+    getLabel(gotoJp: GotoStmt): LabelStmt | undefined {
+        if (this.#labels === undefined) {
+            this.#labels = new Map(Query.searchFrom(this.functionJp, LabelStmt).get().map(labelJp => [labelJp.decl.astId, labelJp]));
+        }
+        return this.#labels.get(gotoJp.label.astId);
+    }
+
+    /**
+     * Returns the statements used to terminate the given loop: break statements that belong to it and goto statements that jump outside it
+     *
+     * @param loopJp A loop of the function
+     */
+    getLoopExits(loopJp: Loop): (Break | GotoStmt)[] {
+        let exits = this.#loopExits.get(loopJp.astId);
+        if (exits === undefined) {
+            const breaks = Query.searchFrom(loopJp, Break).get().filter(breakJp => getBreakTarget(breakJp)?.astId === loopJp.astId);
+            const gotos = Query.searchFrom(loopJp, GotoStmt).get().filter(gotoJp => {
+                const labelJp = this.getLabel(gotoJp);
+                return labelJp !== undefined && !loopJp.contains(labelJp);
+            });
+            exits = [...breaks, ...gotos];
+            this.#loopExits.set(loopJp.astId, exits);
+        }
+        return exits;
+    }
+}
+
+/**
+ * Returns the statement terminated by the given break statement, i.e., the innermost enclosing loop or switch
+ *
+ * @param breakJp The break statement
+ */
+export function getBreakTarget(breakJp: Break): Loop | Switch | undefined {
+    let currentJp = breakJp.parent;
+    while (currentJp !== undefined && !(currentJp instanceof Loop || currentJp instanceof Switch || currentJp instanceof FunctionJp)) {
+        currentJp = currentJp.parent;
+    }
+    return currentJp instanceof Loop || currentJp instanceof Switch ? currentJp : undefined;
+}
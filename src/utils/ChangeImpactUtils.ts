@@ -0,0 +1,110 @@
+import { Call, FileJp, Joinpoint, NamedDecl, Program, Varref } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { execFileSync } from "child_process";
+import * as fs from 'fs';
+import path from "path";
+import { getReferencedTypeDecls } from "./TypeDeclUtils.js";
+
+/**
+ * Part of the program whose analysis results may change with a set of changed files
+ */
+export interface ChangeImpact {
+    /**
+     * Changed files and the files that include them, directly or through other headers.
+     * All rules are applied to their nodes.
+     */
+    files: FileJp[];
+    /**
+     * Declarations of other files that share a name with an identifier or type declared or used by the impacted files.
+     * Only system rules are applied to them.
+     */
+    sharedDecls: Joinpoint[];
+}
+
+/**
+ * Returns the absolute paths of the changed files, given either a file that lists them (one per line)
+ * or a git revision, in which case the files changed since the merge base of the revision and HEAD are returned,
+ * including uncommitted and untracked files.
+ *
+ * @param changeSpec Path of the list of changed files, or a git revision
+ * @param folder Folder inside the git repository, against which listed relative paths are also resolved
+ * @returns The paths of the changed files
+ */
+export function getChangedPaths(changeSpec: string, folder: string): Set<string> {
+    if (fs.existsSync(changeSpec) && fs.statSync(changeSpec).isFile()) {
+        return new Set(fs.readFileSync(changeSpec, 'utf-8')
+            .split(/\r?\n/)
+            .map(line => line.trim())
+            .filter(line => line.length > 0)
+            .map(line => path.resolve(folder, line)));
+    }
+
+    const git = (...args: string[]) => execFileSync("git", ["-C", folder, ...args], { encoding: "utf-8" }).split("\n").filter(line => line.length > 0);
+    const topLevel = git("rev-parse", "--show-toplevel")[0];
+    const mergeBase = git("merge-base", changeSpec, "HEAD")[0];
+    const changedFiles = [
+        ...git("diff", "--name-only", mergeBase),
+        ...git("ls-files", "--others", "--exclude-standard", "--full-name")
+    ];
+    return new Set(changedFiles.map(file => path.resolve(topLevel, file)));
+}
+
+/**
+ * Computes the files impacted by the given changed files and the declarations of other files that share their names
+ *
+ * @param changedPaths Absolute paths of the changed files
+ * @param programJp The program
+ * @returns The impacted part of the program
+ */
+export function getChangeImpact(changedPaths: Set<string>, programJp: Program = Query.root() as Program): ChangeImpact {
+    const allFiles = Query.searchFrom(programJp, FileJp).get();
+    const impacted = new Map<string, FileJp>();
+    const pending = allFiles.filter(fileJp => changedPaths.has(path.resolve(fileJp.filepath)));
+
+    // Changed files and the files that include a changed or impacted header, matched by the path of the header
+    // instead of its name, so that headers with the same name in other folders do not impact their includers
+    while (pending.length > 0) {
+        const fileJp = pending.pop()!;
+        if (impacted.has(fileJp.astId)) {
+            continue;
+        }
+        impacted.set(fileJp.astId, fileJp);
+        if (fileJp.isHeader) {
+            const headerPath = path.resolve(fileJp.filepath);
+            pending.push(...allFiles.filter(includerJp => includesHeader(includerJp, headerPath)));
+        }
+    }
+
+    // Names declared or used by the impacted files
+    const touchedNames = new Set<string>();
+    for (const fileJp of impacted.values()) {
+        for (const jp of fileJp.descendants) {
+            if ((jp instanceof NamedDecl && jp.getAncestor("function") === undefined) || jp instanceof Call || jp instanceof Varref) {
+                touchedNames.add((jp as NamedDecl | Call | Varref).name);
+            }
+            getReferencedTypeDecls(jp).forEach(declJp => touchedNames.add(declJp.name));
+        }
+    }
+
+    const sharedDecls = allFiles
+        .filter(fileJp => !impacted.has(fileJp.astId))
+        .flatMap(fileJp => Query.searchFrom(fileJp, NamedDecl, (declJp: NamedDecl) =>
+            declJp.getAncestor("function") === undefined && touchedNames.has(declJp.name)
+        ).get());
+
+    return { files: Array.from(impacted.values()), sharedDecls };
+}
+
+/**
+ * Checks if a file includes the header with the given path: an include names the header if it resolves to the header
+ * from the folder of the file, or if it is a trailing part of the path of the header (e.g., a header found in an include folder)
+ *
+ * @param fileJp The including file
+ * @param headerPath Absolute path of the header
+ */
+function includesHeader(fileJp: FileJp, headerPath: string): boolean {
+    return fileJp.includes.some(includeJp => {
+        const includePath = path.normalize(includeJp.name);
+        return path.resolve(path.dirname(fileJp.filepath), includePath) === headerPath || headerPath.endsWith(path.sep + includePath);
+    });
+}
@@ -0,0 +1,150 @@
+/**
+ * Line of a diff, kept (" "), removed ("-") or added ("+")
+ */
+interface DiffLine {
+    type: " " | "-" | "+";
+    /**
+     * Text of the line, including its line terminator, if any
+     */
+    text: string;
+}
+
+/**
+ * Number of unchanged lines shown around each change
+ */
+const CONTEXT_LINES = 3;
+
+/**
+ * Maximum number of edits searched before replacing the whole changed region, which bounds the memory of the search
+ */
+const MAX_EDIT_DISTANCE = 4000;
+
+/**
+ * Creates a unified diff between two versions of a file
+ *
+ * @param oldPath Path of the file before the changes, or undefined if the file is new
+ * @param newPath Path of the file after the changes
+ * @param oldText Content of the file before the changes
+ * @param newText Content of the file after the changes
+ * @returns The diff, or an empty string if the contents are equal
+ */
+export function createUnifiedDiff(oldPath: string | undefined, newPath: string, oldText: string, newText: string): string {
+    const lines = diffLines(splitLines(oldText), splitLines(newText));
+    const changes = lines.flatMap((line, index) => line.type !== " " ? [index] : []);
+    if (changes.length === 0) {
+        return "";
+    }
+
+    // Number of old and new lines before each diff line
+    const oldBefore = [0], newBefore = [0];
+    lines.forEach((line, index) => {
+        oldBefore.push(oldBefore[index] + (line.type !== "+" ? 1 : 0));
+        newBefore.push(newBefore[index] + (line.type !== "-" ? 1 : 0));
+    });
+
+    const output = [`--- ${oldPath !== undefined ? `a/${oldPath}` : "/dev/null"}\n`, `+++ b/${newPath}\n`];
+    for (let i = 0; i < changes.length;) {
+        const start = Math.max(0, changes[i] - CONTEXT_LINES);
+        let end = Math.min(lines.length, changes[i] + CONTEXT_LINES + 1);
+        let j = i + 1;
+        for (; j < changes.length && changes[j] - CONTEXT_LINES <= end; j++) {
+            end = Math.min(lines.length, changes[j] + CONTEXT_LINES + 1);
+        }
+
+        const oldCount = oldBefore[end] - oldBefore[start], newCount = newBefore[end] - newBefore[start];
+        const oldStart = oldCount > 0 ? oldBefore[start] + 1 : oldBefore[start];
+        const newStart = newCount > 0 ? newBefore[start] + 1 : newBefore[start];
+        output.push(`@@ -${oldStart},${oldCount} +${newStart},${newCount} @@\n`);
+        for (const line of lines.slice(start, end)) {
+            output.push(line.text.endsWith("\n") ? `${line.type}${line.text}` : `${line.type}${line.text}\n\\ No newline at end of file\n`);
+        }
+        i = j;
+    }
+    return output.join("");
+}
+
+/**
+ * Splits a text into lines, keeping their terminators so that a missing newline at the end of the file is a difference
+ */
+function splitLines(text: string): string[] {
+    return text.match(/[^\n]*\n|[^\n]+$/g) ?? [];
+}
+
+/**
+ * Computes the lines kept, removed and added between two lists of lines.
+ * The common prefix and suffix are skipped before searching the shortest edit script of the remaining lines.
+ */
+function diffLines(oldLines: string[], newLines: string[]): DiffLine[] {
+    let prefix = 0;
+    while (prefix < oldLines.length && prefix < newLines.length && oldLines[prefix] === newLines[prefix]) {
+        prefix++;
+    }
+    let oldEnd = oldLines.length, newEnd = newLines.length;
+    while (oldEnd > prefix && newEnd > prefix && oldLines[oldEnd - 1] === newLines[newEnd - 1]) {
+        oldEnd--;
+        newEnd--;
+    }
+
+    const keep = (text: string): DiffLine => ({ type: " ", text });
+    return [
+        ...oldLines.slice(0, prefix).map(keep),
+        ...shortestEditScript(oldLines.slice(prefix, oldEnd), newLines.slice(prefix, newEnd)),
+        ...oldLines.slice(oldEnd).map(keep)
+    ];
+}
+
+/**
+ * Finds the shortest edit script between two lists of lines (Myers' algorithm).
+ * Only the diagonals reachable at each step are recorded, so that memory grows with the square of the number of edits.
+ */
+function shortestEditScript(a: string[], b: string[]): DiffLine[] {
+    const n = a.length, m = b.length;
+    const maxDistance = Math.min(n + m, MAX_EDIT_DISTANCE);
+    const offset = maxDistance + 1;
+    const v = new Int32Array(2 * offset + 1);
+    const trace: Int32Array[] = [];
+
+    for (let d = 0; d <= maxDistance; d++) {
+        trace.push(v.slice(offset - d - 1, offset + d + 2));
+        for (let k = -d; k <= d; k += 2) {
+            let x = k === -d || (k !== d && v[offset + k - 1] < v[offset + k + 1]) ? v[offset + k + 1] : v[offset + k - 1] + 1;
+            let y = x - k;
+            while (x < n && y < m && a[x] === b[y]) {
+                x++;
+                y++;
+            }
+            v[offset + k] = x;
+            if (x >= n && y >= m) {
+                return backtrack(trace, a, b);
+            }
+        }
+    }
+
+    // Too many edits: replace the whole region
+    return [...a.map((text): DiffLine => ({ type: "-", text })), ...b.map((text): DiffLine => ({ type: "+", text }))];
+}
+
+function backtrack(trace: Int32Array[], a: string[], b: string[]): DiffLine[] {
+    const lines: DiffLine[] = [];
+    let x = a.length, y = b.length;
+
+    for (let d = trace.length - 1; d >= 0; d--) {
+        // The snapshot of step d holds the diagonals -d-1 to d+1
+        const v = (k: number) => trace[d][k + d + 1];
+        const k = x - y;
+        const prevK = k === -d || (k !== d && v(k - 1) < v(k + 1)) ? k + 1 : k - 1;
+        const prevX = v(prevK), prevY = prevX - prevK;
+
+        while (x > prevX && y > prevY) {
+            lines.push({ type: " ", text: a[x - 1] });
+            x--;
+            y--;
+        }
+        if (d > 0) {
+            lines.push(x === prevX ? { type: "+", text: b[y - 1] } : { type: "-", text: a[x - 1] });
+        }
+        x = prevX;
+        y = prevY;
+    }
+    return lines.reverse();
+}
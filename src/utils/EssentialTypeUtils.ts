@@ -0,0 +1,446 @@
+import { BinaryOp, BoolLiteral, BuiltinType, Call, Cast, EnumDecl, EnumeratorDecl, EnumType, Expression, FloatLiteral, FunctionJp, IntLiteral, Joinpoint, Literal, ParenExpr, QualType, ReturnStmt, TernaryOp, Type, UnaryExprOrType, UnaryOp, Vardecl, VariableArrayType, Varref } from "@specs-feup/clava/api/Joinpoints.js";
+import ClavaJoinPoints from "@specs-feup/clava/api/clava/ClavaJoinPoints.js";
+
+/**
+ * Essential type categories of the MISRA-C essential type model
+ */
+export enum EssentialTypeCategory {
+    BOOLEAN = "Boolean",
+    CHARACTER = "character",
+    SIGNED = "signed",
+    UNSIGNED = "unsigned",
+    ENUM = "enum",
+    FLOATING = "floating",
+    UNKNOWN = "unknown"
+}
+
+/**
+ * Essential type of an expression: its category and width
+ */
+export interface EssentialType {
+    /**
+     * Essential type category
+     */
+    category: EssentialTypeCategory;
+    /**
+     * Width in bits, or 0 if unknown
+     */
+    width: number;
+    /**
+     * Name of the enumeration, if the category is {@link EssentialTypeCategory.ENUM}
+     */
+    enumName?: string;
+}
+
+/**
+ * Inferred information of an expression
+ */
+interface ExpressionInfo {
+    type: EssentialType;
+    isConstant: boolean;
+    /**
+     * Value of integer constant expressions, if it could be computed
+     */
+    value?: bigint;
+}
+
+/**
+ * Widths of the builtin types whose size does not depend on the target
+ */
+const BUILTIN_WIDTHS: Record<string, number> = {
+    Bool: 8, Char_S: 8, Char_U: 8, SChar: 8, UChar: 8,
+    Short: 16, UShort: 16, LongLong: 64, ULongLong: 64,
+    Float: 32, Double: 64
+};
+
+/**
+ * Width of `int` assumed when the target does not provide it
+ */
+const DEFAULT_INT_WIDTH = 32;
+
+let cachedIntWidth: number | undefined = undefined;
+
+/**
+ * Returns the width in bits of `int` on the target (at least 16), which bounds the types affected by the integer promotions
+ */
+export function getIntWidth(): number {
+    cachedIntWidth ??= ClavaJoinPoints.builtinType("int").bitWidth ?? DEFAULT_INT_WIDTH;
+    return cachedIntWidth;
+}
+
+/**
+ * Clears the cached width of `int`, so that it is read again from the target of the next analysis
+ */
+export function resetIntWidth() {
+    cachedIntWidth = undefined;
+}
+
+/**
+ * Operators whose result is a composite expression
+ */
+const COMPOSITE_KINDS = new Set(["mul", "div", "rem", "add", "sub", "shl", "shr", "and", "or", "xor"]);
+
+/**
+ * Returns the essential type of the given type, without considering the expression it belongs to
+ *
+ * @param typeJp The type
+ */
+export function getEssentialTypeOfType(typeJp: Type): EssentialType {
+    let type = typeJp.desugarAll;
+    while (type instanceof QualType) {
+        type = type.unqualifiedType.desugarAll;
+    }
+
+    if (type instanceof BuiltinType) {
+        const width = type.builtinKind === "Int" || type.builtinKind === "UInt" ?
+            getIntWidth() :
+            BUILTIN_WIDTHS[type.builtinKind] ?? type.bitWidth ?? 0;
+        if (type.builtinKind === "Bool") {
+            return { category: EssentialTypeCategory.BOOLEAN, width };
+        } else if (type.builtinKind === "Char_S" || type.builtinKind === "Char_U") {
+            return { category: EssentialTypeCategory.CHARACTER, width };
+        } else if (type.isInteger) {
+            return { category: type.isSigned ? EssentialTypeCategory.SIGNED : EssentialTypeCategory.UNSIGNED, width };
+        } else if (type.isFloat) {
+            return { category: EssentialTypeCategory.FLOATING, width };
+        }
+    } else if (type instanceof EnumType) {
+        // Constants of anonymous enumerations are essentially signed
+        const width = type.bitWidth ?? getIntWidth();
+        return isNamedEnum(type.name) ?
+            { category: EssentialTypeCategory.ENUM, width, enumName: type.name } :
+            { category: EssentialTypeCategory.SIGNED, width };
+    }
+    return { category: EssentialTypeCategory.UNKNOWN, width: 0 };
+}
+
+/**
+ * Checks if the given category is essentially signed or essentially unsigned
+ *
+ * @param category The essential type category
+ */
+export function isIntegerCategory(category: EssentialTypeCategory): boolean {
+    return category === EssentialTypeCategory.SIGNED || category === EssentialTypeCategory.UNSIGNED;
+}
+
+/**
+ * Essential type inference, shared by the rules of the essential type model.
+ *
+ * The essential type of each expression is computed bottom-up from the essential types of its operands and memoized by node.
+ * Entries are tagged with the version of their scope (the enclosing function, or the file for expressions at file scope),
+ * so only the expressions of changed scopes are inferred again. The scope of a node is only looked up when it is first inferred.
+ */
+export class EssentialTypeAnalysis {
+    #entries = new Map<string, {scope: string, epoch: string, info: ExpressionInfo}>();
+    #getScope: ($jp: Joinpoint) => string;
+    #getEpoch: (scope: string) => string;
+
+    /**
+     * @param getScope Returns the identifier of the scope that contains the given node
+     * @param getEpoch Returns the current version of the given scope, which changes whenever that scope changes
+     */
+    constructor(getScope: ($jp: Joinpoint) => string, getEpoch: (scope: string) => string) {
+        this.#getScope = getScope;
+        this.#getEpoch = getEpoch;
+    }
+
+    /**
+     * Discards all inferred types
+     */
+    clear() {
+        this.#entries.clear();
+    }
+
+    /**
+     * Returns the essential type of the given expression
+     *
+     * @param exprJp The expression
+     */
+    getEssentialType(exprJp: Expression): EssentialType {
+        return this.lookup(exprJp).type;
+    }
+
+    /**
+     * Checks if the given expression is a constant expression
+     *
+     * @param exprJp The expression
+     */
+    isConstant(exprJp: Expression): boolean {
+        return this.lookup(exprJp).isConstant;
+    }
+
+    /**
+     * Returns the value of the given integer constant expression, or undefined if it is not constant or could not be computed
+     *
+     * @param exprJp The expression
+     */
+    getConstantValue(exprJp: Expression): bigint | undefined {
+        return this.lookup(exprJp).value;
+    }
+
+    /**
+     * Checks if the given expression is a composite expression, i.e., a non-constant expression that is the direct result of a composite operator
+     * (multiplicative, additive, bitwise and shift operators, or a conditional operator with a composite operand)
+     *
+     * @param exprJp The expression
+     */
+    isComposite(exprJp: Expression): boolean {
+        const innerJp = skipParentheses(exprJp);
+        if (this.isConstant(innerJp)) {
+            return false;
+        } else if (innerJp instanceof BinaryOp) {
+            return COMPOSITE_KINDS.has(innerJp.kind);
+        } else if (innerJp instanceof TernaryOp) {
+            return this.isComposite(innerJp.trueExpr) || this.isComposite(innerJp.falseExpr);
+        }
+        return false;
+    }
+
+    private lookup(exprJp: Expression): ExpressionInfo {
+        const scope = this.#entries.get(exprJp.astId)?.scope ?? this.#getScope(exprJp);
+        return this.infer(exprJp, scope, this.#getEpoch(scope));
+    }
+
+    private infer(exprJp: Expression, scope: string, epoch: string): ExpressionInfo {
+        const entry = this.#entries.get(exprJp.astId);
+        if (entry !== undefined && entry.epoch === epoch) {
+            return entry.info;
+        }
+
+        const info = this.compute(exprJp, scope, epoch);
+        this.#entries.set(exprJp.astId, {scope, epoch, info});
+        return info;
+    }
+
+    private compute(exprJp: Expression, scope: string, epoch: string): ExpressionInfo {
+        const standardInfo = (isConstant: boolean = false): ExpressionInfo => ({ type: getEssentialTypeOfType(exprJp.type), isConstant });
+
+        if (exprJp instanceof ParenExpr) {
+            return this.infer(exprJp.subExpr, scope, epoch);
+        } else if (exprJp instanceof IntLiteral) {
+            const info = standardInfo(true);
+            const value = parseIntegerLiteral(exprJp.code);
+            return value === undefined ? info : { ...info, value, type: { category: info.type.category, width: getConstantWidth(info.type.category, value) } };
+        } else if (exprJp instanceof FloatLiteral) {
+            return standardInfo(true);
+        } else if (exprJp instanceof BoolLiteral) {
+            return { type: { category: EssentialTypeCategory.BOOLEAN, width: 8 }, isConstant: true };
+        } else if (exprJp instanceof Literal && /^(u8|[LuU])?'/.test(exprJp.code)) {
+            return { type: { category: EssentialTypeCategory.CHARACTER, width: 8 }, isConstant: true };
+        } else if (exprJp instanceof Varref) {
+            return this.computeVarref(exprJp, standardInfo);
+        } else if (exprJp instanceof Cast) {
+            const type = getEssentialTypeOfType(exprJp.type);
+            const operand = this.infer(exprJp.subExpr, scope, epoch);
+            return { type, isConstant: operand.isConstant, value: isIntegerCategory(type.category) ? operand.value : undefined };
+        } else if (exprJp instanceof UnaryExprOrType) {
+            return standardInfo(!(exprJp.argType instanceof VariableArrayType));
+        } else if (exprJp instanceof UnaryOp) {
+            return this.computeUnaryOp(exprJp, scope, epoch, standardInfo);
+        } else if (exprJp instanceof BinaryOp) {
+            return this.computeBinaryOp(exprJp, scope, epoch, standardInfo);
+        } else if (exprJp instanceof TernaryOp) {
+            const trueInfo = this.infer(exprJp.trueExpr, scope, epoch);
+            const falseInfo = this.infer(exprJp.falseExpr, scope, epoch);
+            const sameCategory = trueInfo.type.category === falseInfo.type.category && trueInfo.type.enumName === falseInfo.type.enumName;
+            if (sameCategory && trueInfo.type.category !== EssentialTypeCategory.UNKNOWN) {
+                return { type: { ...trueInfo.type, width: Math.max(trueInfo.type.width, falseInfo.type.width) }, isConstant: false };
+            }
+        }
+        return standardInfo();
+    }
+
+    private computeVarref(refJp: Varref, standardInfo: () => ExpressionInfo): ExpressionInfo {
+        const declJp = refJp.decl as Joinpoint | undefined;
+        if (declJp instanceof EnumeratorDecl) {
+            const enumJp = declJp.parent;
+            const info = standardInfo();
+            if (enumJp instanceof EnumDecl && isNamedEnum(enumJp.name)) {
+                return { type: { category: EssentialTypeCategory.ENUM, width: info.type.width, enumName: enumJp.name }, isConstant: true };
+            }
+            return { ...info, isConstant: true };
+        }
+        return standardInfo();
+    }
+
+    private computeUnaryOp(opJp: UnaryOp, scope: string, epoch: string, standardInfo: (isConstant?: boolean) => ExpressionInfo): ExpressionInfo {
+        const operand = this.infer(opJp.operand, scope, epoch);
+
+        switch (opJp.kind) {
+            case "l_not":
+                return { type: { category: EssentialTypeCategory.BOOLEAN, width: 8 }, isConstant: operand.isConstant };
+            case "pre_inc":
+            case "pre_dec":
+            case "post_inc":
+            case "post_dec":
+                return { type: operand.type, isConstant: false };
+            case "plus":
+            case "minus":
+            case "not": {
+                const category = operand.type.category;
+                if (!isIntegerCategory(category) || (opJp.kind === "minus" && category === EssentialTypeCategory.UNSIGNED)) {
+                    return standardInfo(operand.isConstant);
+                }
+                if (operand.value === undefined) {
+                    return { type: operand.type, isConstant: operand.isConstant };
+                }
+                const result = opJp.kind === "minus" ? -operand.value : opJp.kind === "not" ? ~operand.value : operand.value;
+                return this.constantInfo(category, result, standardInfo().type.width);
+            }
+        }
+        return standardInfo();
+    }
+
+    private computeBinaryOp(opJp: BinaryOp, scope: string, epoch: string, standardInfo: (isConstant?: boolean) => ExpressionInfo): ExpressionInfo {
+        const kind = opJp.kind;
+        if (kind === "comma") {
+            return { ...this.infer(opJp.right, scope, epoch), isConstant: false };
+        } else if (opJp.isAssignment) {
+            return { type: this.infer(opJp.left, scope, epoch).type, isConstant: false };
+        }
+
+        const left = this.infer(opJp.left, scope, epoch);
+        const right = this.infer(opJp.right, scope, epoch);
+        const isConstant = left.isConstant && right.isConstant;
+        const leftCategory = left.type.category, rightCategory = right.type.category;
+
+        if (["lt", "gt", "le", "ge", "eq", "ne", "l_and", "l_or"].includes(kind)) {
+            return { type: { category: EssentialTypeCategory.BOOLEAN, width: 8 }, isConstant };
+        }
+
+        // Addition of a character and an integer, or subtraction of an integer from a character, produces a character
+        if ((kind === "add" && ((leftCategory === EssentialTypeCategory.CHARACTER && isIntegerCategory(rightCategory)) ||
+                (rightCategory === EssentialTypeCategory.CHARACTER && isIntegerCategory(leftCategory)))) ||
+            (kind === "sub" && leftCategory === EssentialTypeCategory.CHARACTER && isIntegerCategory(rightCategory))) {
+            return { type: { category: EssentialTypeCategory.CHARACTER, width: 8 }, isConstant };
+        }
+
+        const standardWidth = standardInfo().type.width;
+        if ((kind === "shl" || kind === "shr") && isIntegerCategory(leftCategory)) {
+            const value = left.value !== undefined && right.value !== undefined ? evaluate(kind, left.value, right.value) : undefined;
+            return value !== undefined ? this.constantInfo(leftCategory, value, standardWidth) : { type: left.type, isConstant };
+        }
+
+        if (COMPOSITE_KINDS.has(kind) && leftCategory === rightCategory && isIntegerCategory(leftCategory)) {
+            const value = left.value !== undefined && right.value !== undefined ? evaluate(kind, left.value, right.value) : undefined;
+            return value !== undefined ?
+                this.constantInfo(leftCategory, value, standardWidth) :
+                { type: { category: leftCategory, width: Math.max(left.type.width, right.type.width) }, isConstant };
+        }
+
+        // Otherwise, the essential type is the standard type of the expression
+        return standardInfo(isConstant);
+    }
+
+    /**
+     * Builds the information of an integer constant expression: its essential type is the smallest type of its category that can represent its value
+     */
+    private constantInfo(category: EssentialTypeCategory, value: bigint, standardWidth: number): ExpressionInfo {
+        const wrappedValue = category === EssentialTypeCategory.UNSIGNED && standardWidth > 0 ? BigInt.asUintN(standardWidth, value) : value;
+        return { type: { category, width: getConstantWidth(category, wrappedValue) }, isConstant: true, value: wrappedValue };
+    }
+}
+
+/**
+ * Returns the type to which the value of the given expression is assigned: the object of an assignment, the initialized variable,
+ * the return type of the function, or the parameter of the called function. Returns undefined if the expression is not assigned.
+ *
+ * @param exprJp The expression
+ */
+export function getAssignedType(exprJp: Expression): Type | undefined {
+    const parentJp = exprJp.parent;
+
+    if (parentJp instanceof BinaryOp && parentJp.kind === "assign" && parentJp.right.astId === exprJp.astId) {
+        return parentJp.left.type;
+    } else if (parentJp instanceof Vardecl && parentJp.hasInit && parentJp.init.astId === exprJp.astId) {
+        return parentJp.type;
+    } else if (parentJp instanceof ReturnStmt) {
+        return (parentJp.getAncestor("function") as FunctionJp | undefined)?.returnType;
+    } else if (parentJp instanceof Call) {
+        const argIndex = parentJp.argList.findIndex(argJp => argJp.astId === exprJp.astId);
+        const params = parentJp.function?.params ?? [];
+        return argIndex !== -1 && argIndex < params.length ? params[argIndex].type : undefined;
+    }
+    return undefined;
+}
+
+/**
+ * Widens a composite expression by casting its leftmost operand to the given type, so that the operation is performed in that type
+ *
+ * @param compositeJp The composite binary operation
+ * @param typeJp The type in which the operation must be performed
+ */
+export function castLeftmostOperand(compositeJp: BinaryOp, typeJp: Type) {
+    let operandJp = compositeJp.left;
+    let innerJp = skipParentheses(operandJp);
+    while (innerJp instanceof BinaryOp && COMPOSITE_KINDS.has(innerJp.kind)) {
+        operandJp = innerJp.left;
+        innerJp = skipParentheses(operandJp);
+    }
+
+    const castType = typeJp instanceof QualType ? typeJp.unqualifiedType : typeJp;
+    const castJp = operandJp.replaceWith(ClavaJoinPoints.cStyleCast(castType, operandJp)) as Cast;
+    castJp.subExpr.replaceWith(operandJp);
+}
+
+/**
+ * Returns the expression inside the given parentheses, or the expression itself if it is not parenthesized
+ *
+ * @param exprJp The expression
+ */
+export function skipParentheses(exprJp: Expression): Expression {
+    while (exprJp instanceof ParenExpr) {
+        exprJp = exprJp.subExpr;
+    }
+    return exprJp;
+}
+
+function isNamedEnum(name: string | undefined): boolean {
+    return name !== undefined && name !== "" && !name.includes("anonymous");
+}
+
+/**
+ * @returns Width of the smallest signed or unsigned type that can represent the value
+ */
+function getConstantWidth(category: EssentialTypeCategory, value: bigint): number {
+    for (const width of [8, 16, 32, 64]) {
+        const fits = category === EssentialTypeCategory.UNSIGNED ?
+            value >= 0n && value < (1n << BigInt(width)) :
+            value >= -(1n << BigInt(width - 1)) && value < (1n << BigInt(width - 1));
+        if (fits) {
+            return width;
+        }
+    }
+    return 128;
+}
+
+/**
+ * @returns Value of a decimal, hexadecimal, octal or binary integer literal, or undefined if it cannot be parsed
+ */
+function parseIntegerLiteral(code: string): bigint | undefined {
+    const digits = code.trim().replace(/[uUlL]+$/, "");
+    try {
+        return /^0[0-7]+$/.test(digits) ? BigInt("0o" + digits.slice(1)) : BigInt(digits);
+    } catch (error) {
+        return undefined;
+    }
+}
+
+/**
+ * @returns Result of an integer operation on constant operands, or undefined if it is undefined or too large
+ */
+function evaluate(kind: string, left: bigint, right: bigint): bigint | undefined {
+    switch (kind) {
+        case "mul": return left * right;
+        case "div": return right === 0n ? undefined : left / right;
+        case "rem": return right === 0n ? undefined : left % right;
+        case "add": return left + right;
+        case "sub": return left - right;
+        case "and": return left & right;
+        case "or": return left | right;
+        case "xor": return left ^ right;
+        case "shl": return right < 0n || right >= 128n ? undefined : left << right;
+        case "shr": return right < 0n || right >= 128n ? undefined : left >> right;
+    }
+    return undefined;
+}
@@ -1,9 +1,12 @@
 import ClavaJoinPoints from "@specs-feup/clava/api/clava/ClavaJoinPoints.js";
 import { FileJp, Program, Include, Call, FunctionJp, Joinpoint, StorageClass } from "@specs-feup/clava/api/Joinpoints.js";
 import Query from "@specs-feup/lara/api/weaver/Query.js";
-import { isCallToImplicitFunction } from "./CallUtils.js";
+import { ImplicitCallResolver } from "./CallUtils.js";
 import { isExternalLinkageIdentifier } from "./IdentifierUtils.js";
 import path from "path";
+import MISRATransaction from "../MISRATransaction.js";
+import { getHeaderIncluders, resetHeaderUsageCache } from "./HeaderUsageCache.js";
+import { getCachedExplicitCall, getCachedVerdict, getValidationKey, invalidateValidationContext, setCachedExplicitCall, setCachedVerdict } from "./ValidationCache.js";
 
 /**
  * Checks if a file compiles correctly after adding a statement by rebuilding it.
@@ -14,14 +17,24 @@ import path from "path";
 export function isValidFile(fileJp: FileJp, jpType?: typeof Joinpoint, index?: number) : boolean | Joinpoint | undefined {
     let result: boolean | Joinpoint = true;
 
+    // Reuse the verdict of a previous validation of the same content. Requests for a join point still require a rebuild
+    const code = fileJp.code;
+    const validationKey = getValidationKey(fileJp, code);
+    const cachedVerdict = getCachedVerdict(validationKey);
+    const requestsJoinpoint = jpType !== undefined && index !== undefined;
+    if (cachedVerdict === false || (cachedVerdict === true && !requestsJoinpoint)) {
+        return cachedVerdict;
+    }
+
     // Create a temporary copy of the file for validation
     const programJp = fileJp.parent as Program;
-    let copyFile = ClavaJoinPoints.fileWithSource(`temp_misra_${fileJp.name}`, fileJp.code, fileJp.relativeFolderpath);
+    let copyFile = ClavaJoinPoints.fileWithSource(`temp_misra_${fileJp.name}`, code, fileJp.relativeFolderpath);
     copyFile = programJp.addFile(copyFile) as FileJp;
 
     try {
         const rebuiltFile = copyFile.rebuild();
-        if (jpType && index) { // If requested, return a specific join point inside the rebuilt file
+        setCachedVerdict(validationKey, true);
+        if (requestsJoinpoint) { // If requested, return a specific join point inside the rebuilt file
             result = Query.searchFrom(rebuiltFile, jpType).get()[index];
         }
         
@@ -31,11 +44,84 @@ export function isValidFile(fileJp: FileJp, jpType?: typeof Joinpoint, index?: n
         return result;
     } catch(error) {
         // On rebuild failure, delete copy file and return false
+        setCachedVerdict(validationKey, false);
         copyFile.detach();
         return false;
     }
 }
 
+/**
+ * Replaces the code of a file by the given text, if the new code compiles.
+ * The original file is detached and a new file with the same name and folder takes its place.
+ * 
+ * @param fileJp The file to modify
+ * @param code The new code of the file
+ * @returns The rebuilt file, or undefined if the new code does not compile (in which case the original file is restored)
+ */
+export function replaceFileCode(fileJp: FileJp, code: string): FileJp | undefined {
+    const validationKey = getValidationKey(fileJp, code);
+    if (getCachedVerdict(validationKey) === false) {
+        return undefined;
+    }
+
+    const programJp = fileJp.parent as Program;
+    const newFile = ClavaJoinPoints.fileWithSource(fileJp.name, code, fileJp.relativeFolderpath);
+    fileJp.detach();
+    const addedFile = programJp.addFile(newFile) as FileJp;
+
+    try {
+        const rebuiltFile = addedFile.rebuild();
+        setCachedVerdict(validationKey, true);
+        return rebuiltFile;
+    } catch(error) { // On rebuild failure, restore the original file
+        setCachedVerdict(validationKey, false);
+        addedFile.detach();
+        programJp.addFile(fileJp);
+        return undefined;
+    }
+}
+
+/**
+ * Adds a new source file with the given code to the program and builds it
+ * 
+ * @param programJp The program
+ * @param location Path of the new file, relative to the program
+ * @param code The code of the new file
+ * @returns The built file, or undefined if the code does not compile (in which case the file is removed)
+ */
+export function addGeneratedFile(programJp: Program, location: string, code: string): FileJp | undefined {
+    const folder = path.dirname(location);
+    const newFile = ClavaJoinPoints.fileWithSource(path.basename(location), code, folder === "." ? undefined : folder);
+    const addedFile = programJp.addFile(newFile) as FileJp;
+
+    try {
+        const rebuiltFile = addedFile.rebuild();
+        invalidateValidationContext(rebuiltFile);
+        return rebuiltFile;
+    } catch(error) { 
+        addedFile.detach();
+        return undefined;
+    }
+}
+
+/**
+ * Describes a call that must be explicit after rebuilding a file
+ */
+export interface ExplicitCallCheck {
+    /**
+     * The function name to search the call
+     */
+    funcName: string;
+    /**
+     * The index of the call among the calls with the same name
+     */
+    callIndex: number;
+    /**
+     * Whether the number of arguments must match the number of parameters of the callee
+     */
+    checkNumParams?: boolean;
+}
+
 /**
  * Checks if the rebuilt version of the file compiles and if the provided call is no longer implicit.
  * 
@@ -44,35 +130,103 @@ export function isValidFile(fileJp: FileJp, jpType?: typeof Joinpoint, index?: n
  * @param callIndex The index of the call 
  */
 export function isValidFileWithExplicitCall(fileJp: FileJp, funcName: string, callIndex: number, checkNumParams: boolean = false): boolean {
+    return isValidFileWithExplicitCalls(fileJp, [{funcName, callIndex, checkNumParams}]);
+}
+
+/**
+ * Checks if the rebuilt version of the file compiles and if all the provided calls are no longer implicit.
+ * The file is rebuilt only once, regardless of the number of calls to check.
+ * 
+ * @param fileJp The file to analyze
+ * @param calls The calls that must be explicit
+ */
+export function isValidFileWithExplicitCalls(fileJp: FileJp, calls: ExplicitCallCheck[]): boolean {
     const programJp = fileJp.parent as Program;
 
+    // Reuse the results of a previous validation of the same content
+    const code = fileJp.code;
+    const validationKey = getValidationKey(fileJp, code);
+    const cachedVerdict = getCachedVerdict(validationKey);
+    if (cachedVerdict === false) {
+        return false;
+    }
+    const cachedResults = calls.map(check => getCachedExplicitCall(validationKey, check.funcName, check.callIndex, check.checkNumParams ?? false));
+    if (cachedVerdict === true && cachedResults.every(isExplicit => isExplicit !== undefined)) {
+        return cachedResults.every(isExplicit => isExplicit);
+    }
+
     // Create a temporary copy of the file for validation
-    let copyFile = ClavaJoinPoints.fileWithSource(`temp_misra_${fileJp.name}`, fileJp.code, fileJp.relativeFolderpath);
+    let copyFile = ClavaJoinPoints.fileWithSource(`temp_misra_${fileJp.name}`, code, fileJp.relativeFolderpath);
     copyFile = programJp.addFile(copyFile) as FileJp;
 
     try {
         // Rebuild the file to check validity
         const rebuiltFile = copyFile.rebuild();
         const fileToRemove = Query.searchFrom(programJp, FileJp, {filepath: rebuiltFile.filepath}).first() as FileJp;
+        setCachedVerdict(validationKey, true);
 
-        // Locate the function call and check if it is implicit
-        const callJp = Query.searchFrom(fileToRemove, Call, {name: funcName}).get().at(callIndex);
-        let isExplicitCall = callJp !== undefined && !isCallToImplicitFunction(callJp);
-        
-        if (checkNumParams && isExplicitCall) {
-            isExplicitCall = isExplicitCall && callJp!.args.length === callJp!.directCallee.params.length;
+        // Locate each function call and check if it is implicit
+        const resolver = new ImplicitCallResolver(fileToRemove);
+        let allExplicit = true;
+        for (const check of calls) {
+            const callJp = resolver.getCall(check.funcName, check.callIndex);
+            let isExplicitCall = callJp !== undefined && !resolver.isImplicitCall(callJp);
+
+            if (check.checkNumParams && isExplicitCall) {
+                const calleeJp = callJp!.directCallee;
+                isExplicitCall = callJp!.args.length === calleeJp.params.length ||
+                    (calleeJp.functionType.isVariadic && callJp!.args.length > calleeJp.params.length);
+            }
+            setCachedExplicitCall(validationKey, check.funcName, check.callIndex, check.checkNumParams ?? false, isExplicitCall);
+            allExplicit &&= isExplicitCall;
         }
 
         // Remove the temporary file
         fileToRemove?.detach();
-        return isExplicitCall;
+        return allExplicit;
 
     } catch(error) { // On rebuild failure, delete copy file and return false
+        setCachedVerdict(validationKey, false);
         copyFile.detach();
         return false;
     }
 }
 
+/**
+ * Applies a set of candidate fixes to a file and validates them with as few rebuilds as possible.
+ * 
+ * All candidates are applied and validated at once. If validation fails, their transactions are rolled back and the set is 
+ * split in half, so that each half is validated separately until the failing candidates are isolated.
+ * This requires O(log k) validations per failing candidate, instead of one validation per candidate.
+ * 
+ * @param candidates The candidate fixes to validate
+ * @param applyFix Applies a candidate fix to the AST, recording its edits in the returned transaction
+ * @param isValid Checks if the file is valid with the given group of candidates applied (previously accepted candidates remain applied)
+ * @returns The candidates that were accepted and committed. The remaining ones are rolled back.
+ */
+export function validateFixesInBatch<T>(candidates: T[], applyFix: (candidate: T) => MISRATransaction, isValid: (group: T[]) => boolean): T[] {
+    if (candidates.length === 0) {
+        return [];
+    }
+
+    const transactions = candidates.map(candidate => applyFix(candidate));
+    if (isValid(candidates)) {
+        transactions.forEach(transaction => transaction.commit());
+        return candidates;
+    }
+    transactions.reverse().forEach(transaction => transaction.rollback());
+
+    if (candidates.length === 1) {
+        return [];
+    }
+
+    // Validate each half separately, keeping the accepted candidates of the first half applied
+    const middle = Math.ceil(candidates.length / 2);
+    const acceptedFirstHalf = validateFixesInBatch(candidates.slice(0, middle), applyFix, isValid);
+    const acceptedSecondHalf = validateFixesInBatch(candidates.slice(middle), applyFix, isValid);
+    return [...acceptedFirstHalf, ...acceptedSecondHalf];
+}
+
 /**
  * Retrieves the list of header files included in the given file
  *
@@ -92,6 +246,8 @@ export function getIncludesOfFile(fileJp: FileJp): Set<string> {
 export function removeIncludeFromFile(includeName: string, fileJp: FileJp) {
     const include = Query.searchFrom(fileJp, Include, {name: includeName}).first();
     include?.detach();
+    resetHeaderUsageCache();
+    invalidateValidationContext(fileJp);
 }
 
 /**
@@ -101,25 +257,9 @@ export function removeIncludeFromFile(includeName: string, fileJp: FileJp) {
  * @returns An array of files that include the specified header
  */
 export function findFilesReferencingHeader(headerName: string): FileJp[] {
-    return Query.search(FileJp, (jp) =>{ return getIncludesOfFile(jp).has(headerName)}).get();
+    return getHeaderIncluders(headerName);
 }
 
-/**
- * Returns all files in the program that contain at least one call to an implicit function
- *
- * @param programJp - The program to analyze
- * @returns A list of files with implicit function calls
- */
-export function getFilesWithCallToImplicitFunction(programJp: Program): FileJp[] {
-    const files = Query.searchFrom(programJp, FileJp).get();
-    return files.filter(
-      (fileJp) =>
-        Query.searchFrom(fileJp, Call, (callJp) =>
-          isCallToImplicitFunction(callJp)
-        ).get().length > 0
-    );
-} 
-
 /**
  * Inserts an extern declaration of the given function into the file.
  * 
@@ -141,6 +281,7 @@ export function addExternFunctionDecl(fileJp: FileJp, functionJp: FunctionJp): J
     const externStr = `extern ${functionJp.getDeclaration(true)};`;
     const externStmt = ClavaJoinPoints.stmtLiteral(externStr);
     const newExternStmt = childAfterExtern.insertBefore(externStmt);
+    invalidateValidationContext(fileJp);
     return newExternStmt;
 }
 
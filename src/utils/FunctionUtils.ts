@@ -1,6 +1,6 @@
-import { Param, Varref, FunctionJp, StorageClass, GotoStmt, LabelStmt, FileJp, Call, VariableArrayType } from "@specs-feup/clava/api/Joinpoints.js";
+import { Param, Varref, FunctionJp, StorageClass, GotoStmt, LabelStmt, FileJp, VariableArrayType } from "@specs-feup/clava/api/Joinpoints.js";
 import Query from "@specs-feup/lara/api/weaver/Query.js";
-import { findFilesReferencingHeader } from "./FileUtils.js";
+import { getUsageScopeReferences } from "./HeaderUsageCache.js";
 import { hasDefinedType } from "./JoinpointUtils.js";
 
 /**
@@ -49,25 +49,6 @@ export function getUnusedLabels(func: FunctionJp): LabelStmt[] {
     );
 }
 
-/**
- * Returns the first function definition matching the given name and file path suffix
- *
- * @param functionName Name of the function
- * @param pathSuffix File path suffix
- * @returns The function definition, or undefined if not found
- */
-
-export function findFunctionDef(functionName: string, pathSuffix: string) {
-    const funcDefs = Query.search(FunctionJp, (func) => {
-                try {
-                    return func.name === functionName && func.isImplementation && func.filepath.endsWith(pathSuffix)
-                } catch (error) {
-                    return false;
-                }
-            }).get();
-    return funcDefs.length > 0 ? funcDefs[0] : undefined;
-}
-
 /**
  * Finds extern declarations for the given function
  * @param functionJp The function join point
@@ -84,14 +65,5 @@ export function findExternalFunctionDecl(functionJp: FunctionJp): FunctionJp[] {
  * @returns True if the function is used, false otherwise
  */
 export function isFunctionUsed(functionJp: FunctionJp): boolean {
-    const fileJp = functionJp.getAncestor("file") as FileJp;
-    let referencingFiles: FileJp[];
-
-    if (fileJp.isHeader) {
-        const filesWithInclude = findFilesReferencingHeader(fileJp.name);
-        referencingFiles = [fileJp, ...filesWithInclude];
-    } else {
-        referencingFiles = [fileJp];
-    }
-    return referencingFiles.some(fileJp => Query.searchFrom(fileJp, Call, {name: functionJp.name, directCallee: (jp) => jp?.ast === functionJp.ast}).get().length > 0)
-}
\ No newline at end of file
+    return getUsageScopeReferences(functionJp.getAncestor("file") as FileJp).functions.has(functionJp.astId);
+}
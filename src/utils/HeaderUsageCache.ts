@@ -0,0 +1,169 @@
+import { Call, ElaboratedType, EnumeratorDecl, FileJp, Joinpoint, TagType, TypedefDecl, TypedefType, Varref } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { getBaseType } from "./JoinpointUtils.js";
+import { getIncludesOfFile } from "./FileUtils.js";
+
+/**
+ * Declarations referenced by the nodes of a file, by identifier
+ */
+export interface FileReferences {
+    /**
+     * Typedefs named by the type of a node
+     */
+    typedefs: Set<string>;
+    /**
+     * Tags named by the type of a node, other than the typedef declared along with the tag
+     */
+    tags: Set<string>;
+    /**
+     * Enumerators referenced by a variable reference
+     */
+    enumerators: Set<string>;
+    /**
+     * Variables referenced by a variable reference
+     */
+    vars: Set<string>;
+    /**
+     * Functions directly called
+     */
+    functions: Set<string>;
+}
+
+/**
+ * References of each file, indexed by the identifier of the file.
+ * Since rebuilt files get new identifiers, entries of previous versions of a file are never reused.
+ */
+let fileReferences = new Map<string, FileReferences>();
+
+/**
+ * Files that include each header, indexed by the name of the header
+ */
+let headerIncluders = new Map<string, FileJp[]>();
+
+/**
+ * References of each header and of the files that include it, indexed by the identifier of the header
+ */
+let headerReferences = new Map<string, FileReferences>();
+
+/**
+ * Returns the references of the given file and, if it is a header, of all files that include it.
+ * Each file is scanned once and the references of a header are merged once, so that checking the usage of
+ * many declarations of a header shared by many files does not scan all of them for each declaration.
+ *
+ * @param fileJp The file that declares the checked declarations
+ * @returns The references made by the file and by the files that include it
+ */
+export function getUsageScopeReferences(fileJp: FileJp): FileReferences {
+    if (!fileJp.isHeader) {
+        return getFileReferences(fileJp);
+    }
+
+    let references = headerReferences.get(fileJp.astId);
+    if (references === undefined) {
+        references = mergeReferences([fileJp, ...getHeaderIncluders(fileJp.name)].map(getFileReferences));
+        headerReferences.set(fileJp.astId, references);
+    }
+    return references;
+}
+
+/**
+ * Returns all files in the program that include the given header, computed once until the files are rebuilt
+ *
+ * @param headerName - The name of the header file
+ */
+export function getHeaderIncluders(headerName: string): FileJp[] {
+    let includers = headerIncluders.get(headerName);
+    if (includers === undefined) {
+        includers = Query.search(FileJp, (jp) => getIncludesOfFile(jp).has(headerName)).get();
+        headerIncluders.set(headerName, includers);
+    }
+    return includers;
+}
+
+/**
+ * Discards the references of a modified file and the merged references of every header
+ *
+ * @param fileJp The modified file
+ */
+export function invalidateFileReferences(fileJp: FileJp) {
+    fileReferences.delete(fileJp.astId);
+    headerReferences.clear();
+}
+
+/**
+ * Discards all references and includers, e.g., after rebuilding files or changing their includes
+ */
+export function resetHeaderUsageCache() {
+    fileReferences = new Map<string, FileReferences>();
+    headerIncluders = new Map<string, FileJp[]>();
+    headerReferences = new Map<string, FileReferences>();
+}
+
+function getFileReferences(fileJp: FileJp): FileReferences {
+    let references = fileReferences.get(fileJp.astId);
+    if (references === undefined) {
+        references = scanFile(fileJp);
+        fileReferences.set(fileJp.astId, references);
+    }
+    return references;
+}
+
+/**
+ * Collects the references of every node of a file, in a single pass
+ */
+function scanFile(fileJp: FileJp): FileReferences {
+    const references = emptyReferences();
+
+    for (const jp of fileJp.descendants) {
+        if (jp instanceof Varref) {
+            const decl = jp.getValue("decl");
+            if (decl instanceof EnumeratorDecl) {
+                references.enumerators.add(decl.astId);
+            } else if (decl !== undefined && decl !== null) {
+                references.vars.add(decl.astId);
+            }
+        } else if (jp instanceof Call) {
+            const callee = jp.directCallee;
+            if (callee !== undefined && callee !== null) {
+                references.functions.add(callee.astId);
+            }
+        }
+
+        const jpType = getBaseType(jp);
+        if (jpType === undefined || jpType.isBuiltin) {
+            continue;
+        }
+        const namedType = jpType instanceof ElaboratedType ? jpType.namedType : jpType;
+        if (namedType instanceof TypedefType) {
+            references.typedefs.add(namedType.decl.astId);
+        } else if (jpType instanceof ElaboratedType && namedType instanceof TagType && !isOwnTypedef(jp, namedType.decl)) {
+            references.tags.add(namedType.decl.astId);
+        }
+    }
+    return references;
+}
+
+/**
+ * Checks if the given node is the typedef declared along with a tag, which does not count as a use of the tag
+ */
+function isOwnTypedef(jp: Joinpoint, tagJp: Joinpoint): boolean {
+    if (!(jp instanceof TypedefDecl)) {
+        return false;
+    }
+    const typedefs = Query.searchFrom(tagJp, TypedefDecl).get();
+    return typedefs.length === 1 && typedefs[0].astId === jp.astId;
+}
+
+function mergeReferences(referencesList: FileReferences[]): FileReferences {
+    const merged = emptyReferences();
+    for (const references of referencesList) {
+        for (const key of Object.keys(merged) as (keyof FileReferences)[]) {
+            references[key].forEach(id => merged[key].add(id));
+        }
+    }
+    return merged;
+}
+
+function emptyReferences(): FileReferences {
+    return { typedefs: new Set(), tags: new Set(), enumerators: new Set(), vars: new Set(), functions: new Set() };
+}
@@ -1,6 +1,6 @@
 import { Joinpoint, Vardecl, StorageClass, FunctionJp, TypedefDecl, LabelStmt, NamedDecl } from "@specs-feup/clava/api/Joinpoints.js";
 import { compareLocation, isTagDecl } from "./JoinpointUtils.js";
-import { findDuplicateVarDefinition, findExternalVarRefs, isSameVarDecl } from "./VarUtils.js";
+import { isSameVarDecl } from "./VarUtils.js";
 
 /**
  * Checks if the given joinpoint is an identifier declaration (variable, function, typedef, label, or tag)
@@ -45,29 +45,17 @@ export function areIdentifierNamesEqual(identifier1: Joinpoint, identifier2: Joi
 }
 
 /**
- * Updates the name of an identifier joinpoint
+ * Updates the name of an identifier joinpoint, without renaming other declarations of the same identifier
  * @param $jp The joinpoint to rename
  * @param newName the new identifier name
- * @returns True if renaming was successful, false otherwise
  */
-export function renameIdentifier($jp: Joinpoint, newName: string): boolean {
+export function setIdentifierName($jp: Joinpoint, newName: string) {
     if ($jp instanceof LabelStmt) {
         $jp.decl.setName(newName);
     } 
-    else if ($jp instanceof Vardecl) {
-        const externalRefs = findExternalVarRefs($jp);
-        const duplicateDefs = findDuplicateVarDefinition($jp);
-        
-        $jp.setName(newName);
-        if (isExternalLinkageIdentifier($jp)) { 
-            externalRefs.forEach((varRef) => varRef.setName(newName));
-            duplicateDefs.forEach((defJp) => defJp.setName(newName));   
-        }         
-    } 
     else if ($jp instanceof NamedDecl) {
         $jp.setName(newName);
     } 
-    return true;
 }
 
 /**
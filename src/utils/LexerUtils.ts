@@ -0,0 +1,205 @@
+/**
+ * Kinds of tokens produced by the lexer
+ */
+export enum TokenKind {
+    LINE_COMMENT = "line-comment",
+    BLOCK_COMMENT = "block-comment",
+    DIRECTIVE = "directive",
+    STRING = "string",
+    CHAR = "char",
+    NUMBER = "number",
+    IDENTIFIER = "identifier",
+    PUNCTUATOR = "punctuator"
+}
+
+/**
+ * A token of the source text
+ */
+export interface Token {
+    /**
+     * Kind of the token
+     */
+    kind: TokenKind;
+    /**
+     * Text of the token, as written in the source
+     */
+    text: string;
+    /**
+     * Offset of the first character of the token
+     */
+    offset: number;
+    /**
+     * Line of the first character of the token, starting from 1
+     */
+    line: number;
+    /**
+     * Column of the first character of the token, starting from 1
+     */
+    column: number;
+}
+
+/**
+ * A replacement of a range of the source text
+ */
+export interface TextEdit {
+    /**
+     * Offset of the first replaced character
+     */
+    offset: number;
+    /**
+     * Number of replaced characters
+     */
+    length: number;
+    /**
+     * Replacement text
+     */
+    text: string;
+}
+
+/**
+ * Splits C source text into tokens in a single linear scan.
+ * Whitespace is discarded, preprocessing directives are kept as a single token (excluding trailing comments)
+ * and punctuators are split into single characters, since lexical rules do not need to distinguish operators.
+ *
+ * @param code The source text
+ * @returns The tokens of the text, in order
+ */
+export function tokenize(code: string): Token[] {
+    const tokens: Token[] = [];
+    let offset = 0;
+    let line = 1;
+    let lineStart = 0;
+    let atLineStart = true;
+
+    const advanceTo = (end: number) => {
+        for (let i = offset; i < end; i++) {
+            if (code[i] === "\n") {
+                line++;
+                lineStart = i + 1;
+            }
+        }
+        offset = end;
+    };
+    const push = (kind: TokenKind, end: number) => {
+        tokens.push({ kind, text: code.slice(offset, end), offset, line, column: offset - lineStart + 1 });
+        advanceTo(end);
+    };
+
+    while (offset < code.length) {
+        const char = code[offset];
+        const next = code[offset + 1];
+
+        if (char === "\n") {
+            advanceTo(offset + 1);
+            atLineStart = true;
+        } else if (/\s/.test(char)) {
+            advanceTo(offset + 1);
+        } else if (char === "/" && next === "/") {
+            push(TokenKind.LINE_COMMENT, findLineEnd(code, offset));
+        } else if (char === "/" && next === "*") {
+            const close = code.indexOf("*/", offset + 2);
+            push(TokenKind.BLOCK_COMMENT, close === -1 ? code.length : close + 2);
+        } else if (char === "#" && atLineStart) {
+            push(TokenKind.DIRECTIVE, findDirectiveEnd(code, offset));
+            atLineStart = false;
+        } else if (/[A-Za-z_]/.test(char)) {
+            const prefix = /^(u8|[LuU])?/.exec(code.slice(offset, offset + 2))![0];
+            const quote = code[offset + prefix.length];
+            if (prefix.length > 0 && (quote === '"' || quote === "'")) {
+                push(quote === '"' ? TokenKind.STRING : TokenKind.CHAR, findQuoteEnd(code, offset + prefix.length));
+            } else {
+                push(TokenKind.IDENTIFIER, matchEnd(code, offset, /[A-Za-z0-9_]*/y));
+            }
+            atLineStart = false;
+        } else if (/\d/.test(char) || (char === "." && /\d/.test(next ?? ""))) {
+            push(TokenKind.NUMBER, matchEnd(code, offset, /(?:[eEpP][+-]|[A-Za-z0-9_.])*/y));
+            atLineStart = false;
+        } else if (char === '"' || char === "'") {
+            push(char === '"' ? TokenKind.STRING : TokenKind.CHAR, findQuoteEnd(code, offset));
+            atLineStart = false;
+        } else {
+            push(TokenKind.PUNCTUATOR, offset + 1);
+            atLineStart = false;
+        }
+    }
+    return tokens;
+}
+
+/**
+ * Applies text edits to the source text. Edits that overlap a previous edit are ignored.
+ *
+ * @param code The source text
+ * @param edits The edits to apply, with offsets relative to the original text
+ * @returns The edited text
+ */
+export function applyTextEdits(code: string, edits: TextEdit[]): string {
+    const sortedEdits = [...edits].sort((a, b) => a.offset - b.offset);
+    let result = "";
+    let position = 0;
+
+    for (const edit of sortedEdits) {
+        if (edit.offset < position) {
+            continue;
+        }
+        result += code.slice(position, edit.offset) + edit.text;
+        position = edit.offset + edit.length;
+    }
+    return result + code.slice(position);
+}
+
+/**
+ * @returns Offset of the end of the line, considering line splices (a backslash before the new line)
+ */
+function findLineEnd(code: string, start: number): number {
+    let end = code.indexOf("\n", start);
+    while (end !== -1 && code[end - 1] === "\\") {
+        end = code.indexOf("\n", end + 1);
+    }
+    return end === -1 ? code.length : end;
+}
+
+/**
+ * @returns Offset of the end of the directive, excluding a trailing comment. Quoted and angled header names are skipped as a whole.
+ */
+function findDirectiveEnd(code: string, start: number): number {
+    const lineEnd = findLineEnd(code, start);
+    const isInclude = /^#\s*include\b/.test(code.slice(start, lineEnd));
+    let i = start + 1;
+
+    while (i < lineEnd) {
+        const char = code[i];
+        if (char === "/" && (code[i + 1] === "/" || code[i + 1] === "*")) {
+            break;
+        } else if (char === '"' || char === "'") {
+            i = Math.min(findQuoteEnd(code, i), lineEnd);
+        } else if (char === "<" && isInclude) {
+            const close = code.indexOf(">", i);
+            i = close === -1 || close > lineEnd ? lineEnd : close + 1;
+        } else {
+            i++;
+        }
+    }
+    return code.slice(start, i).trimEnd().length + start;
+}
+
+/**
+ * @returns Offset after the closing quote of a string or character literal, or the end of the line if it is not terminated
+ */
+function findQuoteEnd(code: string, start: number): number {
+    const quote = code[start];
+    let i = start + 1;
+
+    while (i < code.length && code[i] !== quote && code[i] !== "\n") {
+        i += code[i] === "\\" ? 2 : 1;
+    }
+    return code[i] === quote ? i + 1 : i;
+}
+
+/**
+ * @returns Offset after the characters matched by a sticky pattern at the position following the start
+ */
+function matchEnd(code: string, start: number, pattern: RegExp): number {
+    pattern.lastIndex = start + 1;
+    const match = pattern.exec(code);
+    return start + 1 + (match ? match[0].length : 0);
+}
@@ -1,6 +1,9 @@
-import { Vardecl, FunctionJp, LabelStmt, NamedDecl, StorageClass } from "@specs-feup/clava/api/Joinpoints.js";
+import { Vardecl, FunctionJp, LabelStmt, NamedDecl, StorageClass, FileJp, Joinpoint } from "@specs-feup/clava/api/Joinpoints.js";
 import Query from "@specs-feup/lara/api/weaver/Query.js";
 import { isExternalLinkageIdentifier, isIdentifierDecl, isInternalLinkageIdentifier } from "./IdentifierUtils.js";
+import { resetHeaderUsageCache } from "./HeaderUsageCache.js";
+import { invalidateValidationContext } from "./ValidationCache.js";
+import { resetIntWidth } from "./EssentialTypeUtils.js";
 
 let cachedInternalLinkageIdentifiers: (FunctionJp | Vardecl)[] | null = null;
 let cachedExternalLinkageIdentifiers: (FunctionJp | Vardecl)[] | null = null;
@@ -17,6 +20,9 @@ export function resetCaches() {
     cachedExternalLinkageVars = null;
     cachedExternalVarRefs = null;
     cachedIdentifierDecls = null;
+    resetHeaderUsageCache();
+    invalidateValidationContext();
+    resetIntWidth();
 }
 
 /**
@@ -26,6 +32,36 @@ export function resetExternalVarRefs() {
     cachedExternalVarRefs = null;
 }
 
+/**
+ * Updates the cached identifiers after rebuilding some files, without searching the entire program.
+ * Entries of the previous version of the files are discarded and replaced by the ones found in the rebuilt files.
+ * 
+ * @param staleIds Identifiers of the nodes that belonged to the files before rebuilding
+ * @param rebuiltFiles The rebuilt files
+ */
+export function refreshFileCaches(staleIds: Set<string>, rebuiltFiles: FileJp[]) {
+    const refresh = <T extends Joinpoint>(cache: T[] | null, search: (fileJp: FileJp) => T[]): T[] | null => {
+        if (cache === null) {
+            return null;
+        }
+        return [
+            ...cache.filter(jp => !staleIds.has(jp.astId)),
+            ...rebuiltFiles.flatMap(fileJp => search(fileJp))
+        ];
+    };
+
+    cachedInternalLinkageIdentifiers = refresh(cachedInternalLinkageIdentifiers, searchInternalLinkageIdentifiers);
+    cachedExternalLinkageVars = refresh(cachedExternalLinkageVars, searchExternalLinkageVars);
+    cachedExternalVarRefs = refresh(cachedExternalVarRefs, searchExternalVarRefs);
+    cachedIdentifierDecls = refresh(cachedIdentifierDecls, searchIdentifierDecls);
+    cachedExternalLinkageIdentifiers = refresh(cachedExternalLinkageIdentifiers, (fileJp) => [
+        ...searchExternalLinkageFunctions(fileJp), 
+        ...searchExternalLinkageVars(fileJp)
+    ]);
+    // Rebuilt files may include other headers, so the includers of every header are searched again
+    resetHeaderUsageCache();
+}
+
 /**
  * Retrieves all variables and functions that are eligible for `extern` linkage, i.e., 
  * elements with storage classes that are not `STATIC` or `EXTERN`
@@ -38,7 +74,7 @@ export function getExternalLinkageIdentifiers(): (FunctionJp | Vardecl)[] {
     }
 
     const externalLinkageVarDecls = getExternalLinkageVars();
-    const externalLinkageFunctions = Query.search(FunctionJp, (varDeclJp) => isExternalLinkageIdentifier(varDeclJp)).get();
+    const externalLinkageFunctions = searchExternalLinkageFunctions(Query.root() as Joinpoint);
 
     cachedExternalLinkageIdentifiers = [
         ...externalLinkageFunctions, 
@@ -57,12 +93,7 @@ export function getInternalLinkageIdentifiers(): (FunctionJp | Vardecl)[] {
         return cachedInternalLinkageIdentifiers;
     }
 
-    const internalLinkageVarsDecls = Query.search(Vardecl, (decl) => isInternalLinkageIdentifier(decl)).get();
-    const internalLinkageFunctions =  Query.search(FunctionJp, (decl) => isInternalLinkageIdentifier(decl)).get();
-    cachedInternalLinkageIdentifiers = [
-        ...internalLinkageFunctions, 
-        ...internalLinkageVarsDecls
-    ];
+    cachedInternalLinkageIdentifiers = searchInternalLinkageIdentifiers(Query.root() as Joinpoint);
     return cachedInternalLinkageIdentifiers;
 }
 
@@ -75,7 +106,7 @@ export function getExternalLinkageVars(): Vardecl[] {
     if (cachedExternalLinkageVars != null) {
         return cachedExternalLinkageVars;
     }
-    cachedExternalLinkageVars = Query.search(Vardecl, (varDeclJp) => isExternalLinkageIdentifier(varDeclJp)).get();
+    cachedExternalLinkageVars = searchExternalLinkageVars(Query.root() as Joinpoint);
     return cachedExternalLinkageVars;
 }
 
@@ -88,7 +119,7 @@ export function getExternalVarRefs(): Vardecl[] {
     if (cachedExternalVarRefs !== null) {
         return cachedExternalVarRefs;
     }
-    cachedExternalVarRefs = Query.search(Vardecl, {storageClass: StorageClass.EXTERN}).get();
+    cachedExternalVarRefs = searchExternalVarRefs(Query.root() as Joinpoint);
     return cachedExternalVarRefs;
 }
 
@@ -99,9 +130,32 @@ export function getIdentifierDecls(): any[] {
     if (cachedIdentifierDecls !== null) {
         return cachedIdentifierDecls;
     }
-    cachedIdentifierDecls = [
-        ...Query.search(NamedDecl).get(),
-        ...Query.search(LabelStmt).get(),
-    ].filter((jp) => isIdentifierDecl(jp));
+    cachedIdentifierDecls = searchIdentifierDecls(Query.root() as Joinpoint);
     return cachedIdentifierDecls;
+}
+
+function searchExternalLinkageFunctions(startingPoint: Joinpoint): FunctionJp[] {
+    return Query.searchFrom(startingPoint, FunctionJp, (functionJp) => isExternalLinkageIdentifier(functionJp)).get();
+}
+
+function searchExternalLinkageVars(startingPoint: Joinpoint): Vardecl[] {
+    return Query.searchFrom(startingPoint, Vardecl, (varDeclJp) => isExternalLinkageIdentifier(varDeclJp)).get();
+}
+
+function searchInternalLinkageIdentifiers(startingPoint: Joinpoint): (FunctionJp | Vardecl)[] {
+    return [
+        ...Query.searchFrom(startingPoint, FunctionJp, (decl) => isInternalLinkageIdentifier(decl)).get(), 
+        ...Query.searchFrom(startingPoint, Vardecl, (decl) => isInternalLinkageIdentifier(decl)).get()
+    ];
+}
+
+function searchExternalVarRefs(startingPoint: Joinpoint): Vardecl[] {
+    return Query.searchFrom(startingPoint, Vardecl, {storageClass: StorageClass.EXTERN}).get();
+}
+
+function searchIdentifierDecls(startingPoint: Joinpoint): any[] {
+    return [
+        ...Query.searchFrom(startingPoint, NamedDecl).get(),
+        ...Query.searchFrom(startingPoint, LabelStmt).get(),
+    ].filter((jp) => isIdentifierDecl(jp));
 }
\ No newline at end of file
@@ -0,0 +1,284 @@
+import { BinaryOp, Call, Expression, FunctionJp, Joinpoint, ParenExpr, StorageClass, UnaryOp, Vardecl, Varref } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { getVolatileVarRefs } from "./VarUtils.js";
+
+/**
+ * Kinds of side effects of a function or expression, combined as bit flags
+ */
+export enum SideEffectKind {
+    NONE = 0,
+    READS_GLOBALS = 1 << 0,
+    WRITES_LOCALS = 1 << 1,
+    WRITES_GLOBALS = 1 << 2,
+    VOLATILE_ACCESS = 1 << 3,
+    CALLS_UNKNOWN = 1 << 4
+}
+
+/**
+ * Side effects of a function (including the functions it calls) or of an expression
+ */
+export class SideEffectSummary {
+    /**
+     * Combination of {@link SideEffectKind} flags
+     */
+    readonly effects: number;
+
+    /**
+     * @param effects Combination of {@link SideEffectKind} flags
+     */
+    constructor(effects: number) {
+        this.effects = effects;
+    }
+
+    /**
+     * Checks if the summary includes the given kind of side effect
+     *
+     * @param kind The kind of side effect
+     */
+    has(kind: SideEffectKind): boolean {
+        return (this.effects & kind) !== 0;
+    }
+
+    /**
+     * True if the evaluation neither reads nor changes the state of the program
+     */
+    get isPure(): boolean {
+        return this.effects === SideEffectKind.NONE;
+    }
+
+    /**
+     * True if the evaluation may change the state of the program, i.e., modifies objects, accesses volatile objects or calls unknown functions
+     */
+    get hasPersistentSideEffects(): boolean {
+        return this.has(SideEffectKind.WRITES_LOCALS | SideEffectKind.WRITES_GLOBALS | SideEffectKind.VOLATILE_ACCESS | SideEffectKind.CALLS_UNKNOWN);
+    }
+}
+
+/**
+ * Effects found in the code of a function or expression, without following the calls
+ */
+interface LocalEffects {
+    effects: number;
+    callees: FunctionJp[];
+}
+
+/**
+ * Summary of a function, shared by the members of its strongly connected component of the call graph
+ */
+interface SummaryEntry {
+    summary: SideEffectSummary;
+    /**
+     * Epochs of the members of the component when the summary was computed
+     */
+    memberEpochs: Map<string, string>;
+    /**
+     * Identifiers of the functions called by the component, outside of it
+     */
+    callees: string[];
+    /**
+     * Change count when the entry was last validated
+     */
+    checkedAt: number;
+}
+
+/**
+ * Interprocedural side effect analysis, shared by the rules that query side effects.
+ *
+ * Summaries are computed bottom-up over the call graph: functions are visited in a depth-first search from the queried function
+ * and each strongly connected component (a group of mutually recursive functions) receives the union of the effects of its members
+ * and of the components it calls. Summaries are kept until a member or a summarized callee changes, so that queries are lookups.
+ */
+export class SideEffectAnalysis {
+    #entries = new Map<string, SummaryEntry>();
+    #getEpoch: (functionId: string) => string;
+    #getChangeCount: () => number;
+
+    /**
+     * @param getEpoch Returns the current version of a function, which changes whenever the function changes
+     * @param getChangeCount Returns the number of changes made to the program, used to validate each summary at most once per change
+     */
+    constructor(getEpoch: (functionId: string) => string, getChangeCount: () => number) {
+        this.#getEpoch = getEpoch;
+        this.#getChangeCount = getChangeCount;
+    }
+
+    /**
+     * Discards all summaries
+     */
+    clear() {
+        this.#entries.clear();
+    }
+
+    /**
+     * Returns the side effects of calling the given function, including the effects of the functions it calls.
+     * Modifications of its own local objects are not side effects of the call.
+     *
+     * @param functionJp The function, or one of its declarations
+     */
+    getFunctionSummary(functionJp: FunctionJp): SideEffectSummary {
+        const definitionJp = functionJp.isImplementation ? functionJp : functionJp.definitionJp;
+        if (definitionJp === undefined) {
+            return new SideEffectSummary(SideEffectKind.CALLS_UNKNOWN);
+        }
+        return this.getValidEntry(definitionJp.astId) ?? this.summarize(definitionJp);
+    }
+
+    /**
+     * Returns the side effects of evaluating the given expression, including the effects of the functions it calls
+     *
+     * @param exprJp The expression
+     */
+    getExpressionSummary(exprJp: Joinpoint): SideEffectSummary {
+        const local = collectLocalEffects(exprJp);
+        return new SideEffectSummary(local.callees.reduce(
+            (effects, calleeJp) => effects | this.getFunctionSummary(calleeJp).effects,
+            local.effects
+        ));
+    }
+
+    private getValidEntry(functionId: string): SideEffectSummary | undefined {
+        const entry = this.#entries.get(functionId);
+        if (entry === undefined) {
+            return undefined;
+        }
+
+        const changeCount = this.#getChangeCount();
+        if (entry.checkedAt !== changeCount) {
+            const isValid = [...entry.memberEpochs].every(([memberId, epoch]) => this.#getEpoch(memberId) === epoch) &&
+                entry.callees.every(calleeId => this.getValidEntry(calleeId) !== undefined);
+            if (!isValid) {
+                entry.memberEpochs.forEach((_, memberId) => this.#entries.delete(memberId));
+                return undefined;
+            }
+            entry.checkedAt = changeCount;
+        }
+        return entry.summary;
+    }
+
+    /**
+     * Computes the summaries of the given function and of the functions it calls that have no valid summary, using Tarjan's algorithm
+     */
+    private summarize(rootJp: FunctionJp): SideEffectSummary {
+        const indices = new Map<string, number>();
+        const lowLinks = new Map<string, number>();
+        const localEffects = new Map<string, LocalEffects>();
+        const stack: FunctionJp[] = [];
+        const onStack = new Set<string>();
+
+        const visit = (functionJp: FunctionJp) => {
+            const id = functionJp.astId;
+            indices.set(id, indices.size);
+            lowLinks.set(id, indices.get(id)!);
+            stack.push(functionJp);
+            onStack.add(id);
+
+            const local = collectLocalEffects(functionJp.body);
+            localEffects.set(id, local);
+            for (const calleeJp of local.callees) {
+                const calleeId = calleeJp.astId;
+                if (this.getValidEntry(calleeId) !== undefined) {
+                    continue;
+                }
+                if (!indices.has(calleeId)) {
+                    visit(calleeJp);
+                    lowLinks.set(id, Math.min(lowLinks.get(id)!, lowLinks.get(calleeId)!));
+                } else if (onStack.has(calleeId)) {
+                    lowLinks.set(id, Math.min(lowLinks.get(id)!, indices.get(calleeId)!));
+                }
+            }
+
+            if (lowLinks.get(id) === indices.get(id)) {
+                const members: FunctionJp[] = [];
+                let memberJp: FunctionJp;
+                do {
+                    memberJp = stack.pop()!;
+                    onStack.delete(memberJp.astId);
+                    members.push(memberJp);
+                } while (memberJp.astId !== id);
+                this.addComponent(members, localEffects);
+            }
+        };
+
+        visit(rootJp);
+        return this.#entries.get(rootJp.astId)!.summary;
+    }
+
+    private addComponent(members: FunctionJp[], localEffects: Map<string, LocalEffects>) {
+        const memberIds = new Set(members.map(memberJp => memberJp.astId));
+        const callees = new Set<string>();
+        let effects = SideEffectKind.NONE as number;
+
+        for (const memberJp of members) {
+            const local = localEffects.get(memberJp.astId)!;
+            effects |= local.effects & ~SideEffectKind.WRITES_LOCALS;
+            local.callees.filter(calleeJp => !memberIds.has(calleeJp.astId)).forEach(calleeJp => callees.add(calleeJp.astId));
+        }
+        callees.forEach(calleeId => effects |= this.#entries.get(calleeId)!.summary.effects);
+
+        const entry: SummaryEntry = {
+            summary: new SideEffectSummary(effects),
+            memberEpochs: new Map(members.map(memberJp => [memberJp.astId, this.#getEpoch(memberJp.astId)])),
+            callees: [...callees],
+            checkedAt: this.#getChangeCount()
+        };
+        memberIds.forEach(memberId => this.#entries.set(memberId, entry));
+    }
+}
+
+/**
+ * Collects the effects found in the code of the given joinpoint and the definitions of the functions it calls.
+ * Calls of functions without a definition, including calls through pointers, are unknown effects.
+ */
+function collectLocalEffects($jp: Joinpoint): LocalEffects {
+    let effects = SideEffectKind.NONE as number;
+    const callees: FunctionJp[] = [];
+
+    for (const refJp of Query.searchFromInclusive($jp, Varref).get()) {
+        if (refJp.decl instanceof Vardecl && hasStaticStorage(refJp.decl)) {
+            effects |= SideEffectKind.READS_GLOBALS;
+        }
+    }
+    if (getVolatileVarRefs($jp).length > 0) {
+        effects |= SideEffectKind.VOLATILE_ACCESS;
+    }
+
+    const modifiedExprs = [
+        ...Query.searchFromInclusive($jp, UnaryOp, {kind: /(post_inc)|(post_dec)|(pre_inc)|(pre_dec)/}).get().map(opJp => opJp.operand),
+        ...Query.searchFromInclusive($jp, BinaryOp, {isAssignment: true}).get().map(opJp => opJp.left)
+    ];
+    modifiedExprs.forEach(exprJp => effects |= getWriteKind(exprJp));
+
+    for (const callJp of Query.searchFromInclusive($jp, Call).get()) {
+        const definitionJp = callJp.function?.isImplementation ? callJp.function : callJp.function?.definitionJp;
+        if (definitionJp === undefined) {
+            effects |= SideEffectKind.CALLS_UNKNOWN;
+        } else if (!callees.some(calleeJp => calleeJp.astId === definitionJp.astId)) {
+            callees.push(definitionJp);
+        }
+    }
+    return { effects, callees };
+}
+
+/**
+ * Classifies a modification: objects with static storage and objects accessed through pointers are global,
+ * while local variables (including local arrays and structures) are local
+ */
+function getWriteKind(lvalueJp: Expression): SideEffectKind {
+    while (lvalueJp instanceof ParenExpr) {
+        lvalueJp = lvalueJp.subExpr;
+    }
+
+    const baseRef = Query.searchFromInclusive(lvalueJp, Varref).first();
+    const isDereference = Query.searchFromInclusive(lvalueJp, UnaryOp, {kind: "deref"}).get().length > 0;
+    if (baseRef === undefined || isDereference || !(baseRef.decl instanceof Vardecl) || hasStaticStorage(baseRef.decl)) {
+        return SideEffectKind.WRITES_GLOBALS;
+    }
+    if (baseRef.astId !== lvalueJp.astId && baseRef.type.isPointer) {
+        return SideEffectKind.WRITES_GLOBALS;
+    }
+    return SideEffectKind.WRITES_LOCALS;
+}
+
+function hasStaticStorage(vardeclJp: Vardecl): boolean {
+    return vardeclJp.isGlobal || vardeclJp.storageClass === StorageClass.STATIC;
+}
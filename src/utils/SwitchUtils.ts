@@ -1,6 +1,7 @@
-import { BinaryOp, Break, BuiltinType, Case, Joinpoint, Switch, UnaryOp } from "@specs-feup/clava/api/Joinpoints.js";
+import { BinaryOp, Break, BuiltinType, Call, Case, Expression, Joinpoint, Switch, UnaryOp } from "@specs-feup/clava/api/Joinpoints.js";
 import Query from "@specs-feup/lara/api/weaver/Query.js";
 import { hasDefinedType } from "./JoinpointUtils.js";
+import { getVolatileVarRefs } from "./VarUtils.js";
 
 /**
  * Retrieves the last statement of the given case
@@ -49,4 +50,156 @@ export function countSwitchClauses($jp: Switch): number  {
  */
 export function hasConditionalBreak(switchStmt: Switch): boolean {
     return Query.searchFrom(switchStmt, Break, { currentRegion: region => region.astId !== switchStmt.astId, enclosingStmt: jp => jp.astId === switchStmt.astId }).get().length > 0;
-}
\ No newline at end of file
+}
+
+/**
+ * Checks if the controlling expression of the provided switch statement is essentially boolean
+ * 
+ * @param switchStmt - The switch statement to analyze
+ * @returns Returns true if the condition is a logical operation or has boolean type, otherwise false
+ */
+export function hasBooleanCondition(switchStmt: Switch): boolean {
+    const switchCondition = switchStmt.condition;
+
+    if (switchCondition instanceof BinaryOp || switchCondition instanceof UnaryOp) {
+        const logicalOps = new Set(["lt", "gt", "le", "ge", "eq", "ne", "not", "l_not", "and", "or"]);
+        return logicalOps.has(switchCondition.kind);
+    }
+    
+    return hasDefinedType(switchCondition) && 
+        switchCondition.type instanceof BuiltinType && 
+        switchCondition.type.builtinKind === "Bool";
+}
+
+/**
+ * Checks if the provided switch condition must be evaluated only once when the switch is converted into if statements,
+ * i.e., if it calls functions, accesses volatile objects or modifies objects
+ * 
+ * @param condition - The controlling expression of a switch statement
+ * @returns Returns true if repeating the evaluation of the condition could change the behavior of the program, otherwise false
+ */
+export function needsSingleEvaluation(condition: Expression): boolean {
+    return Query.searchFromInclusive(condition, Call).get().length > 0 ||
+        getVolatileVarRefs(condition).length > 0 ||
+        Query.searchFromInclusive(condition, UnaryOp, {kind: /(post_inc)|(post_dec)|(pre_inc)|(pre_dec)/}).get().length > 0 ||
+        Query.searchFromInclusive(condition, BinaryOp, {isAssignment: true}).get().length > 0;
+}
+
+/**
+ * A switch clause: a group of consecutive labels followed by the statements they execute
+ */
+export interface SwitchClause {
+    /**
+     * Consecutive labels of the clause
+     */
+    labels: Case[];
+    /**
+     * Statements of the clause, until the next label
+     */
+    statements: Joinpoint[];
+    /**
+     * The unconditional break of the clause or, if there is none, its last statement
+     */
+    lastStmt: Joinpoint | undefined;
+    /**
+     * Whether the execution continues into the next clause, i.e., the clause does not end with an unconditional break
+     */
+    fallsThrough: boolean;
+}
+
+/**
+ * Structure of a switch statement, computed once and shared by the rules that analyze switch statements
+ */
+export class SwitchSummary {
+    /**
+     * The summarized switch statement
+     */
+    readonly switchJp: Switch;
+    /**
+     * Labels of the switch, in order
+     */
+    readonly cases: Case[];
+    /**
+     * Clauses of the switch, in order
+     */
+    readonly clauses: SwitchClause[];
+    /**
+     * Number of clauses with instructions
+     */
+    readonly clauseCount: number;
+    /**
+     * Index of the default label in {@link cases}, or -1 if there is none
+     */
+    readonly defaultIndex: number;
+    /**
+     * Labels whose enclosing compound statement is not the switch body
+     */
+    readonly misplacedCases: Case[];
+    /**
+     * Whether the controlling expression is essentially boolean
+     */
+    readonly hasBooleanCondition: boolean;
+
+    #hasConditionalBreak: boolean | undefined = undefined;
+
+    /**
+     * @param switchJp - The switch statement to summarize
+     */
+    constructor(switchJp: Switch) {
+        this.switchJp = switchJp;
+        this.cases = switchJp.cases;
+        this.defaultIndex = this.cases.findIndex(caseLabel => caseLabel.isDefault);
+        this.misplacedCases = Query.searchFrom(switchJp, Case).get()
+            .filter(caseLabel => !(caseLabel.currentRegion instanceof Switch));
+        this.hasBooleanCondition = hasBooleanCondition(switchJp);
+
+        this.clauses = [];
+        let labels: Case[] = [];
+        for (const caseLabel of this.cases) {
+            labels.push(caseLabel);
+            if (caseLabel.instructions.length === 0) { // Has a consecutive case
+                continue;
+            }
+            const lastStmt = getLastStmtOfCase(caseLabel);
+            this.clauses.push({ labels, statements: caseLabel.instructions, lastStmt, fallsThrough: !(lastStmt instanceof Break) });
+            labels = [];
+        }
+        if (labels.length > 0) {
+            this.clauses.push({ labels, statements: [], lastStmt: undefined, fallsThrough: false });
+        }
+        this.clauseCount = this.clauses.filter(clause => clause.statements.length > 0).length;
+    }
+
+    /**
+     * Whether the switch has a default label
+     */
+    get hasDefault(): boolean {
+        return this.defaultIndex !== -1;
+    }
+
+    /**
+     * Whether the default label is the first or last label, or there is no default label
+     */
+    get isDefaultFirstOrLast(): boolean {
+        return this.defaultIndex === -1 || this.defaultIndex === 0 || this.defaultIndex === this.cases.length - 1;
+    }
+
+    /**
+     * Last statements of the clauses that are not followed by an unconditional break
+     */
+    get statementsNeedingBreak(): Joinpoint[] {
+        return this.clauses
+            .filter(clause => clause.fallsThrough && clause.lastStmt !== undefined)
+            .map(clause => clause.lastStmt!);
+    }
+
+    /**
+     * Whether the switch contains a conditional break. Computed on first access.
+     */
+    get hasConditionalBreak(): boolean {
+        if (this.#hasConditionalBreak === undefined) {
+            this.#hasConditionalBreak = hasConditionalBreak(this.switchJp);
+        }
+        return this.#hasConditionalBreak;
+    }
+}
@@ -1,8 +1,8 @@
-import { Joinpoint, TypedefDecl, DeclStmt, TypedefType, ElaboratedType, TagType, FileJp, EnumDecl, EnumeratorDecl, Varref } from "@specs-feup/clava/api/Joinpoints.js";
+import { Joinpoint, TypedefDecl, DeclStmt, TypedefType, ElaboratedType, TagType, FileJp, EnumDecl, EnumeratorDecl, Varref, Type, QualType, PointerType, ArrayType, UnaryExprOrType } from "@specs-feup/clava/api/Joinpoints.js";
 import Query from "@specs-feup/lara/api/weaver/Query.js";
-import { getBaseType } from "./JoinpointUtils.js";
+import { hasDefinedType } from "./JoinpointUtils.js";
 import { isTagDecl, TagDecl } from "./JoinpointUtils.js";
-import { findFilesReferencingHeader, getIncludesOfFile } from "./FileUtils.js";
+import { getUsageScopeReferences } from "./HeaderUsageCache.js";
 
 /**
  * Retrieves the typedef declaration for the provided joinpoint, if available
@@ -30,59 +30,62 @@ export function hasTypeDefDecl($jp: Joinpoint): boolean {
 }
 
 /**
- * Checks if a given joinpoint uses the specified typedef declaration.
- * @param jp - The joinpoint to check
- * @param typeDecl - The typedef declaration to check against
- * @returns Returns true if the joinpoint uses the given typedef declaration, false otherwise
+ * Checks if the provided typedef or tag declaration is used in any part of the program.
+ * The references of each file are collected once and shared by all declarations of the file or of the headers it includes.
+ * @param decl - typedef or tag declaration to verify
+ * @returns Returns true if the declaration is used, false otherwise
  */
-export function jpUsesTypedef(jp: Joinpoint, typeDecl: TypedefDecl): boolean {
-    const jpType = getBaseType(jp);
+export function isTypeDeclUsed(decl: TypedefDecl | TagDecl): boolean {
+    const references = getUsageScopeReferences(decl.getAncestor("file") as FileJp);
 
-    return !jpType?.isBuiltin && (
-        (jpType instanceof TypedefType &&jpType.decl.astId === typeDecl.astId) ||
-        (jpType instanceof ElaboratedType && jpType.namedType instanceof TypedefType &&jpType.namedType.decl.astId === typeDecl.astId)
-    );
+    if (decl instanceof TypedefDecl) {
+        return references.typedefs.has(decl.astId);
+    }
+    if (decl instanceof EnumDecl && getTypeDefDecl(decl) === undefined && decl.enumerators.some(enumerator => references.enumerators.has(enumerator.astId))) {
+        return true;
+    }
+    return references.tags.has(decl.astId);
 }
 
 /**
- * Checks if a given joinpoint uses the specified tag declaration
+ * Returns the typedef and tag declarations referenced by the given joinpoint, through its type,
+ * the type operand of sizeof or the enumerator it refers to
  * @param $jp The joinpoint to analyze
- * @param tag The tag to check against
- * @returns Returns true if the joinpoint uses the given tag, false otherwise
+ * @returns The referenced declarations
  */
-export function jpUsesTag($jp: Joinpoint, tag: TagDecl): boolean {
-    if (tag instanceof EnumDecl && $jp instanceof Varref && getTypeDefDecl(tag) === undefined) {
-        const enumeratorsIDs = tag.enumerators.map(enumerator => enumerator.astId);
+export function getReferencedTypeDecls($jp: Joinpoint): (TypedefDecl | TagDecl)[] {
+    const decls: (TypedefDecl | TagDecl | undefined)[] = [
+        hasDefinedType($jp) ? getNamedTypeDecl($jp.type) : undefined,
+        $jp instanceof UnaryExprOrType ? getNamedTypeDecl($jp.argType) : undefined
+    ];
+    if ($jp instanceof Varref) {
         const decl = $jp.getValue("decl");
-        if (decl instanceof EnumeratorDecl && enumeratorsIDs.includes(decl.astId)) {
-            return true;
+        if (decl instanceof EnumeratorDecl && decl.parent instanceof EnumDecl) {
+            decls.push(decl.parent);
         }
     }
-
-    const jpType = getBaseType($jp);
-    return jpType instanceof ElaboratedType && 
-        jpType.namedType instanceof TagType && 
-        jpType.namedType.decl.astId === tag.astId &&
-        $jp.astId !== getTypeDefDecl(tag)?.astId
+    return decls.filter((decl): decl is TypedefDecl | TagDecl => decl !== undefined);
 }
 
 /**
- * Checks if the provided typedef or tag declaration is used in any part of the program
- * @param decl - typedef or tag declaration to verify
- * @returns Returns true if the declaration is used, false otherwise
+ * Returns the typedef or tag declaration that names the given type, after removing qualifiers, pointers and arrays
  */
-export function isTypeDeclUsed(decl: TypedefDecl | TagDecl): boolean {
-    const fileJp = decl.getAncestor("file") as FileJp;
-    let jps: Joinpoint[] = [];
+function getNamedTypeDecl(typeJp: Type | undefined): TypedefDecl | TagDecl | undefined {
+    let namedType = typeJp;
+    while (namedType instanceof QualType || namedType instanceof PointerType || namedType instanceof ArrayType || namedType instanceof ElaboratedType) {
+        if (namedType instanceof QualType) {
+            namedType = namedType.unqualifiedType;
+        } else if (namedType instanceof PointerType) {
+            namedType = namedType.pointee;
+        } else if (namedType instanceof ArrayType) {
+            namedType = namedType.elementType;
+        } else {
+            namedType = namedType.namedType;
+        }
+    }
 
-    if (fileJp.isHeader) {
-        const referencingFiles = findFilesReferencingHeader(fileJp.name);
-        jps = [...fileJp.descendants, ...referencingFiles.flatMap(file => file.descendants)];
-    } else {
-        jps = fileJp.descendants;
+    if (namedType instanceof TypedefType && namedType.decl instanceof TypedefDecl) {
+        return namedType.decl;
     }
-    
-    return decl instanceof TypedefDecl ? 
-        jps.some(jp => jpUsesTypedef(jp, decl)) :
-        jps.some(jp => jpUsesTag(jp, decl));
-}
\ No newline at end of file
+    return namedType instanceof TagType && isTagDecl(namedType.decl) ? namedType.decl : undefined;
+}
@@ -0,0 +1,127 @@
+import { ArrayType, BuiltinType, EnumType, PointerType, QualType, Type } from "@specs-feup/clava/api/Joinpoints.js";
+
+/**
+ * Coarse classification of C types, used to detect obviously incompatible fixes without compiling
+ */
+export enum TypeCategory {
+    VOID = "void",
+    INTEGER = "integer",
+    FLOAT = "float",
+    POINTER = "pointer",
+    OTHER = "other"
+}
+
+/**
+ * Removes typedefs and qualifiers from the given type
+ *
+ * @param type The type to simplify
+ * @returns The canonical unqualified type
+ */
+export function getCanonicalType(type: Type): Type {
+    let canonicalType = type.desugarAll;
+    while (canonicalType instanceof QualType) {
+        canonicalType = canonicalType.unqualifiedType.desugarAll;
+    }
+    return canonicalType;
+}
+
+/**
+ * Classifies the given type. Enumerations and characters are considered integers and arrays are considered pointers.
+ *
+ * @param type The type to classify
+ * @returns The category of the type, or `OTHER` for records and types that cannot be classified
+ */
+export function getTypeCategory(type: Type): TypeCategory {
+    const canonicalType = getCanonicalType(type);
+
+    if (canonicalType instanceof PointerType || canonicalType instanceof ArrayType) {
+        return TypeCategory.POINTER;
+    } else if (canonicalType instanceof EnumType) {
+        return TypeCategory.INTEGER;
+    } else if (canonicalType instanceof BuiltinType) {
+        if (canonicalType.isVoid) return TypeCategory.VOID;
+        if (canonicalType.isInteger) return TypeCategory.INTEGER;
+        if (canonicalType.isFloat) return TypeCategory.FLOAT;
+    }
+    return TypeCategory.OTHER;
+}
+
+/**
+ * Counts the levels of indirection of the given type (e.g., `int **` has two levels)
+ *
+ * @param type The type to analyze
+ * @returns The number of pointer or array levels
+ */
+export function getPointerLevel(type: Type): number {
+    let level = 0;
+    let currentType = getCanonicalType(type);
+
+    while (currentType instanceof PointerType || currentType instanceof ArrayType) {
+        level++;
+        currentType = getCanonicalType(currentType instanceof PointerType ? currentType.pointee : currentType.elementType);
+    }
+    return level;
+}
+
+/**
+ * Checks if the given type is a generic pointer (`void *`)
+ *
+ * @param type The type to check
+ */
+export function isVoidPointer(type: Type): boolean {
+    const canonicalType = getCanonicalType(type);
+    return canonicalType instanceof PointerType && getTypeCategory(canonicalType.pointee) === TypeCategory.VOID;
+}
+
+/**
+ * Checks if a value of one type can be implicitly converted to another type.
+ * Only obvious incompatibilities are reported, so types that cannot be classified are considered compatible.
+ *
+ * @param fromType The type of the value
+ * @param toType The target type
+ * @returns Returns false if the conversion is certainly invalid, otherwise returns true
+ */
+export function isCompatibleType(fromType: Type, toType: Type): boolean {
+    const fromCategory = getTypeCategory(fromType);
+    const toCategory = getTypeCategory(toType);
+
+    if (fromCategory === TypeCategory.OTHER || toCategory === TypeCategory.OTHER) {
+        return true;
+    }
+    if (fromCategory === TypeCategory.POINTER && toCategory === TypeCategory.POINTER) {
+        return isVoidPointer(fromType) || isVoidPointer(toType) || getPointerLevel(fromType) === getPointerLevel(toType);
+    }
+    if (fromCategory === TypeCategory.POINTER || toCategory === TypeCategory.POINTER) {
+        return false;
+    }
+    return (fromCategory === TypeCategory.VOID) === (toCategory === TypeCategory.VOID);
+}
+
+/**
+ * Checks if a literal value, as written in the configuration file, can be converted to the given type.
+ * Values that are not literals (e.g., enumerators or macros) are considered compatible.
+ *
+ * @param value The literal value
+ * @param type The target type
+ * @returns Returns false if the value is certainly invalid for the type, otherwise returns true
+ */
+export function isCompatibleLiteral(value: string, type: Type): boolean {
+    const trimmedValue = value.trim();
+    const isString = /^L?"/.test(trimmedValue);
+    const isNumber = /^[+-]?(\d|\.\d)/.test(trimmedValue) || /^L?'/.test(trimmedValue);
+
+    switch (getTypeCategory(type)) {
+        case TypeCategory.VOID:
+            return false;
+        case TypeCategory.INTEGER:
+        case TypeCategory.FLOAT:
+            return !isString;
+        case TypeCategory.POINTER:
+            if (isString) {
+                return getPointerLevel(type) === 1;
+            }
+            return !isNumber || /^0+[uUlL]*$/.test(trimmedValue);
+        default:
+            return !isString && !isNumber;
+    }
+}
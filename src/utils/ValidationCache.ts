@@ -0,0 +1,183 @@
+import Clava from "@specs-feup/clava/api/clava/Clava.js";
+import { FileJp, Program } from "@specs-feup/clava/api/Joinpoints.js";
+import Query from "@specs-feup/lara/api/weaver/Query.js";
+import { createHash } from "crypto";
+import * as fs from 'fs';
+
+/**
+ * Result of validating a given file content
+ */
+interface ValidationEntry {
+    /**
+     * Whether the file compiles
+     */
+    compiles?: boolean;
+    /**
+     * Whether each checked call is explicit, indexed by `name#index#checkNumParams`
+     */
+    explicitCalls: Record<string, boolean>;
+}
+
+/**
+ * Validation results indexed by the hash of the validated file and its compilation context.
+ * Entries are keyed by content, so they remain valid across rebuilds and iterations.
+ */
+let validationResults = new Map<string, ValidationEntry>();
+
+/**
+ * Hash of the path and code of each header, indexed by the identifier of the header.
+ * Computed once per version of the header, since generating the code of every header for each validation is expensive.
+ */
+let headerHashes = new Map<string, string>();
+
+/**
+ * Hash of the compilation context shared by all files of the program, or undefined if it must be computed again
+ */
+let contextHash: string | undefined = undefined;
+
+/**
+ * Standard, flags and include paths from which the context hash was computed
+ */
+let contextSettings: string | undefined = undefined;
+
+/**
+ * Computes the key of a file validation, based on the code of the file, its folder and the compilation context:
+ * the C standard, the compiler flags, the include paths and the code of the headers the file may include
+ *
+ * @param fileJp The file to validate
+ * @param code The code to validate, if different from the current code of the file
+ * @returns The hash identifying the validation
+ */
+export function getValidationKey(fileJp: FileJp, code: string = fileJp.code): string {
+    const hash = createHash("sha1");
+    hash.update(getContextHash(fileJp.parent as Program));
+    hash.update("\0" + fileJp.relativeFolderpath);
+    hash.update("\0" + code);
+    return hash.digest("hex");
+}
+
+/**
+ * Discards the hashes that depend on a modified file, so that they are computed again for its new version
+ *
+ * @param fileJp The modified file, or undefined if any file may have changed
+ */
+export function invalidateValidationContext(fileJp?: FileJp) {
+    if (fileJp === undefined) {
+        headerHashes = new Map<string, string>();
+        contextHash = undefined;
+    } else if (fileJp.isHeader) {
+        headerHashes.delete(fileJp.astId);
+        contextHash = undefined;
+    }
+}
+
+function getContextHash(programJp: Program): string {
+    // The settings are compared on each call, since they may change without modifying any file
+    const data = Clava.getData();
+    const settings = [programJp.standard, data.getFlags(), ...data.getUserIncludes(), "", ...data.getSystemIncludes()].join("\0");
+    if (contextHash !== undefined && settings === contextSettings) {
+        return contextHash;
+    }
+
+    const hash = createHash("sha1");
+    hash.update(settings);
+
+    const headers = Query.searchFrom(programJp, FileJp, {isHeader: true}).get()
+        .sort((a, b) => a.filepath.localeCompare(b.filepath));
+    for (const headerJp of headers) {
+        let headerHash = headerHashes.get(headerJp.astId);
+        if (headerHash === undefined) {
+            headerHash = createHash("sha1").update(headerJp.filepath + "\0" + headerJp.code).digest("hex");
+            headerHashes.set(headerJp.astId, headerHash);
+        }
+        hash.update("\0" + headerHash);
+    }
+
+    contextHash = hash.digest("hex");
+    contextSettings = settings;
+    return contextHash;
+}
+
+/**
+ * @param key The validation key
+ * @returns Whether the file compiles, or undefined if it was never validated
+ */
+export function getCachedVerdict(key: string): boolean | undefined {
+    return validationResults.get(key)?.compiles;
+}
+
+/**
+ * Stores whether the file with the given validation key compiles
+ *
+ * @param key The validation key
+ * @param compiles Whether the file compiles
+ */
+export function setCachedVerdict(key: string, compiles: boolean) {
+    getEntry(key).compiles = compiles;
+}
+
+/**
+ * @param key The validation key
+ * @param funcName The function name of the call
+ * @param callIndex The index of the call among the calls with the same name
+ * @param checkNumParams Whether the number of arguments was checked
+ * @returns Whether the call is explicit, or undefined if it was never checked
+ */
+export function getCachedExplicitCall(key: string, funcName: string, callIndex: number, checkNumParams: boolean): boolean | undefined {
+    return validationResults.get(key)?.explicitCalls[`${funcName}#${callIndex}#${checkNumParams}`];
+}
+
+/**
+ * Stores whether a call of the file with the given validation key is explicit
+ *
+ * @param key The validation key
+ * @param funcName The function name of the call
+ * @param callIndex The index of the call among the calls with the same name
+ * @param checkNumParams Whether the number of arguments was checked
+ * @param isExplicit Whether the call is explicit
+ */
+export function setCachedExplicitCall(key: string, funcName: string, callIndex: number, checkNumParams: boolean, isExplicit: boolean) {
+    getEntry(key).explicitCalls[`${funcName}#${callIndex}#${checkNumParams}`] = isExplicit;
+}
+
+/**
+ * Loads validation results stored by a previous run. Missing or malformed files are ignored.
+ *
+ * @param filePath Path of the cache file
+ */
+export function loadValidationCache(filePath: string) {
+    if (!fs.existsSync(filePath)) {
+        return;
+    }
+    try {
+        const data = JSON.parse(fs.readFileSync(filePath, 'utf-8')) as Record<string, ValidationEntry>;
+        validationResults = new Map(Object.entries(data));
+    } catch (error) {
+        console.warn(`[Clava-MISRATool] Ignoring invalid validation cache '${filePath}'.`);
+    }
+}
+
+/**
+ * Stores the validation results in a file, so that later runs can reuse them
+ *
+ * @param filePath Path of the cache file
+ */
+export function saveValidationCache(filePath: string) {
+    fs.writeFileSync(filePath, JSON.stringify(Object.fromEntries(validationResults)), 'utf-8');
+}
+
+/**
+ * Clears all validation results, so that results of a previous analysis in the same process are not reused
+ */
+export function resetValidationCache() {
+    validationResults = new Map<string, ValidationEntry>();
+}
+
+function getEntry(key: string): ValidationEntry {
+    let entry = validationResults.get(key);
+    if (entry === undefined) {
+        entry = { explicitCalls: {} };
+        validationResults.set(key, entry);
+    }
+    return entry;
+}
@@ -2,7 +2,7 @@ import { FileJp, FunctionJp, Joinpoint, QualType, StorageClass, Vardecl, Varref
 import Query from "@specs-feup/lara/api/weaver/Query.js";
 import { getIdentifierName, isExternalLinkageIdentifier } from "./IdentifierUtils.js";
 import { getExternalLinkageIdentifiers, getExternalLinkageVars, getExternalVarRefs } from "./ProgramUtils.js";
-import { findFilesReferencingHeader } from "./FileUtils.js";
+import { getUsageScopeReferences } from "./HeaderUsageCache.js";
 
 /**
  * Retrieves all variable references qualified as "volatile" starting from the given joinpoint
@@ -89,14 +89,5 @@ export function hasMultipleExternalLinkDeclarations($jp: Vardecl): boolean {
  * @returns True if the variable is referenced, false otherwise
  */
 export function isVarUsed(varDecl: Vardecl): boolean {
-    const fileJp = varDecl.getAncestor("file") as FileJp;
-    let referencingFiles: FileJp[];
-
-    if (fileJp.isHeader) {
-        const filesWithInclude = findFilesReferencingHeader(fileJp.name);
-        referencingFiles = [fileJp, ...filesWithInclude];
-    } else {
-        referencingFiles = [fileJp];
-    }
-    return referencingFiles.some(fileJp => Query.searchFrom(fileJp, Varref, {name: varDecl.name, decl: (declJp) => declJp?.astId === varDecl.astId}).get().length > 0)
-}
\ No newline at end of file
+    return getUsageScopeReferences(varDecl.getAncestor("file") as FileJp).vars.has(varDecl.astId);
+}